@@ -31,6 +31,8 @@
 #include "shared_memory.h"
 #include "monitoring_library.h"
 #include "pecontroller_timers.h"
+#include "pecontroller_profiler.h"
+#include "pecontroller_deadline.h"
 /********************************************************************************
  * Defines
  *******************************************************************************/
@@ -50,6 +52,14 @@
  */
 #define PROFILE_CONVERSION				(1)
 #endif
+/**
+ * @brief Collects the execution time statistics of the conversion and the control loop using the profiler.
+ */
+#define PROFILE_CONTROL_LOOP			(PROFILER_ENABLE && IS_CONTROL_CORE)
+/**
+ * @brief Checks the execution time of the conversion and the control loop against the sampling period.
+ */
+#define MONITOR_CONTROL_DEADLINE		(DEADLINE_MONITOR_ENABLE && IS_CONTROL_CORE)
 /********************************************************************************
  * Typedefs
  *******************************************************************************/
@@ -64,6 +74,7 @@ typedef struct
 	uint32_t rdLow;
 	uint16_t data[32];
 } adc_dma_data_t;
+_Static_assert(sizeof(adc_dma_data_t) <= ADC_DMA_DATA_MAX_SIZE, "ADC DMA buffer exceeds the shared memory.");
 #endif
 /********************************************************************************
  * Static Variables
@@ -90,13 +101,24 @@ static TIM_HandleTypeDef htim4;
  * @brief Handle for the ADC conversion timer
  */
 static TIM_HandleTypeDef htimCnv;
+#if PROFILE_CONTROL_LOOP
+/** Probe measuring the data collection and conversion */
+static profiler_probe_t* convProbe = NULL;
+/** Probe measuring the control loop called after each conversion */
+static profiler_probe_t* controlProbe = NULL;
+#endif
+#if MONITOR_CONTROL_DEADLINE
+/** Deadline monitor of the conversion and the control loop
+ */
+static deadline_monitor_t controlMonitor = { .budgetRatio = 1 };
+#endif
 
 #if EN_DMA_ADC_DATA_COLLECTION
 static TIM_HandleTypeDef htimRead;			// TIM8
 static DMA_HandleTypeDef hdma_rd_low;
 static DMA_HandleTypeDef hdma_acq_data;
 static DMA_HandleTypeDef hdma_rd_high;
-static adc_dma_data_t* dmaData = (adc_dma_data_t*)0x3800F000;
+static adc_dma_data_t* dmaData = (adc_dma_data_t*)ADC_DMA_DATA_ADDR;
 static volatile bool isLastTimerCollect = false;
 #endif
 /********************************************************************************
@@ -153,19 +175,14 @@ static inline void CollectData_BothADCs(uint16_t* tempData)
 #pragma GCC push_options
 #pragma GCC optimize ("-Ofast")
 /**
- * @brief Acquire measurements and convert to meaningful data for both ADCs
+ * @brief Convert the acquired measurements of both ADCs to meaningful data
  * @param *fData Pointer to where the data needs to be stored
- * @param *uData Pointer to where the raw adc data
+ * @param *uData Pointer to the raw adc data
  * @param *mults Pointer to the multiplier information
  * @param *offsets Pointer to the offset information
  */
-TCritical static void CollectConvertData_BothADCs(float* fData, uint16_t* uData, const float* mults, const float* offsets)
+TCritical static void ConvertData_BothADCs(float* fData, const uint16_t* uData, const float* mults, const float* offsets)
 {
-	// Also collect data if not already collected via DMA
-#if !EN_DMA_ADC_DATA_COLLECTION
-	CollectData_BothADCs(uData);
-#endif
-
 	int i = 15;
 	do
 	{
@@ -568,6 +585,9 @@ timer_trigger_src_t BSP_MAX11046_SetInputOutputTrigger(tim_in_trigger_config_t*
 
 	// update the sampling frequency
 	processedData->info.fs = _fs;
+#if MONITOR_CONTROL_DEADLINE
+	BSP_Deadline_SetFrequency(&controlMonitor, _fs);
+#endif
 
 	return result;
 }
@@ -592,6 +612,12 @@ void BSP_MAX11046_Init(adc_acq_mode_t type, adc_cont_config_t* contConfig, volat
 	acqType = type;
 	adcContConfig.fs = contConfig->fs;
 	adcContConfig.callback = contConfig->callback;
+#if PROFILE_CONTROL_LOOP
+	if (convProbe == NULL)
+		convProbe = Profiler_Register("ADC Conversion");
+	if (controlProbe == NULL)
+		controlProbe = Profiler_Register("Control Loop");
+#endif
 
 	GPIOs_Init();
 #if EN_DMA_ADC_DATA_COLLECTION
@@ -679,6 +705,19 @@ void BSP_MAX11046_DeInit(void)
 	moduleActive = false;
 }
 
+#if MONITOR_CONTROL_DEADLINE
+/**
+ * @brief Gets the deadline monitor of the conversion and the control loop.
+ * @details The sampling period of the monitor is updated with the sampling frequency of the ADC.
+ * Set the safe state configuration of the monitor after initializing the ADC.
+ * @return Pointer to the deadline monitor.
+ */
+deadline_monitor_t* BSP_MAX11046_GetDeadlineMonitor(void)
+{
+	return &controlMonitor;
+}
+#endif
+
 #pragma GCC push_options
 #pragma GCC optimize ("-Ofast")
 
@@ -694,9 +733,33 @@ TCritical static inline void ManipulateData(void)
 #else
 	uint16_t* uData = (uint16_t*)&rawData->dataRecord[rawData->recordIndex << 4];
 #endif
-	CollectConvertData_BothADCs(fData, uData, adcSensitivity, adcOffsets);
+#if PROFILE_CONTROL_LOOP
+	Profiler_Start(convProbe);
+#endif
+#if MONITOR_CONTROL_DEADLINE
+	BSP_Deadline_Enter(&controlMonitor);
+#endif
+	// Also collect data if not already collected via DMA
+#if !EN_DMA_ADC_DATA_COLLECTION
+	CollectData_BothADCs(uData);
+#endif
+#if ADC_FAST_PROTECTION
+	// raw samples are checked before any floating point work
+	BSP_ADC_CheckProtection(uData);
+#endif
+	ConvertData_BothADCs(fData, uData, adcSensitivity, adcOffsets);
+#if PROFILE_CONTROL_LOOP
+	Profiler_Stop(convProbe);
+	Profiler_Start(controlProbe);
+#endif
 	if(adcContConfig.callback)
 		adcContConfig.callback((adc_measures_t*)fData);
+#if PROFILE_CONTROL_LOOP
+	Profiler_Stop(controlProbe);
+#endif
+#if MONITOR_CONTROL_DEADLINE
+	BSP_Deadline_Exit(&controlMonitor);
+#endif
 #if USE_LOCAL_ADC_STORAGE
 	RingBuffer_Write(&adcLocalIndexRingBuff);
 #else
@@ -36,6 +36,10 @@
 #include "max11046_drivers.h"
 #endif
 #include "monitoring_library.h"
+#if ADC_FAST_PROTECTION
+#include "pecontroller_pwm.h"
+#include "pecontroller_trace.h"
+#endif
 /********************************************************************************
  * Defines
  *******************************************************************************/
@@ -59,6 +63,19 @@
 /********************************************************************************
  * Structures
  *******************************************************************************/
+#if ADC_FAST_PROTECTION
+/**
+ * @brief Defines the state of the fast protection.
+ */
+typedef struct
+{
+	adc_protection_config_t config;					/**< @brief Active configuration */
+	volatile uint16_t activeMask;					/**< @brief Channels being checked. 0 if the protection is disabled */
+	volatile uint16_t tripMask;						/**< @brief Channels which tripped the protection */
+	volatile uint32_t rawLimits[TOTAL_MEASUREMENT_COUNT];	/**< @brief Raw limits of each channel. Lower limit in bits 0-15 and upper limit in bits 16-31 */
+	uint16_t counts[TOTAL_MEASUREMENT_COUNT];		/**< @brief Consecutive samples beyond the limits for each channel */
+} adc_protection_t;
+#endif
 
 /********************************************************************************
  * Static Variables
@@ -69,8 +86,15 @@ temp_stats_data_t tempStats[TOTAL_MEASUREMENT_COUNT] = {0};
 #if (IS_ADC_STATS_CORE && ADC_BULK_STATS) || IS_STORAGE_CORE || IS_ADC_CORE
 static adc_processed_data_t* processedAdcData = NULL;
 #endif
+#if IS_STORAGE_CORE
+static uint32_t storageDefaults[STORAGE_WORD_LEN];
+#endif
+#if ADC_FAST_PROTECTION
+static adc_protection_t protection = {0};
+#endif
 #if IS_ADC_CORE
 static adc_raw_data_t* rawAdcData = NULL;
+static uint32_t appliedCalibrationVersion = 0;
 #if USE_LOCAL_ADC_STORAGE
 static ring_buffer_t adcProcessedRingBuff = { .rdIndex = 0, .wrIndex = 0, .modulo = RAW_MEASURE_SAVE_COUNT - 1 };
 #if !EN_DMA_ADC_DATA_COLLECTION
@@ -117,18 +141,73 @@ ring_buffer_t adcLocalIndexRingBuff = { .rdIndex = 0, .wrIndex = 0, .modulo = LO
 #if IS_ADC_CORE
 #pragma GCC push_options
 #pragma GCC optimize ("-Ofast")
+#if ADC_FAST_PROTECTION
 /**
- * @brief Updates the data parameters and data sharing items.
- * @note Should be called frequently to avoid data missing.
+ * @brief Converts a protection limit to the raw ADC value.
+ * @param value Limit in measurement units.
+ * @param index Channel index.
+ * @return Raw ADC value rounded to the nearest step.
  */
-void BSP_ADC_RefreshData(void)
+static uint32_t GetRawLimit(float value, int index)
 {
+	// inverse of value = (raw - offset) * sensitivity
+	float raw = (value / adcSensitivity[index]) + adcOffsets[index];
+	if (raw <= 0)
+		return 0;
+	if (raw >= 65535.f)
+		return 65535;
+	return (uint32_t)(raw + .5f);
+}
+
+/**
+ * @brief Updates the raw limits of the fast protection with the current sensitivities and offsets.
+ */
+static void UpdateProtectionLimits(void)
+{
+	for (int i = 0; i < TOTAL_MEASUREMENT_COUNT; i++)
+	{
+		uint32_t low = GetRawLimit(protection.config.min[i], i);
+		uint32_t high = GetRawLimit(protection.config.max[i], i);
+		// negative sensitivity inverts the limits
+		if (low > high)
+		{
+			uint32_t temp = low;
+			low = high;
+			high = temp;
+		}
+		// single write so that the interrupt never uses half updated limits
+		protection.rawLimits[i] = low | (high << 16);
+	}
+}
+#endif
+/**
+ * @brief Updates the conversion parameters and the protection limits with the current offsets and sensitivities.
+ */
+static void UpdateCalibration(void)
+{
+	appliedCalibrationVersion = processedAdcData->info.calibrationVersion;
+	__DMB();
 	int i = TOTAL_MEASUREMENT_COUNT;
 	while (i--)
 	{
 		adcSensitivity[i] = (10.f / 32768.f) / processedAdcData->info.sensitivity[i];
 		adcOffsets[i] = 32768.f + (processedAdcData->info.offsets[i] / adcSensitivity[i]);
 	}
+#if ADC_FAST_PROTECTION
+	if (protection.activeMask)
+		UpdateProtectionLimits();
+#endif
+}
+
+/**
+ * @brief Updates the data parameters and data sharing items.
+ * @details The conversion parameters are only updated once the offsets or sensitivities are changed.
+ * @note Should be called frequently to avoid data missing.
+ */
+void BSP_ADC_RefreshData(void)
+{
+	if (processedAdcData->info.calibrationVersion != appliedCalibrationVersion)
+		UpdateCalibration();
 
 #if USE_LOCAL_ADC_STORAGE
 	// Get available count for writing available with one write option
@@ -168,6 +247,7 @@ void BSP_ADC_SetDefaultParams(adc_processed_data_t* _processedAdcData, adc_raw_d
 	_rawAdcData->recordIndex = 0;
 	processedAdcData = _processedAdcData;
 	rawAdcData = _rawAdcData;
+	UpdateCalibration();
 	BSP_ADC_RefreshData();
 }
 #pragma GCC pop_options
@@ -246,6 +326,90 @@ timer_trigger_src_t BSP_ADC_SetInputOutputTrigger(tim_in_trigger_config_t* _slav
 #endif
 }
 
+#if ADC_FAST_PROTECTION
+/**
+ * @brief Configures the fast protection of the ADC channels and rearms it.
+ * @details The raw limits are updated in @ref BSP_ADC_RefreshData() once the sensitivities or offsets are changed.
+ * @param _config Pointer to the protection configuration. Send NULL to disable the protection.
+ */
+void BSP_ADC_ConfigProtection(const adc_protection_config_t* _config)
+{
+	// stop checking before updating the configuration
+	protection.activeMask = 0;
+	__DMB();
+	if (_config == NULL)
+		return;
+
+	memcpy(&protection.config, _config, sizeof(adc_protection_config_t));
+	UpdateProtectionLimits();
+	BSP_ADC_ResetProtection();
+	__DMB();
+	protection.activeMask = _config->channelMask & ((1U << TOTAL_MEASUREMENT_COUNT) - 1);
+}
+
+/**
+ * @brief Rearms the fast protection after a trip.
+ * @note The disabled PWM outputs are not enabled again.
+ */
+void BSP_ADC_ResetProtection(void)
+{
+	memset(protection.counts, 0, sizeof(protection.counts));
+	__DMB();
+	protection.tripMask = 0;
+}
+
+/**
+ * @brief Gets the channels which tripped the fast protection.
+ * @return Channels exceeding the limits. Bit n for channel n + 1. 0 if not tripped.
+ */
+uint16_t BSP_ADC_GetProtectionTrip(void)
+{
+	return protection.tripMask;
+}
+
+#pragma GCC push_options
+#pragma GCC optimize ("-Ofast")
+/**
+ * @brief Checks the raw samples against the protection limits and disables the PWM outputs on trip.
+ * @note Called by the ADC driver in the conversion interrupt.
+ * @param _rawData Pointer to the raw samples of all channels.
+ */
+TCritical void BSP_ADC_CheckProtection(const uint16_t* _rawData)
+{
+	uint32_t mask = protection.activeMask;
+	if (mask == 0 || protection.tripMask)
+		return;
+
+	uint32_t tripMask = 0;
+	for (int i = 0; mask; i++, mask >>= 1)
+	{
+		if ((mask & 1U) == 0)
+			continue;
+		uint32_t limits = protection.rawLimits[i];
+		uint32_t value = _rawData[i];
+		if (value < (limits & 0xFFFF) || value > (limits >> 16))
+		{
+			if (++protection.counts[i] >= protection.config.debounceCount)
+				tripMask |= 1U << i;
+		}
+		else
+			protection.counts[i] = 0;
+	}
+	if (tripMask == 0)
+		return;
+
+	// disable the outputs first, everything else can wait
+	BSP_PWMOut_ForceDisable(protection.config.pwmMask);
+	protection.tripMask = tripMask;
+	if (protection.config.callback)
+		protection.config.callback(tripMask);
+#if TRACE_ENABLE
+	Trace_Log(TRACE_EVT_FAULT, tripMask, protection.config.pwmMask);
+#endif
+}
+#pragma GCC pop_options
+#endif
+
 #endif
 
 #if IS_COMMS_CORE
@@ -277,6 +441,9 @@ device_err_t BSP_ADC_UpdateConfig(adc_info_t* _info, float _fs, int _channelInde
 	_info->sensitivity[_channelIndex] = _sensitivity;
 	_info->offsets[_channelIndex] = _offset;
 	_info->units[_channelIndex] = _unit;
+	// the ADC core updates the conversion parameters once the new values are visible
+	__DMB();
+	_info->calibrationVersion++;
 #if IS_ADC_STATS_CORE && ADC_BULK_STATS
 	tempStats[_channelIndex].sampleCount = GET_SAMPLE_COUNT(_fs, _freq);
 #endif
@@ -376,6 +543,8 @@ static void InitStatesFromStorage(uint32_t* data, bool isDataValid)
 			info->units[i] = DEFAULT_UNIT;
 		}
 	}
+	__DMB();
+	info->calibrationVersion++;
 }
 static uint32_t RefreshStates(uint32_t* data, uint32_t* indexPtr)
 {
@@ -431,6 +600,19 @@ void BSP_ADC_ConfigStorage(state_storage_client_t* _config)
 	_config->InitStatesFromStorage = InitStatesFromStorage;
 	_config->RefreshStates = RefreshStates;
 	_config->dataWordLen = STORAGE_WORD_LEN;
+
+	// Default states used as reference for compressing the storage
+	float* defaults = (float*)storageDefaults;
+	for (int i = 0; i < TOTAL_MEASUREMENT_COUNT; i++)
+	{
+		defaults[i * 3] = DEFAULT_FREQ;
+		defaults[i * 3 + 1] = DEFAULT_SENSITIVITY;
+		defaults[i * 3 + 2] = DEFAULT_OFFSET;
+	}
+	uint8_t* defaultsU8 = (uint8_t*)(defaults + (TOTAL_MEASUREMENT_COUNT * 3));
+	for (int i = 0; i < TOTAL_MEASUREMENT_COUNT; i++)
+		defaultsU8[i] = DEFAULT_UNIT;
+	_config->defaults = storageDefaults;
 }
 
 #endif
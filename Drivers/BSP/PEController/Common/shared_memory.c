@@ -40,13 +40,27 @@
 /********************************************************************************
  * Static Variables
  *******************************************************************************/
-
+#ifdef CORE_CM7
+/**
+ * @brief Memory attributes of the shared memory regions.
+ * @note The complete shared memory is kept non-cacheable because both cores write to it. The applications
+ * currently run the CM7 with the data cache disabled, where this has no effect. It keeps the shared memory
+ * coherent without cache maintenance once an application enables the data cache with SCB_EnableDCache(),
+ * which should be done after @ref SharedMemory_Init(). Cacheable regions would additionally need
+ * SCB_CleanDCache_by_Addr() / SCB_InvalidateDCache_by_Addr() on whole cache lines, which is only safe
+ * because no cache line contains data written by both cores.
+ */
+static const shared_memory_region_t sharedRegions[] =
+{
+		{ .baseAddr = SHARED_MEMORY_BASE_ADDR, .size = MPU_REGION_SIZE_64KB, .number = MPU_REGION_NUMBER0, .isCacheable = false, .isShareable = true },
+};
+#endif
 /********************************************************************************
  * Global Variables
  *******************************************************************************/
 /** Pointer to the shared data variable
  */
-volatile shared_data_t * const sharedData = (shared_data_t *)0x38000000;
+volatile shared_data_t * const sharedData = (shared_data_t *)SHARED_DATA_ADDR;
 /********************************************************************************
  * Function Prototypes
  *******************************************************************************/
@@ -54,17 +68,52 @@ volatile shared_data_t * const sharedData = (shared_data_t *)0x38000000;
 /********************************************************************************
  * Code
  *******************************************************************************/
+#ifdef CORE_CM7
+/**
+ * @brief Apply the memory attributes of the shared memory regions in the MPU.
+ */
+static void SharedMemory_ConfigRegions(void)
+{
+	MPU_Region_InitTypeDef mpuInit = {0};
+	HAL_MPU_Disable();
+	for (uint32_t i = 0; i < sizeof(sharedRegions) / sizeof(shared_memory_region_t); i++)
+	{
+		mpuInit.Enable = MPU_REGION_ENABLE;
+		mpuInit.Number = sharedRegions[i].number;
+		mpuInit.BaseAddress = sharedRegions[i].baseAddr;
+		mpuInit.Size = sharedRegions[i].size;
+		mpuInit.SubRegionDisable = 0x00;
+		mpuInit.TypeExtField = MPU_TEX_LEVEL0;
+		mpuInit.AccessPermission = MPU_REGION_FULL_ACCESS;
+		mpuInit.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
+		mpuInit.IsShareable = sharedRegions[i].isShareable ? MPU_ACCESS_SHAREABLE : MPU_ACCESS_NOT_SHAREABLE;
+		mpuInit.IsCacheable = sharedRegions[i].isCacheable ? MPU_ACCESS_CACHEABLE : MPU_ACCESS_NOT_CACHEABLE;
+		mpuInit.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
+		HAL_MPU_ConfigRegion(&mpuInit);
+	}
+	HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
+}
+#endif
 /**
  * @brief Initialize the shared memory
  */
 void SharedMemory_Init(void)
 {
+#ifdef CORE_CM7
+	SharedMemory_ConfigRegions();
+#endif
 #if !IS_STORAGE_CORE
 	sharedData->isStateStorageInitialized = false;
 #endif
 #if IS_CONTROL_CORE
 	P2PComms_InitData();
 #endif
+#if PROFILER_ENABLE && IS_CONTROL_CORE
+	Profiler_Init();
+#endif
+#if TRACE_ENABLE
+	Trace_Init();
+#endif
 #if IS_ADC_CORE
 	BSP_ADC_SetDefaultParams((adc_processed_data_t*)&PROCESSED_ADC_DATA, (adc_raw_data_t*)&RAW_ADC_DATA);
 #endif
@@ -25,9 +25,18 @@
 #include "p2p_comms.h"
 #include "shared_memory.h"
 #include "utility_lib.h"
+#if IS_COMMS_CORE
+#include "cmsis_os.h"
+#endif
 /********************************************************************************
  * Defines
  *******************************************************************************/
+#if IS_COMMS_CORE
+/**
+ * @brief Thread flag used to wake up a task waiting for a response.
+ */
+#define RESPONSE_THREAD_FLAG			(0x10000000U)
+#endif
 
 /********************************************************************************
  * Typedefs
@@ -40,27 +49,35 @@
 /********************************************************************************
  * Static Variables
  *******************************************************************************/
-#if IS_COMMS_CORE
 /**
  * @brief Describes the limits of each type of parameters
  * @note The order should strictly match @ref base_data_type_t
  */
-static uint8_t p2pItemsConfig[DTYPE_COUNT] =
+static const uint8_t p2pItemsConfig[DTYPE_COUNT] =
 {
 		P2P_BOOL_COUNT,
 		P2P_U8_COUNT,
-		P2P_U16_COUNT,
-		P2P_U32_COUNT,
 		P2P_S8_COUNT,
+		P2P_U16_COUNT,
 		P2P_S16_COUNT,
+		P2P_U32_COUNT,
 		P2P_S32_COUNT,
 		P2P_FLOAT_COUNT,
 		P2P_BIT_ACCESS_COUNT
 };
-#endif
 #if IS_STORAGE_CORE
 static uint32_t storageWordLen = 0;
 #endif
+#if IS_COMMS_CORE
+/**
+ * @brief Tasks waiting for the response of each message slot.
+ */
+static volatile osThreadId_t waitingThreads[P2P_COMMS_MSGS_SIZE] = {0};
+/**
+ * @brief <c>true</c> if the response notifications are enabled.
+ */
+static bool isNotificationEnabled = false;
+#endif
 /********************************************************************************
  * Global Variables
  *******************************************************************************/
@@ -72,6 +89,57 @@ static uint32_t storageWordLen = 0;
 /********************************************************************************
  * Code
  *******************************************************************************/
+#if IS_COMMS_CORE && P2P_COMMS_ENABLE_BENCHMARK
+/**
+ * @brief Add a completed request to the messaging statistics.
+ * @param cycles Round trip time of the request in CPU cycles.
+ * @param pendingMsgs No of messages in the queue when the request was placed.
+ */
+static void RecordRequestStats(uint32_t cycles, uint32_t pendingMsgs)
+{
+	volatile p2p_comms_stats_t* stats = &CORE_MSGS.stats;
+	uint32_t bin = cycles == 0 ? 0 : 31 - __CLZ(cycles);
+	if (bin >= P2P_COMMS_LATENCY_BINS)
+		bin = P2P_COMMS_LATENCY_BINS - 1;
+
+	stats->requestCount++;
+	stats->totalCycles += cycles;
+	stats->histogram[bin]++;
+	if (cycles < stats->minCycles)
+		stats->minCycles = cycles;
+	if (cycles > stats->maxCycles)
+		stats->maxCycles = cycles;
+	if (pendingMsgs > stats->maxPendingMsgs)
+		stats->maxPendingMsgs = pendingMsgs;
+}
+#endif
+/**
+ * @brief Get the location of a register in the shared data buffers.
+ * @details The returned pointer can be used to directly read the binary value of the register
+ * without any intermediate copies or text conversions. Cast it to the pointer of the relevant type.
+ * @param type Data type of the register.
+ * @param index Register index.
+ * @return Pointer to the register if valid else <c>NULL</c>.
+ */
+volatile void* P2PComms_GetRegisterPtr(base_data_type_t type, uint8_t index)
+{
+	if (type >= DTYPE_COUNT || index >= p2pItemsConfig[type])
+		return NULL;
+
+	switch (type)
+	{
+	case DTYPE_BOOL: return &INTER_CORE_DATA.bools[index];
+	case DTYPE_U8: return &INTER_CORE_DATA.u8s[index];
+	case DTYPE_S8: return &INTER_CORE_DATA.s8s[index];
+	case DTYPE_U16: return &INTER_CORE_DATA.u16s[index];
+	case DTYPE_S16: return &INTER_CORE_DATA.s16s[index];
+	case DTYPE_U32: return &INTER_CORE_DATA.u32s[index];
+	case DTYPE_S32: return &INTER_CORE_DATA.s32s[index];
+	case DTYPE_FLOAT: return &INTER_CORE_DATA.floats[index];
+	case DTYPE_BIT_ACCESS: return &INTER_CORE_DATA.bitAccess[index];
+	default: return NULL;
+	}
+}
 #if IS_COMMS_CORE
 /**
  * @brief Update a parameter in control.
@@ -84,10 +152,14 @@ static uint32_t storageWordLen = 0;
  */
 __weak device_err_t P2PComms_SingleUpdateRequest_Blocking(p2p_msg_type_t type, uint8_t index, data_union_t value)
 {
+#if P2P_COMMS_ENABLE_BENCHMARK
+	uint32_t startCycles = DWT->CYCCNT;
+#endif
 	// Disable IRQ to avoid clash
 	__disable_irq();
 
 	volatile p2p_msg_t* msg = &CORE_MSGS.msgs[CORE_MSGS.msgsRingBuff.wrIndex];
+	waitingThreads[CORE_MSGS.msgsRingBuff.wrIndex] = isNotificationEnabled ? osThreadGetId() : NULL;
 	msg->type = type;
 	msg->firstReg = index;
 	msg->cmdIndex = CORE_MSGS.cmdsRingBuff.wrIndex;
@@ -96,18 +168,72 @@ __weak device_err_t P2PComms_SingleUpdateRequest_Blocking(p2p_msg_type_t type, u
 	msg->responseIndex = msg->responseLen = -1;
 	RingBuffer_Write((ring_buffer_t*)&CORE_MSGS.msgsRingBuff);
 	RingBuffer_Write((ring_buffer_t*)&CORE_MSGS.cmdsRingBuff);
+#if P2P_COMMS_ENABLE_BENCHMARK
+	uint32_t pendingMsgs = RingBuffer_GetPendingReadCount((ring_buffer_t*)&CORE_MSGS.msgsRingBuff);
+#endif
 
 	// Enable IRQ after process done
 	__enable_irq();
 
-	int temp = -1;
-	while (temp == -1)
+	P2PComms_WaitForResponse(msg);
+
+#if P2P_COMMS_ENABLE_BENCHMARK
+	RecordRequestStats(DWT->CYCCNT - startCycles, pendingMsgs);
+#endif
+	return (device_err_t)CORE_MSGS.response[msg->responseIndex].u8;
+}
+/**
+ * @brief Enable the response notifications from the control core.
+ * @details Once enabled the tasks waiting in @ref P2PComms_SingleUpdateRequest_Blocking() are woken up by the
+ * hardware semaphore interrupt as soon as the response is ready, instead of polling at each RTOS tick.
+ * @note Call this function after the RTOS kernel is initialized. If not called the responses are polled.
+ */
+void P2PComms_InitNotifications(void)
+{
+	__HAL_RCC_HSEM_CLK_ENABLE();
+	__HAL_HSEM_CLEAR_FLAG(__HAL_HSEM_SEMID_TO_MASK(P2P_COMMS_HSEM_ID));
+	HAL_HSEM_ActivateNotification(__HAL_HSEM_SEMID_TO_MASK(P2P_COMMS_HSEM_ID));
+	HAL_NVIC_SetPriority(HSEM2_IRQn, P2P_COMMS_HSEM_IRQ_PRIORITY, 0);
+	HAL_NVIC_EnableIRQ(HSEM2_IRQn);
+	isNotificationEnabled = true;
+}
+/**
+ * @brief Wait till the control core responds to a message.
+ * @note A weak implementation of this function is provided. User can create a custom implementation if needed.
+ * @param msg Message waiting for the response.
+ */
+__weak void P2PComms_WaitForResponse(volatile p2p_msg_t* msg)
+{
+	// Wait for notification if enabled, but still time out at each tick so a lost notification only delays the response
+	while (msg->responseIndex == -1)
 	{
-		osDelay(1);
-		temp = msg->responseIndex;
+		if (isNotificationEnabled)
+			(void)osThreadFlagsWait(RESPONSE_THREAD_FLAG, osFlagsWaitAny, 1);
+		else
+			osDelay(1);
 	}
+}
+/**
+ * @brief Interrupt handler for the hardware semaphores released for the communication core.
+ * @details Wakes up all the tasks whose messages have been responded.
+ */
+void HSEM2_IRQHandler(void)
+{
+	uint32_t mask = HSEM_COMMON->MISR;
+	HSEM_COMMON->ICR = mask;
 
-	return (device_err_t)CORE_MSGS.response[msg->responseIndex].u8;
+	if ((mask & __HAL_HSEM_SEMID_TO_MASK(P2P_COMMS_HSEM_ID)) == 0)
+		return;
+
+	for (int i = 0; i < P2P_COMMS_MSGS_SIZE; i++)
+	{
+		osThreadId_t thread = waitingThreads[i];
+		if (thread != NULL && CORE_MSGS.msgs[i].responseIndex != -1)
+		{
+			waitingThreads[i] = NULL;
+			(void)osThreadFlagsSet(thread, RESPONSE_THREAD_FLAG);
+		}
+	}
 }
 /**
  * @brief Validates that the parameter is valid.
@@ -190,14 +316,74 @@ __weak device_err_t P2PComms_UpdateValue(data_param_info_t* _paramInfo, data_uni
 	}
 }
 /**
- * @brief Get the value of a parameter (shared between both processors) in string format.
- * @note A weak implementation of this function is provided. User can create a custom implementation if needed.
+ * @brief Get the binary value of a parameter shared in both cores.
+ * @details The value is read directly from the shared data buffers. No text conversion is involved,
+ * so use this function instead of @ref P2PComms_GetStringValue() when the value is not meant for display.
+ * @param id Parameter identifier in @ref p2pCommsParams.
+ * @param value Writes the acquired value at this pointer location.
+ * @return device_err_t If successful <c>ERR_OK</c> else some other error.
+ */
+device_err_t P2PComms_GetValueById(p2p_params_type_t id, data_union_t* value)
+{
+	if (id >= P2P_PARAM_COUNT)
+		return ERR_ILLEGAL;
+	return GetDataParameter(&p2pCommsParams[id], value);
+}
+/**
+ * @brief Update the binary value of a parameter shared in both cores.
+ * @details The value is delivered to the control core as is. No text conversion is involved,
+ * so use this function instead of @ref P2PComms_UpdateFromString() when the value is not coming from user text.
+ * @note This is a blocking call and will return only after request is completed.
+ * @param id Parameter identifier in @ref p2pCommsParams.
+ * @param value Value to be updated.
+ * @return device_err_t If successful <c>ERR_OK</c> else some other error.
+ */
+device_err_t P2PComms_UpdateValueById(p2p_params_type_t id, data_union_t value)
+{
+	if (id >= P2P_PARAM_COUNT)
+		return ERR_ILLEGAL;
+	return SetDataParameter(&p2pCommsParams[id], value);
+}
+/**
+ * @brief Find a parameter in @ref p2pCommsParams by its name.
+ * @details Performs a binary search over @ref p2pCommsParamsNameIndex, so the lookup
+ * takes O(log N) string comparisons. If multiple parameters share the same name any one of them may be returned.
+ * @param name Name of the parameter.
+ * @param id Writes the identifier of the parameter at this pointer location.
+ * @return device_err_t If successful <c>ERR_OK</c> else some other error.
+ */
+device_err_t P2PComms_FindParameterByName(const char* name, p2p_params_type_t* id)
+{
+	if (name == NULL)
+		return ERR_ILLEGAL;
+
+	int low = 0;
+	int high = P2P_PARAM_COUNT - 1;
+	while (low <= high)
+	{
+		int mid = (low + high) / 2;
+		uint8_t index = p2pCommsParamsNameIndex[mid];
+		int cmp = strcmp(name, p2pCommsParams[index].name);
+		if (cmp == 0)
+		{
+			*id = (p2p_params_type_t)index;
+			return ERR_OK;
+		}
+		if (cmp < 0)
+			high = mid - 1;
+		else
+			low = mid + 1;
+	}
+	return ERR_NOT_AVAILABLE;
+}
+/**
+ * @brief Default implementation of @ref P2PComms_GetStringValue().
  * @param _paramInfo Relevant parameter information.
  * @param value text value to be updated.
  * @param addUnit If <c>true</c> append the unit of the parameter at the end of the string result.
  * @return device_err_t If successful <c>ERR_OK</c> else some other error.
  */
-__weak device_err_t P2PComms_GetStringValue(data_param_info_t* _paramInfo, char* value, bool addUnit)
+static device_err_t GetStringValue(data_param_info_t* _paramInfo, char* value, bool addUnit)
 {
 	data_union_t dataVal;
 	device_err_t err = P2PComms_GetValue(_paramInfo, &dataVal);
@@ -227,6 +413,15 @@ __weak device_err_t P2PComms_GetStringValue(data_param_info_t* _paramInfo, char*
 		strcat_custom(value, unitTxts[_paramInfo->unit], len, false);
 	return ERR_OK;
 }
+/**
+ * @brief Get the value of a parameter (shared between both processors) in string format.
+ * @note A weak implementation of this function is provided. User can create a custom implementation if needed.
+ * @param _paramInfo Relevant parameter information.
+ * @param value text value to be updated.
+ * @param addUnit If <c>true</c> append the unit of the parameter at the end of the string result.
+ * @return device_err_t If successful <c>ERR_OK</c> else some other error.
+ */
+__weak device_err_t P2PComms_GetStringValue(data_param_info_t* _paramInfo, char* value, bool addUnit) __attribute__((alias("GetStringValue")));
 /**
  * @brief Update the value of a parameter (shared between both processors) from a string value.
  * @note A weak implementation of this function is provided. User can create a custom implementation if needed.
@@ -279,6 +474,17 @@ __weak device_err_t P2PComms_UpdateFromString(data_param_info_t* _paramInfo, con
 	}
 	return ERR_ILLEGAL;
 }
+/**
+ * @brief Default implementation of @ref Default_GetDataParameter_InText().
+ * @param _paramInfo Structure defining the parameter.
+ * @param value Pointer to the location to be updated with the value
+ * @param addUnit <c>true</c> if unit needs to be added with the text else false.
+ * @return <c>ERR_OK</c> if no error else appropriate error thrown
+ */
+static device_err_t GetDataParameterInText(data_param_info_t* _paramInfo, char* value, bool addUnit)
+{
+	return P2PComms_GetStringValue(_paramInfo, value, addUnit);
+}
 /**
  * @brief Default function to get the data parameters in textual format, according to the parameter info.
  * @note A weak implementation of this function is provided. User can create a custom implementation if needed.
@@ -287,9 +493,18 @@ __weak device_err_t P2PComms_UpdateFromString(data_param_info_t* _paramInfo, con
  * @param addUnit <c>true</c> if unit needs to be added with the text else false.
  * @return <c>ERR_OK</c> if no error else appropriate error thrown
  */
-__weak device_err_t Default_GetDataParameter_InText(data_param_info_t* _paramInfo, char* value, bool addUnit)
+__weak device_err_t Default_GetDataParameter_InText(data_param_info_t* _paramInfo, char* value, bool addUnit) __attribute__((alias("GetDataParameterInText")));
+/**
+ * @brief Checks if the parameters without @ref data_param_info_t.Getter_InText are converted to text by the
+ * weak implementations of @ref Default_GetDataParameter_InText() and @ref P2PComms_GetStringValue().
+ * @details The weak implementations are aliases, so the check fails when the application overrides any of them.
+ * The display uses it to decide if such parameters can be formatted in batches with @ref String_FormatBatch(),
+ * which produces the same text.
+ * @return <c>true</c> if the weak implementations are in effect else <c>false</c>.
+ */
+bool P2PComms_IsDefaultTextFormat(void)
 {
-	return P2PComms_GetStringValue(_paramInfo, value, addUnit);
+	return Default_GetDataParameter_InText == GetDataParameterInText && P2PComms_GetStringValue == GetStringValue;
 }
 /**
  * @brief  Default function to set the data parameters from textual value, according to the parameter info.
@@ -327,6 +542,111 @@ __weak device_err_t Default_SetDataParameter(data_param_info_t* _paramInfo, data
 	return P2PComms_UpdateValue(_paramInfo, value);
 }
 
+#if P2P_COMMS_ENABLE_BENCHMARK
+/**
+ * @brief Reset the messaging statistics in @ref p2p_msg_data_t.stats and start the DWT cycle counter.
+ */
+void P2PComms_ResetStats(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	memset((void*)&CORE_MSGS.stats, 0, sizeof(p2p_comms_stats_t));
+	CORE_MSGS.stats.minCycles = UINT32_MAX;
+}
+/**
+ * @brief Place a batch of @ref MSG_ECHO messages in the message queue.
+ * @param msgSize No of data words in the command buffer for each message.
+ * @param batchSize No of messages to be placed.
+ * @return Pointer to the last message of the batch.
+ */
+static volatile p2p_msg_t* PlaceEchoBatch(uint16_t msgSize, uint16_t batchSize)
+{
+	volatile p2p_msg_t* msg = NULL;
+	for (uint16_t i = 0; i < batchSize; i++)
+	{
+		// Disable IRQ to avoid clash
+		__disable_irq();
+		msg = &CORE_MSGS.msgs[CORE_MSGS.msgsRingBuff.wrIndex];
+		// only the last message wakes up the task as the messages are processed in order
+		waitingThreads[CORE_MSGS.msgsRingBuff.wrIndex] = (isNotificationEnabled && i == batchSize - 1) ? osThreadGetId() : NULL;
+		msg->type = MSG_ECHO;
+		msg->firstReg = 0;
+		msg->cmdIndex = CORE_MSGS.cmdsRingBuff.wrIndex;
+		for (uint16_t j = 0; j < msgSize; j++)
+			CORE_MSGS.cmds[(msg->cmdIndex + j) & CORE_MSGS.cmdsRingBuff.modulo].u32 = j;
+		msg->cmdLen = msgSize;
+		msg->responseIndex = msg->responseLen = -1;
+		RingBuffer_Write((ring_buffer_t*)&CORE_MSGS.msgsRingBuff);
+		RingBuffer_Write_Count((ring_buffer_t*)&CORE_MSGS.cmdsRingBuff, msgSize);
+		// Enable IRQ after process done
+		__enable_irq();
+	}
+	return msg;
+}
+/**
+ * @brief Measure the messaging throughput by sending @ref MSG_ECHO messages to the control core.
+ * @details The messages are placed in batches and the next batch is placed once the complete batch is
+ * responded, so the result also includes the response time of the control core. The round trip of each
+ * batch is recorded as a single request. The results are stored in @ref p2p_msg_data_t.stats.
+ * @note This is a blocking call and will return only after all messages are processed.
+ * @note The buffer sizes are compile time settings in p2p_comms_app.h, so rebuild to compare different buffer sizes.
+ * @param msgCount No of messages to be sent.
+ * @param msgSize No of data words in the command buffer for each message. The batch uses at most half of the command buffer.
+ * @param batchSize No of messages placed together. Limited to half of the message queue.
+ * @return Throughput in messages per second.
+ */
+float P2PComms_RunBenchmark(uint32_t msgCount, uint16_t msgSize, uint16_t batchSize)
+{
+	// leave space in the buffers for the other requesting tasks
+	if (batchSize == 0)
+		batchSize = 1;
+	else if (batchSize > P2P_COMMS_MSGS_SIZE / 2)
+		batchSize = P2P_COMMS_MSGS_SIZE / 2;
+	if (msgSize == 0)
+		msgSize = 1;
+	else if (msgSize * batchSize > P2P_COMMS_CMD_BUFF_SIZE / 2)
+		msgSize = (P2P_COMMS_CMD_BUFF_SIZE / 2) / batchSize;
+	P2PComms_ResetStats();
+
+	// accumulate each batch separately as the cycle counter overflows within seconds
+	uint64_t cycles = 0;
+	for (uint32_t sent = 0; sent < msgCount; sent += batchSize)
+	{
+		uint16_t count = (msgCount - sent) < batchSize ? (uint16_t)(msgCount - sent) : batchSize;
+		uint32_t startCycles = DWT->CYCCNT;
+		volatile p2p_msg_t* msg = PlaceEchoBatch(msgSize, count);
+		uint32_t pendingMsgs = RingBuffer_GetPendingReadCount((ring_buffer_t*)&CORE_MSGS.msgsRingBuff);
+		P2PComms_WaitForResponse(msg);
+		uint32_t batchCycles = DWT->CYCCNT - startCycles;
+		RecordRequestStats(batchCycles, pendingMsgs);
+		cycles += batchCycles;
+	}
+
+	CORE_MSGS.stats.benchmarkMsgs = msgCount;
+	CORE_MSGS.stats.benchmarkCycles = cycles;
+	CORE_MSGS.stats.msgsPerSec = cycles == 0 ? 0 : (msgCount * (float)SystemCoreClock) / cycles;
+	return CORE_MSGS.stats.msgsPerSec;
+}
+/**
+ * @brief Run @ref P2PComms_RunBenchmark() for message sizes of 1, 4, 16 and 64 words with batch sizes of 1, 4, 16 and 32 messages.
+ * @details The throughput of each combination is stored in @ref p2p_comms_stats_t.sweepMsgsPerSec.
+ * @note This is a blocking call and will return only after all messages are processed.
+ * @param msgCount No of messages to be sent for each combination.
+ */
+void P2PComms_RunBenchmarkSweep(uint32_t msgCount)
+{
+	static const uint16_t msgSizes[P2P_COMMS_SWEEP_COUNT] = { 1, 4, 16, 64 };
+	static const uint16_t batchSizes[P2P_COMMS_SWEEP_COUNT] = { 1, 4, 16, 32 };
+	float results[P2P_COMMS_SWEEP_COUNT][P2P_COMMS_SWEEP_COUNT];
+
+	for (int i = 0; i < P2P_COMMS_SWEEP_COUNT; i++)
+		for (int j = 0; j < P2P_COMMS_SWEEP_COUNT; j++)
+			results[i][j] = P2PComms_RunBenchmark(msgCount, msgSizes[i], batchSizes[j]);
+	// each run resets the statistics, so copy the results at the end
+	memcpy((void*)CORE_MSGS.stats.sweepMsgsPerSec, results, sizeof(results));
+}
+#endif
 #endif
 
 #if IS_STORAGE_CORE
@@ -512,6 +832,16 @@ __weak device_err_t P2PComms_ToggleBits(uint8_t index, uint8_t value)
 		INTER_CORE_DATA.bitAccess[index] ^= value;
 	return ERR_OK;
 }
+/**
+ * @brief Notify the communication core that a response is ready.
+ * @note A weak implementation of this function is provided. User can create a custom implementation if needed.
+ */
+__weak void P2PComms_NotifyResponse(void)
+{
+	// Releasing the semaphore generates the interrupt in the communication core if enabled
+	if (HAL_HSEM_FastTake(P2P_COMMS_HSEM_ID) == HAL_OK)
+		HAL_HSEM_Release(P2P_COMMS_HSEM_ID, 0);
+}
 /**
  * @brief Process the pending request for interprocessor communications.
  * @note Call this function frequently to make sure that interprocessor communications work flawlessly.
@@ -541,6 +871,7 @@ __weak void P2PComms_ProcessPendingRequests(void)
 		case MSG_SET_BITS: err = P2PComms_SetBits(index, value->bits); break;
 		case MSG_CLR_BITS: err = P2PComms_ClearBits(index, value->bits); break;
 		case MSG_TOGGLE_BITS: err = P2PComms_ToggleBits(index, value->bits); break;
+		case MSG_ECHO: err = ERR_OK; break;
 		default: err = ERR_ILLEGAL; break;
 		}
 	}
@@ -552,6 +883,8 @@ __weak void P2PComms_ProcessPendingRequests(void)
 	RingBuffer_Write((ring_buffer_t*)&CORE_MSGS.responseRingBuff);
 	RingBuffer_Read((ring_buffer_t*)&CORE_MSGS.msgsRingBuff);
 
+	P2PComms_NotifyResponse();
+
 }
 /**
  * @brief Initialize the buffers and storage for the interprocessor communications.
@@ -0,0 +1,149 @@
+/**
+ ********************************************************************************
+ * @file    	pecontroller_deadline.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Checks the execution time of the time critical interrupts against their deadlines.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "pecontroller_deadline.h"
+#if DEADLINE_MONITOR_ENABLE && IS_CONTROL_CORE
+#include "pecontroller_pwm.h"
+#include "pecontroller_trace.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+
+/********************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/********************************************************************************
+ * Structures
+ *******************************************************************************/
+
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+
+/********************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+/**
+ * @brief Sets the sampling period and budget of the monitor from the sampling frequency.
+ * @details Starts the DWT cycle counter if not already running. The status of the monitor is kept,
+ * only the interval from the last entry at the previous frequency is not checked for skipped samples.
+ * @param monitor Pointer to the monitor.
+ * @param fs Sampling frequency in Hz.
+ */
+void BSP_Deadline_SetFrequency(deadline_monitor_t* monitor, float fs)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	float ratio = (monitor->budgetRatio > 0 && monitor->budgetRatio < 1) ? monitor->budgetRatio : 1;
+	monitor->periodCycles = (uint32_t)(SystemCoreClock / fs);
+	monitor->budgetCycles = (uint32_t)(monitor->periodCycles * ratio);
+	monitor->hasEntry = false;
+}
+
+/**
+ * @brief Clears the status of the monitor and rearms the safe state action.
+ * @note The PWM outputs disabled by the safe state action are not enabled again.
+ * @param monitor Pointer to the monitor.
+ */
+void BSP_Deadline_Reset(deadline_monitor_t* monitor)
+{
+	monitor->hasEntry = false;
+	monitor->lastCycles = 0;
+	monitor->maxCycles = 0;
+	monitor->runCount = 0;
+	monitor->overrunCount = 0;
+	monitor->skippedCount = 0;
+	monitor->consecutiveMisses = 0;
+	monitor->maxConsecutiveMisses = 0;
+	monitor->isTripped = false;
+}
+
+/**
+ * @brief Checks the execution against the deadline and takes the safe state action if required.
+ * @note Use @ref BSP_Deadline_Exit() instead of calling this function directly.
+ * @param monitor Pointer to the monitor.
+ * @param cycles Execution time in cycles.
+ */
+TCritical void BSP_Deadline_Record(deadline_monitor_t* monitor, uint32_t cycles)
+{
+	bool isMissed = false;
+
+	// samples skipped since the previous entry, rounded to the nearest period to ignore the entry jitter
+	if (monitor->isIntervalValid && monitor->periodCycles)
+	{
+		uint32_t interval = monitor->entryCycles - monitor->prevEntryCycles;
+		uint32_t periods = (interval + (monitor->periodCycles >> 1)) / monitor->periodCycles;
+		if (periods > 1)
+		{
+			monitor->skippedCount += periods - 1;
+			isMissed = true;
+		}
+	}
+
+	if (monitor->budgetCycles && cycles > monitor->budgetCycles)
+	{
+		monitor->overrunCount++;
+		isMissed = true;
+	}
+
+	monitor->runCount++;
+	monitor->lastCycles = cycles;
+	if (cycles > monitor->maxCycles)
+		monitor->maxCycles = cycles;
+
+	if (!isMissed)
+	{
+		monitor->consecutiveMisses = 0;
+		return;
+	}
+	if (monitor->consecutiveMisses < UINT16_MAX)
+		monitor->consecutiveMisses++;
+	if (monitor->consecutiveMisses > monitor->maxConsecutiveMisses)
+		monitor->maxConsecutiveMisses = monitor->consecutiveMisses;
+
+	// move to the safe state only once
+	if (monitor->tripCount && !monitor->isTripped && monitor->consecutiveMisses >= monitor->tripCount)
+	{
+		monitor->isTripped = true;
+		if (monitor->safeStatePwmMask)
+			BSP_PWMOut_ForceDisable(monitor->safeStatePwmMask);
+		if (monitor->safeStateCallback)
+			monitor->safeStateCallback();
+#if TRACE_ENABLE
+		Trace_Log(TRACE_EVT_DEADLINE_TRIP, monitor->consecutiveMisses, monitor->overrunCount);
+#endif
+	}
+}
+#endif
+/* EOF */
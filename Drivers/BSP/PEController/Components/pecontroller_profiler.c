@@ -0,0 +1,178 @@
+/**
+ ********************************************************************************
+ * @file    	pecontroller_profiler.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Measures the execution time and jitter of the time critical code sections.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "pecontroller_profiler.h"
+#include "shared_memory.h"
+#if PROFILER_ENABLE
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+
+/********************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/********************************************************************************
+ * Structures
+ *******************************************************************************/
+
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+
+/********************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+#if IS_CONTROL_CORE
+/**
+ * @brief Gets the histogram bin for a time value.
+ * @param cycles Time in cycles.
+ * @return Index of the bin.
+ */
+static inline uint32_t GetHistogramBin(uint32_t cycles)
+{
+	uint32_t bin = cycles == 0 ? 0 : 31 - __CLZ(cycles);
+	return bin >= PROFILER_HISTOGRAM_BINS ? PROFILER_HISTOGRAM_BINS - 1 : bin;
+}
+
+/**
+ * @brief Clears all probes and starts the DWT cycle counter.
+ * @note Called by @ref SharedMemory_Init() in the control core.
+ */
+void Profiler_Init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	memset((void*)&PROFILER_DATA, 0, sizeof(profiler_data_t));
+}
+
+/**
+ * @brief Registers a new probe.
+ * @param name Name of the probe. Should point to a constant string.
+ * @return Pointer to the probe if successful, else <c>NULL</c> if all probes are already in use.
+ */
+profiler_probe_t* Profiler_Register(const char* name)
+{
+	if (PROFILER_DATA.probeCount >= PROFILER_MAX_PROBES)
+		return NULL;
+	profiler_probe_t* probe = (profiler_probe_t*)&PROFILER_DATA.probes[PROFILER_DATA.probeCount];
+	probe->name = name;
+	Profiler_ResetProbe(probe);
+	__DMB();
+	PROFILER_DATA.probeCount++;
+	return probe;
+}
+
+/**
+ * @brief Resets the statistics of a probe while keeping it registered.
+ * @param probe Pointer to the probe.
+ */
+void Profiler_ResetProbe(profiler_probe_t* probe)
+{
+	probe->sequence++;
+	__DMB();
+	probe->count = 0;
+	probe->lastPeriod = 0;
+	probe->minCycles = UINT32_MAX;
+	probe->maxCycles = 0;
+	probe->totalCycles = 0;
+	probe->maxJitter = 0;
+	memset(probe->histogram, 0, sizeof(probe->histogram));
+	memset(probe->jitterHistogram, 0, sizeof(probe->jitterHistogram));
+	__DMB();
+	probe->sequence++;
+}
+
+/**
+ * @brief Records the execution time and start jitter of a probe.
+ * @note Use @ref Profiler_Stop() instead of calling this function directly.
+ * @param probe Pointer to the probe.
+ * @param cycles Execution time in cycles.
+ */
+TCritical void Profiler_Record(profiler_probe_t* probe, uint32_t cycles)
+{
+	probe->sequence++;
+	__DMB();
+
+	/* time between consecutive starts and its change gives the jitter */
+	if (probe->count)
+	{
+		uint32_t period = probe->startCycles - probe->prevStartCycles;
+		if (probe->count > 1)
+		{
+			uint32_t jitter = period > probe->lastPeriod ? period - probe->lastPeriod : probe->lastPeriod - period;
+			probe->jitterHistogram[GetHistogramBin(jitter)]++;
+			if (jitter > probe->maxJitter)
+				probe->maxJitter = jitter;
+		}
+		probe->lastPeriod = period;
+	}
+	probe->prevStartCycles = probe->startCycles;
+
+	probe->count++;
+	probe->totalCycles += cycles;
+	probe->histogram[GetHistogramBin(cycles)]++;
+	if (cycles < probe->minCycles)
+		probe->minCycles = cycles;
+	if (cycles > probe->maxCycles)
+		probe->maxCycles = cycles;
+
+	__DMB();
+	probe->sequence++;
+}
+#endif
+
+/**
+ * @brief Gets a consistent copy of the statistics of a probe.
+ * @details The copy is retried if the probe is updated by the control core while being copied.
+ * @param index Index of the probe (Range 0 to @ref profiler_data_t.probeCount - 1).
+ * @param copy Pointer to the structure to be filled.
+ * @return <c>true</c> if successful, else <c>false</c> if the probe is not registered.
+ */
+bool Profiler_ReadProbe(uint32_t index, profiler_probe_t* copy)
+{
+	if (index >= PROFILER_DATA.probeCount)
+		return false;
+	volatile profiler_probe_t* probe = &PROFILER_DATA.probes[index];
+	uint32_t sequence;
+	do
+	{
+		sequence = probe->sequence;
+		__DMB();
+		memcpy(copy, (void*)probe, sizeof(profiler_probe_t));
+		__DMB();
+	} while ((sequence & 1U) || sequence != probe->sequence);
+	return true;
+}
+#endif
+/* EOF */
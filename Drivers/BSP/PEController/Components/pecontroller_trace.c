@@ -0,0 +1,233 @@
+/**
+ ********************************************************************************
+ * @file    	pecontroller_trace.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Records the time stamped system events in fixed size binary trace rings.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "pecontroller_trace.h"
+#include "shared_memory.h"
+#include "utility_lib.h"
+#if TRACE_ENABLE
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+/**
+ * @brief Size of the text buffer used by @ref Trace_Format().
+ */
+#define TRACE_TEXT_SIZE				(64)
+/********************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/********************************************************************************
+ * Structures
+ *******************************************************************************/
+
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+/**
+ * @brief Names of the system events in the order of @ref trace_event_t.
+ */
+static const char* eventNames[] = { "Relay", "PLL", "Mode", "Fault", "Deadline", "Benchmark" };
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+
+/********************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+/**
+ * @brief Clears the ring of the current core and starts the DWT cycle counter.
+ * @note Called by @ref SharedMemory_Init() in both cores before the clock configuration, so the frequency of the
+ * time stamps is only saved by @ref Trace_Log().
+ */
+void Trace_Init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	volatile trace_ring_t* ring = &TRACE_DATA.rings[TRACE_LOCAL_RING];
+	memset((void*)ring, 0, sizeof(trace_ring_t));
+}
+
+/**
+ * @brief Logs an event in the ring of the current core.
+ * @details Updates @ref trace_ring_t.clockHz if the core clock has changed since the last event.
+ * @note Can be called from the interrupts.
+ * @param id Event id. Use @ref trace_event_t values.
+ * @param param Small event specific parameter.
+ * @param value Event specific value.
+ */
+TCritical void Trace_Log(uint16_t id, uint16_t param, uint32_t value)
+{
+	volatile trace_ring_t* ring = &TRACE_DATA.rings[TRACE_LOCAL_RING];
+	// the clock is configured after the initialization of the ring
+	if (ring->clockHz != SystemCoreClock)
+		ring->clockHz = SystemCoreClock;
+
+	// reserve the record, only the interrupts of the current core can write to this ring
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	uint32_t index = ring->writeIndex++;
+	__set_PRIMASK(primask);
+
+	// mark the record as incomplete before updating
+	volatile trace_record_t* record = &ring->records[index & (TRACE_RING_SIZE - 1)];
+	record->sequence = index;
+	__DMB();
+	record->timestamp = TRACE_GET_TIMESTAMP();
+	record->id = id;
+	record->param = param;
+	record->value = value;
+	__DMB();
+	record->sequence = index + 1;
+}
+
+/**
+ * @brief Reads the completed records of a ring.
+ * @details Records being written are left for the next read. Records overwritten before being read are
+ * skipped and counted in @ref trace_reader_t.lostCount.
+ * @param ringNo Index of the ring. Use @ref TRACE_RING_CM7 or @ref TRACE_RING_CM4.
+ * @param reader Pointer to the reader state of the ring.
+ * @param records Pointer to the buffer to be filled.
+ * @param maxCount Maximum no of records to be read.
+ * @return No of records read.
+ */
+uint32_t Trace_Read(uint8_t ringNo, trace_reader_t* reader, trace_record_t* records, uint32_t maxCount)
+{
+	if (ringNo >= TRACE_RING_COUNT)
+		return 0;
+	volatile trace_ring_t* ring = &TRACE_DATA.rings[ringNo];
+	uint32_t count = 0;
+
+	while (count < maxCount)
+	{
+		uint32_t writeIndex = ring->writeIndex;
+		__DMB();
+		if (reader->readIndex == writeIndex)
+			break;
+		// skip the records already overwritten
+		if ((writeIndex - reader->readIndex) > TRACE_RING_SIZE)
+		{
+			reader->lostCount += writeIndex - TRACE_RING_SIZE - reader->readIndex;
+			reader->readIndex = writeIndex - TRACE_RING_SIZE;
+		}
+
+		volatile trace_record_t* record = &ring->records[reader->readIndex & (TRACE_RING_SIZE - 1)];
+		uint32_t sequence = record->sequence;
+		__DMB();
+		if (sequence != reader->readIndex + 1)
+		{
+			// a newer record means the writer has lapped the reader, else the record is still incomplete
+			if ((int32_t)(sequence - (reader->readIndex + 1)) > 0)
+			{
+				reader->lostCount++;
+				reader->readIndex++;
+				continue;
+			}
+			break;
+		}
+		memcpy(&records[count], (void*)record, sizeof(trace_record_t));
+		__DMB();
+		// overwritten while copying
+		if (record->sequence != sequence)
+		{
+			reader->lostCount++;
+			reader->readIndex++;
+			continue;
+		}
+		reader->readIndex++;
+		count++;
+	}
+	return count;
+}
+
+/**
+ * @brief Converts a record to text for display or export.
+ * @details The format is <b>time_us,ring,event,param,value</b> with the time in micro seconds.
+ * @param ringNo Index of the ring containing the record.
+ * @param record Pointer to the record.
+ * @param text Pointer to the text buffer.
+ * @param len Size of the text buffer.
+ * @return No of characters written excluding the null character.
+ */
+int Trace_Format(uint8_t ringNo, const trace_record_t* record, char* text, size_t len)
+{
+	if (len == 0 || ringNo >= TRACE_RING_COUNT)
+		return 0;
+	char buff[TRACE_TEXT_SIZE];
+	char* txt = buff;
+	uint32_t clockHz = TRACE_DATA.rings[ringNo].clockHz;
+	uint32_t timeUs = clockHz == 0 ? 0 : (uint32_t)(((uint64_t)record->timestamp * 1000000U) / clockHz);
+
+	txt += utoa_custom(timeUs, txt);
+	*txt++ = ',';
+	txt += utoa_custom(ringNo, txt);
+	*txt++ = ',';
+	if (record->id < (sizeof(eventNames) / sizeof(eventNames[0])))
+	{
+		strcpy(txt, eventNames[record->id]);
+		txt += strlen(txt);
+	}
+	else
+		txt += utoa_custom(record->id, txt);
+	*txt++ = ',';
+	txt += utoa_custom(record->param, txt);
+	*txt++ = ',';
+	txt += utoa_custom(record->value, txt);
+
+	int textLen = txt - buff;
+	if ((size_t)textLen >= len)
+		textLen = len - 1;
+	memcpy(text, buff, textLen);
+	text[textLen] = 0;
+	return textLen;
+}
+
+#if TRACE_ENABLE_BENCHMARK
+/**
+ * @brief Measures the cost of logging an event by logging consecutive @ref TRACE_EVT_BENCHMARK events.
+ * @details Can be run in both cores at the same time to measure the cost with two writers.
+ * The results are stored in @ref trace_ring_t.benchmarkEvents and @ref trace_ring_t.benchmarkCycles.
+ * @param eventCount No of events to be logged.
+ * @return Average cycles per event.
+ */
+float Trace_RunBenchmark(uint32_t eventCount)
+{
+	volatile trace_ring_t* ring = &TRACE_DATA.rings[TRACE_LOCAL_RING];
+
+	uint32_t startCycles = DWT->CYCCNT;
+	for (uint32_t i = 0; i < eventCount; i++)
+		Trace_Log(TRACE_EVT_BENCHMARK, 0, i);
+	uint32_t cycles = DWT->CYCCNT - startCycles;
+
+	ring->benchmarkEvents = eventCount;
+	ring->benchmarkCycles = cycles;
+	return eventCount == 0 ? 0 : (float)cycles / eventCount;
+}
+#endif
+#endif
+/* EOF */
@@ -104,6 +104,7 @@ typedef struct
 	float freq[TOTAL_MEASUREMENT_COUNT];				/**< @brief Signal frequencies of each ADC channel, used to compute the statistics of each channel.*/
 	stats_data_t stats[TOTAL_MEASUREMENT_COUNT];		/**< @brief Signal statistics of each ADC channel.*/
 	float fs;											/**< @brief Current sampling rate of the ADC */
+	volatile uint32_t calibrationVersion;				/**< @brief Incremented after each update of the offsets or sensitivities */
 } adc_info_t;
 /**
  * @brief Contains the stored raw/unconverted ADC results.
@@ -42,6 +42,7 @@ extern "C" {
  * 	-# <b>@ref BSP_MAX11046_Run() :</b> Performs the conversion.
  * 	-# <b>@ref BSP_MAX11046_Stop() :</b> Stops the ADC data collection module, only effective for ADC_MODE_CONT.
  * 	-# <b>@ref BSP_MAX11046_SetInputOutputTrigger() :</b> Sets the input and output trigger functions for the ADC.
+ * 	-# <b>@ref BSP_MAX11046_GetDeadlineMonitor() :</b> Gets the deadline monitor of the conversion and the control loop.
  * @{
  */
 /********************************************************************************
@@ -50,6 +51,7 @@ extern "C" {
 #include "general_header.h"
 #if MAX11046_ENABLE && IS_ADC_CORE
 #include "pecontroller_adc.h"
+#include "pecontroller_deadline.h"
 /********************************************************************************
  * Defines
  *******************************************************************************/
@@ -106,6 +108,15 @@ extern void BSP_MAX11046_DeInit(void);
  * @return timer_trigger_src_t Trigger source if configuration required as master else returns NULL.
  */
 extern timer_trigger_src_t BSP_MAX11046_SetInputOutputTrigger(tim_in_trigger_config_t* _slaveConfig, tim_out_trigger_config_t* _masterConfig, float _fs);
+#if DEADLINE_MONITOR_ENABLE && IS_CONTROL_CORE
+/**
+ * @brief Gets the deadline monitor of the conversion and the control loop.
+ * @details The sampling period of the monitor is updated with the sampling frequency of the ADC.
+ * Set the safe state configuration of the monitor after initializing the ADC.
+ * @return Pointer to the deadline monitor.
+ */
+extern deadline_monitor_t* BSP_MAX11046_GetDeadlineMonitor(void);
+#endif
 /********************************************************************************
  * Code
  *******************************************************************************/
@@ -52,7 +52,39 @@ extern "C" {
 /*******************************************************************************
  * Defines
  ******************************************************************************/
-
+/** @addtogroup P2PComms_Exported_Macros
+ * @{
+ */
+#ifndef P2P_COMMS_ENABLE_BENCHMARK
+/**
+ * @brief Set to 1 to collect the latency and throughput statistics of the inter-processor messages.
+ * @details The statistics are kept in @ref p2p_msg_data_t.stats so both cores can read them.
+ * Call @ref P2PComms_ResetStats() from the communication core before collecting the statistics.
+ * The value can be overridden in p2p_comms_app.h.
+ */
+#define P2P_COMMS_ENABLE_BENCHMARK			(0)
+#endif
+/**
+ * @brief No of bins in the round trip latency histogram @ref p2p_comms_stats_t.histogram.
+ */
+#define P2P_COMMS_LATENCY_BINS				(24)
+/**
+ * @brief No of message sizes and batch sizes tested by @ref P2PComms_RunBenchmarkSweep().
+ */
+#define P2P_COMMS_SWEEP_COUNT				(4)
+/**
+ * @brief Hardware semaphore used by the control core to notify the communication core when a response is ready.
+ * @note Make sure this semaphore is not used by any other module.
+ */
+#define P2P_COMMS_HSEM_ID					(1U)
+/**
+ * @brief Interrupt priority of the response notification in the communication core.
+ * Should be lower than or equal to (numerically greater) configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+#define P2P_COMMS_HSEM_IRQ_PRIORITY			(6)
+/**
+ * @}
+ */
 /*******************************************************************************
  * Typedefs
  ******************************************************************************/
@@ -75,6 +107,7 @@ typedef enum
 	MSG_SET_BITS,     /**< Message to set bits in a register */
 	MSG_CLR_BITS,     /**< Message to clear bits in a register */
 	MSG_TOGGLE_BITS,  /**< Message to toggle bits in a register */
+	MSG_ECHO,         /**< Message without any action. Used to measure the messaging round trip */
 	MSG_GET_BOOL = 30,/**< Message to get boolean parameter value */
 	MSG_GET_U8,       /**< Message to get uint8_t parameter value */
 	MSG_GET_S8,       /**< Message to get int8_t parameter value */
@@ -130,18 +163,43 @@ typedef struct
 	float floats[P2P_FLOAT_COUNT];				/*!< Contains all shared single precisions variables */
 	uint32_t bitAccess[P2P_BIT_ACCESS_COUNT];	/*!< Contains all shared bit accessible registers */
 } p2p_data_buffs_t;
+#if P2P_COMMS_ENABLE_BENCHMARK
+/**
+ * @brief Defines the latency and throughput statistics of the processor to processor messages.
+ * @note All times are measured in CPU cycles of the communication core.
+ */
+typedef struct
+{
+	uint32_t requestCount;							/*!< No of completed requests */
+	uint32_t minCycles;								/*!< Minimum round trip time */
+	uint32_t maxCycles;								/*!< Maximum round trip time */
+	uint64_t totalCycles;							/*!< Sum of all round trip times. Divide by requestCount to get the mean */
+	uint32_t histogram[P2P_COMMS_LATENCY_BINS];		/*!< Bin n counts the round trips taking 2^n to 2^(n+1)-1 cycles.
+														The last bin also counts all longer round trips */
+	uint32_t maxPendingMsgs;						/*!< Maximum no of messages waiting in the message queue */
+	uint32_t benchmarkMsgs;							/*!< No of messages sent in the last benchmark run */
+	uint64_t benchmarkCycles;						/*!< Total time taken by the last benchmark run */
+	float msgsPerSec;								/*!< Throughput of the last benchmark run */
+	float sweepMsgsPerSec[P2P_COMMS_SWEEP_COUNT][P2P_COMMS_SWEEP_COUNT];	/*!< Throughput of the last sweep as [message size][batch size] */
+} p2p_comms_stats_t;
+#endif
 /**
  * @brief Defines the processor to processor messaging data.
+ * @note The indices of the ring buffers (@ref RING_BUFFER_INDEX_ALIGN) and the buffers written by different
+ * cores start at new cache lines.
  */
 typedef struct
 {
 	p2p_data_buffs_t dataBuffs;							/*!< Shared data buffers for both processors */
-	ring_buffer_t msgsRingBuff;							/*!< Ring buffer keeping message buffer info */
+	ring_buffer_t msgsRingBuff SHARED_REGION_ALIGN;		/*!< Ring buffer keeping message buffer info */
 	ring_buffer_t cmdsRingBuff;							/*!< Ring buffer keeping command buffer info */
 	ring_buffer_t responseRingBuff;						/*!< Ring buffer keeping response buffer info */
-	volatile p2p_msg_t msgs[P2P_COMMS_MSGS_SIZE];		/*!< Message buffer */
-	data_union_t cmds[P2P_COMMS_CMD_BUFF_SIZE];			/*!< Command buffer */
-	data_union_t response[P2P_COMMS_RESPONSE_BUFF_SIZE];/*!< Response buffer */
+	volatile p2p_msg_t msgs[P2P_COMMS_MSGS_SIZE] SHARED_REGION_ALIGN;		/*!< Message buffer */
+	data_union_t cmds[P2P_COMMS_CMD_BUFF_SIZE] SHARED_REGION_ALIGN;			/*!< Command buffer. Written by the communication core */
+	data_union_t response[P2P_COMMS_RESPONSE_BUFF_SIZE] SHARED_REGION_ALIGN;/*!< Response buffer. Written by the control core */
+#if P2P_COMMS_ENABLE_BENCHMARK
+	p2p_comms_stats_t stats SHARED_REGION_ALIGN;		/*!< Messaging statistics */
+#endif
 } p2p_msg_data_t;
 /**
  * @}
@@ -159,6 +217,12 @@ typedef struct
  * correct display of parameters.
  */
 extern data_param_info_t p2pCommsParams[P2P_PARAM_COUNT];
+/**
+ * @brief Indices of @ref p2pCommsParams sorted in ascending order of their names.
+ * @details Used by @ref P2PComms_FindParameterByName() for binary search of parameters by name.
+ * @note Keep this table sorted (ASCII order) whenever a name is added or changed in @ref p2pCommsParams.
+ */
+extern const uint8_t p2pCommsParamsNameIndex[P2P_PARAM_COUNT];
 #endif
 /**
  * @}
@@ -169,6 +233,15 @@ extern data_param_info_t p2pCommsParams[P2P_PARAM_COUNT];
 /** @defgroup P2PComms_Exported_Functions Functions
  * @{
  */
+/**
+ * @brief Get the location of a register in the shared data buffers.
+ * @details The returned pointer can be used to directly read the binary value of the register
+ * without any intermediate copies or text conversions. Cast it to the pointer of the relevant type.
+ * @param type Data type of the register.
+ * @param index Register index.
+ * @return Pointer to the register if valid else <c>NULL</c>.
+ */
+extern volatile void* P2PComms_GetRegisterPtr(base_data_type_t type, uint8_t index);
 #if IS_COMMS_CORE
 /**
  * @brief Update a parameter in control.
@@ -180,6 +253,19 @@ extern data_param_info_t p2pCommsParams[P2P_PARAM_COUNT];
  * @return device_err_t If successful <c>ERR_OK</c> else some other error.
  */
 extern device_err_t P2PComms_SingleUpdateRequest_Blocking(p2p_msg_type_t type, uint8_t index, data_union_t value);
+/**
+ * @brief Enable the response notifications from the control core.
+ * @details Once enabled the tasks waiting in @ref P2PComms_SingleUpdateRequest_Blocking() are woken up by the
+ * hardware semaphore interrupt as soon as the response is ready, instead of polling at each RTOS tick.
+ * @note Call this function after the RTOS kernel is initialized. If not called the responses are polled.
+ */
+extern void P2PComms_InitNotifications(void);
+/**
+ * @brief Wait till the control core responds to a message.
+ * @note A weak implementation of this function is provided. User can create a custom implementation if needed.
+ * @param msg Message waiting for the response.
+ */
+extern void P2PComms_WaitForResponse(volatile p2p_msg_t* msg);
 /**
  * @brief Validates that the parameter is valid.
  * @note A weak implementation of this function is provided. User can create a custom implementation if needed.
@@ -203,6 +289,34 @@ extern device_err_t P2PComms_GetValue(data_param_info_t* _paramInfo, data_union_
  * @return device_err_t If successful <c>ERR_OK</c> else some other error.
  */
 extern device_err_t P2PComms_UpdateValue(data_param_info_t* _paramInfo, data_union_t value);
+/**
+ * @brief Get the binary value of a parameter shared in both cores.
+ * @details The value is read directly from the shared data buffers. No text conversion is involved,
+ * so use this function instead of @ref P2PComms_GetStringValue() when the value is not meant for display.
+ * @param id Parameter identifier in @ref p2pCommsParams.
+ * @param value Writes the acquired value at this pointer location.
+ * @return device_err_t If successful <c>ERR_OK</c> else some other error.
+ */
+extern device_err_t P2PComms_GetValueById(p2p_params_type_t id, data_union_t* value);
+/**
+ * @brief Update the binary value of a parameter shared in both cores.
+ * @details The value is delivered to the control core as is. No text conversion is involved,
+ * so use this function instead of @ref P2PComms_UpdateFromString() when the value is not coming from user text.
+ * @note This is a blocking call and will return only after request is completed.
+ * @param id Parameter identifier in @ref p2pCommsParams.
+ * @param value Value to be updated.
+ * @return device_err_t If successful <c>ERR_OK</c> else some other error.
+ */
+extern device_err_t P2PComms_UpdateValueById(p2p_params_type_t id, data_union_t value);
+/**
+ * @brief Find a parameter in @ref p2pCommsParams by its name.
+ * @details Performs a binary search over @ref p2pCommsParamsNameIndex, so the lookup
+ * takes O(log N) string comparisons. If multiple parameters share the same name any one of them may be returned.
+ * @param name Name of the parameter.
+ * @param id Writes the identifier of the parameter at this pointer location.
+ * @return device_err_t If successful <c>ERR_OK</c> else some other error.
+ */
+extern device_err_t P2PComms_FindParameterByName(const char* name, p2p_params_type_t* id);
 /**
  * @brief Update the value of a parameter (shared between both processors) from a string value.
  * @note A weak implementation of this function is provided. User can create a custom implementation if needed.
@@ -220,6 +334,39 @@ extern device_err_t P2PComms_UpdateFromString(data_param_info_t* _paramInfo, con
  * @return device_err_t If successful <c>ERR_OK</c> else some other error.
  */
 extern device_err_t P2PComms_GetStringValue(data_param_info_t* _paramInfo, char* value, bool addUnit);
+/**
+ * @brief Checks if the parameters without @ref data_param_info_t.Getter_InText are converted to text by the
+ * weak implementations of @ref Default_GetDataParameter_InText() and @ref P2PComms_GetStringValue().
+ * @details The display uses it to decide if such parameters can be formatted in batches with @ref String_FormatBatch().
+ * @return <c>true</c> if the weak implementations are in effect else <c>false</c>.
+ */
+extern bool P2PComms_IsDefaultTextFormat(void);
+#if P2P_COMMS_ENABLE_BENCHMARK
+/**
+ * @brief Reset the messaging statistics in @ref p2p_msg_data_t.stats and start the DWT cycle counter.
+ */
+extern void P2PComms_ResetStats(void);
+/**
+ * @brief Measure the messaging throughput by sending @ref MSG_ECHO messages to the control core.
+ * @details The messages are placed in batches and the next batch is placed once the complete batch is
+ * responded, so the result also includes the response time of the control core. The round trip of each
+ * batch is recorded as a single request. The results are stored in @ref p2p_msg_data_t.stats.
+ * @note This is a blocking call and will return only after all messages are processed.
+ * @note The buffer sizes are compile time settings in p2p_comms_app.h, so rebuild to compare different buffer sizes.
+ * @param msgCount No of messages to be sent.
+ * @param msgSize No of data words in the command buffer for each message. The batch uses at most half of the command buffer.
+ * @param batchSize No of messages placed together. Limited to half of the message queue.
+ * @return Throughput in messages per second.
+ */
+extern float P2PComms_RunBenchmark(uint32_t msgCount, uint16_t msgSize, uint16_t batchSize);
+/**
+ * @brief Run @ref P2PComms_RunBenchmark() for message sizes of 1, 4, 16 and 64 words with batch sizes of 1, 4, 16 and 32 messages.
+ * @details The throughput of each combination is stored in @ref p2p_comms_stats_t.sweepMsgsPerSec.
+ * @note This is a blocking call and will return only after all messages are processed.
+ * @param msgCount No of messages to be sent for each combination.
+ */
+extern void P2PComms_RunBenchmarkSweep(uint32_t msgCount);
+#endif
 #endif
 #if IS_CONTROL_CORE
 /**
@@ -310,6 +457,11 @@ extern device_err_t P2PComms_ClearBits(uint8_t index, uint8_t value);
  * @return device_err_t If successful <c>ERR_OK</c> else some other error.
  */
 extern device_err_t P2PComms_ToggleBits(uint8_t index, uint8_t value);
+/**
+ * @brief Notify the communication core that a response is ready.
+ * @note A weak implementation of this function is provided. User can create a custom implementation if needed.
+ */
+extern void P2PComms_NotifyResponse(void);
 /**
  * @brief Process the pending request for interprocessor communications.
  * @note Call this function frequently to make sure that interprocessor communications work flawlessly.
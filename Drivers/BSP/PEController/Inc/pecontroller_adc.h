@@ -53,6 +53,11 @@ extern "C" {
 #define LOCAL_ADC_STORAGE_COUNT				(32)
 #endif
 #define EN_DMA_ADC_DATA_COLLECTION			(IS_DMA_ADC_DATA_COLLECTION_SUPERIOR)
+/**
+ * @brief Checks the raw ADC samples against the protection limits in the conversion interrupt.
+ * @details Only available if the ADC conversions and the PWM are handled by the same core.
+ */
+#define ADC_FAST_PROTECTION					(IS_ADC_CORE && IS_CONTROL_CORE)
 /********************************************************************************
  * Typedefs
  *******************************************************************************/
@@ -72,6 +77,11 @@ typedef enum _adc_acq_mode_
  * @param *result Pointer to the most recent ADC results
  */
 typedef void (*adcMeauresDataCallback)(adc_measures_t* result);
+/**
+ * @brief Callback for the ADC protection trip
+ * @param tripMask Channels exceeding the limits. Bit n for channel n + 1
+ */
+typedef void (*adcProtectionCallback)(uint16_t tripMask);
 /**
  * @}
  */
@@ -89,6 +99,22 @@ typedef struct
 	float fs;							/**< @brief Sampling Frequency for the ADC */
 	adcMeauresDataCallback callback;	/**< @brief Callback function called when results are ready */
 } adc_cont_config_t;
+/**
+ * @brief Defines the fast protection of the ADC channels
+ * @details The limits are converted to raw ADC values, so that each sample is checked in the conversion
+ * interrupt before the user callback. Set a limit beyond the measurement range to disable one side.
+ */
+typedef struct
+{
+	uint16_t channelMask;							/**< @brief Channels to be protected. Bit n for channel n + 1 */
+	uint16_t debounceCount;							/**< @brief No of consecutive samples beyond the limits before tripping.
+														0 or 1 trips on the first sample */
+	uint32_t pwmMask;								/**< @brief PWM outputs disabled on trip */
+	float min[TOTAL_MEASUREMENT_COUNT];				/**< @brief Minimum allowed value of each channel in measurement units */
+	float max[TOTAL_MEASUREMENT_COUNT];				/**< @brief Maximum allowed value of each channel in measurement units */
+	adcProtectionCallback callback;					/**< @brief Called from the interrupt after disabling the PWM outputs.
+														Set to <c>NULL</c> if not required */
+} adc_protection_config_t;
 
 /**
  * @}
@@ -143,6 +169,7 @@ extern ring_buffer_t adcLocalIndexRingBuff;
 extern void BSP_ADC_SetDefaultParams(adc_processed_data_t* _processedAdcData, adc_raw_data_t* _rawAdcData);
 /**
  * @brief Updates the data parameters and data sharing items.
+ * @details The conversion parameters are only updated once the offsets or sensitivities are changed.
  * @note Should be called frequently to avoid data missing.
  */
 extern void BSP_ADC_RefreshData(void);
@@ -181,6 +208,30 @@ extern void BSP_ADC_DeInit(void);
  */
 extern timer_trigger_src_t BSP_ADC_SetInputOutputTrigger(tim_in_trigger_config_t* _slaveConfig, tim_out_trigger_config_t* _masterConfig, float _fs);
 #endif
+#if ADC_FAST_PROTECTION
+/**
+ * @brief Configures the fast protection of the ADC channels and rearms it.
+ * @details The raw limits are updated in @ref BSP_ADC_RefreshData() once the sensitivities or offsets are changed.
+ * @param _config Pointer to the protection configuration. Send NULL to disable the protection.
+ */
+extern void BSP_ADC_ConfigProtection(const adc_protection_config_t* _config);
+/**
+ * @brief Rearms the fast protection after a trip.
+ * @note The disabled PWM outputs are not enabled again.
+ */
+extern void BSP_ADC_ResetProtection(void);
+/**
+ * @brief Gets the channels which tripped the fast protection.
+ * @return Channels exceeding the limits. Bit n for channel n + 1. 0 if not tripped.
+ */
+extern uint16_t BSP_ADC_GetProtectionTrip(void);
+/**
+ * @brief Checks the raw samples against the protection limits and disables the PWM outputs on trip.
+ * @note Called by the ADC driver in the conversion interrupt.
+ * @param _rawData Pointer to the raw samples of all channels.
+ */
+extern void BSP_ADC_CheckProtection(const uint16_t* _rawData);
+#endif
 #if IS_COMMS_CORE
 
 /**
@@ -116,6 +116,21 @@ extern "C" {
 /*********** Device Constants **************/
 
 #define TCritical						__attribute__((section (".tCritical")))
+/**
+ * @brief Alignment of the data shared between both cores. Equal to the cache line size of the CM7 core,
+ * so the data written by different cores never shares a cache line.
+ */
+#define SHARED_MEMORY_ALIGNMENT			(32)
+/**
+ * @brief Aligns a shared memory region, or a shared field written by a different core than the preceding
+ * fields, according to @ref SHARED_MEMORY_ALIGNMENT.
+ */
+#define SHARED_REGION_ALIGN				__attribute__((aligned (SHARED_MEMORY_ALIGNMENT)))
+/**
+ * @brief Alignment of the indices of the ring buffers. The inter-core ring buffers are written by one core
+ * and read by the other, so each index gets its own cache line.
+ */
+#define RING_BUFFER_INDEX_ALIGN			SHARED_REGION_ALIGN
 
 // Inputs
 /**
@@ -172,6 +187,14 @@ extern "C" {
 #define PROFILE_GPIO_PORT				(GPIOB)
 #define PROFILE_GPIO_Pin				GPIO_PIN_2
 #endif
+/**
+ * @brief Monitors the execution time of the control interrupt against the sampling period.
+ */
+#define ENABLE_DEADLINE_MONITOR			(1)
+/**
+ * @brief Records the system events in the trace rings of the shared memory.
+ */
+#define ENABLE_TRACE					(1)
 /************** Debugging *****************/
 
 /************** HELPERS *******************/
@@ -0,0 +1,198 @@
+/**
+ ********************************************************************************
+ * @file 		pecontroller_deadline.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Checks the execution time of the time critical interrupts against their deadlines.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+#ifndef PECONTROLLER_DEADLINE_H
+#define PECONTROLLER_DEADLINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/** @addtogroup BSP
+ * @{
+ */
+
+/** @defgroup Deadline_Monitor Deadline Monitor
+ * @brief Checks the execution time of the time critical interrupts against their deadlines.
+ * @details The monitor time stamps the entry and exit of an interrupt running once every sampling period.
+ * An execution is missed if it takes longer than the budget derived from the sampling frequency, or if
+ * the time since the previous entry shows that one or more samples were skipped. When the configured
+ * no of consecutive misses is reached the monitor trips and moves the system to the safe state by
+ * disabling the selected PWM outputs and calling the safe state callback.
+ * @code
+ * deadline_monitor_t* monitor = BSP_MAX11046_GetDeadlineMonitor();
+ * // trip after 3 consecutive misses and disable the outputs of PWM1-6
+ * monitor->tripCount = 3;
+ * monitor->safeStatePwmMask = 0x3f;
+ * @endcode
+ * @{
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "general_header.h"
+#include "user_config.h"
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+/** @defgroup Deadline_Exported_Macros Macros
+ * @{
+ */
+#ifndef DEADLINE_MONITOR_ENABLE
+/**
+ * @brief Set to 1 to monitor the deadlines of the control interrupt.
+ * @details The value can be overridden in user_config.h.
+ */
+#define DEADLINE_MONITOR_ENABLE			(ENABLE_DEADLINE_MONITOR)
+#endif
+#ifndef DEADLINE_GET_CYCLES
+/**
+ * @brief Gets the current time stamp in cycles.
+ * @details Uses the DWT cycle counter by default. Can be replaced by any free running 32-bit counter
+ * running at SystemCoreClock.
+ */
+#define DEADLINE_GET_CYCLES()			(DWT->CYCCNT)
+#endif
+/**
+ * @}
+ */
+/*******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/** @defgroup Deadline_Exported_Typedefs Type Definitions
+ * @{
+ */
+/**
+ * @brief Defines the function called when the monitor trips.
+ */
+typedef void (*DeadlineSafeStateFnc)(void);
+/**
+ * @}
+ */
+/*******************************************************************************
+ * Structures
+ ******************************************************************************/
+/** @defgroup Deadline_Exported_Structures Structures
+ * @{
+ */
+/**
+ * @brief Defines the deadline monitor of a periodic interrupt.
+ * @note All times are measured in CPU cycles.
+ */
+typedef struct
+{
+	/* Configuration */
+	float budgetRatio;						/*!< Part of the sampling period available for the execution (Range 0-1).
+												Set to 0 to use the complete sampling period */
+	uint16_t tripCount;						/*!< No of consecutive misses moving the system to the safe state.
+												Set to 0 to only count the misses */
+	uint32_t safeStatePwmMask;				/*!< PWM outputs disabled using @ref BSP_PWMOut_ForceDisable() when the monitor trips */
+	DeadlineSafeStateFnc safeStateCallback;	/*!< Called when the monitor trips. Set to <c>NULL</c> if not required */
+	/* Timing */
+	uint32_t periodCycles;					/*!< Sampling period */
+	uint32_t budgetCycles;					/*!< Maximum allowed execution time */
+	/* Status */
+	uint32_t entryCycles;					/*!< Time stamp of the last entry */
+	uint32_t prevEntryCycles;				/*!< Time stamp of the previous entry */
+	bool hasEntry;							/*!< <c>true</c> if an entry has been time stamped at the current sampling period */
+	bool isIntervalValid;					/*!< <c>true</c> if both entries of the last interval were at the current sampling period */
+	uint32_t lastCycles;					/*!< Execution time of the last run */
+	uint32_t maxCycles;						/*!< Maximum execution time */
+	uint32_t runCount;						/*!< No of monitored executions */
+	uint32_t overrunCount;					/*!< No of executions exceeding the budget */
+	uint32_t skippedCount;					/*!< No of samples skipped between consecutive entries */
+	uint16_t consecutiveMisses;				/*!< No of consecutive executions with an overrun or skipped samples */
+	uint16_t maxConsecutiveMisses;			/*!< Maximum no of consecutive misses */
+	bool isTripped;							/*!< <c>true</c> if the safe state action has been taken */
+} deadline_monitor_t;
+/**
+ * @}
+ */
+/*******************************************************************************
+ * Exported Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Global Function Prototypes
+ ******************************************************************************/
+/** @defgroup Deadline_Exported_Functions Functions
+ * @{
+ */
+#if DEADLINE_MONITOR_ENABLE && IS_CONTROL_CORE
+/**
+ * @brief Sets the sampling period and budget of the monitor from the sampling frequency.
+ * @details Starts the DWT cycle counter if not already running. The status of the monitor is kept,
+ * only the interval from the last entry at the previous frequency is not checked for skipped samples.
+ * @param monitor Pointer to the monitor.
+ * @param fs Sampling frequency in Hz.
+ */
+extern void BSP_Deadline_SetFrequency(deadline_monitor_t* monitor, float fs);
+/**
+ * @brief Clears the status of the monitor and rearms the safe state action.
+ * @note The PWM outputs disabled by the safe state action are not enabled again.
+ * @param monitor Pointer to the monitor.
+ */
+extern void BSP_Deadline_Reset(deadline_monitor_t* monitor);
+/**
+ * @brief Checks the execution against the deadline and takes the safe state action if required.
+ * @note Use @ref BSP_Deadline_Exit() instead of calling this function directly.
+ * @param monitor Pointer to the monitor.
+ * @param cycles Execution time in cycles.
+ */
+extern void BSP_Deadline_Record(deadline_monitor_t* monitor, uint32_t cycles);
+#endif
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+#if DEADLINE_MONITOR_ENABLE && IS_CONTROL_CORE
+/**
+ * @brief Marks the entry of the monitored interrupt.
+ * @param monitor Pointer to the monitor.
+ */
+static inline void BSP_Deadline_Enter(deadline_monitor_t* monitor)
+{
+	monitor->isIntervalValid = monitor->hasEntry;
+	monitor->hasEntry = true;
+	monitor->prevEntryCycles = monitor->entryCycles;
+	monitor->entryCycles = DEADLINE_GET_CYCLES();
+}
+/**
+ * @brief Marks the exit of the monitored interrupt and checks the deadline.
+ * @param monitor Pointer to the monitor.
+ */
+static inline void BSP_Deadline_Exit(deadline_monitor_t* monitor)
+{
+	BSP_Deadline_Record(monitor, DEADLINE_GET_CYCLES() - monitor->entryCycles);
+}
+#endif
+/**
+ * @}
+ */
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+/**
+ * @}
+ */
+#endif
+/* EOF */
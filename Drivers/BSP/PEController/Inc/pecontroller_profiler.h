@@ -0,0 +1,203 @@
+/**
+ ********************************************************************************
+ * @file 		pecontroller_profiler.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Measures the execution time and jitter of the time critical code sections.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+#ifndef PECONTROLLER_PROFILER_H
+#define PECONTROLLER_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/** @addtogroup BSP
+ * @{
+ */
+
+/** @defgroup Profiler Profiler
+ * @brief Measures the execution time and jitter of the time critical code sections.
+ * @details Each code section is measured by a named probe registered with @ref Profiler_Register().
+ * Place @ref Profiler_Start() and @ref Profiler_Stop() around the code section to be measured.
+ * The statistics of each probe are kept in the shared memory, so that they can be read by
+ * both cores. The control core is the only writer, while the other core can get a consistent
+ * copy of a probe at any time using @ref Profiler_ReadProbe() without blocking the writer.
+ * @{
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "general_header.h"
+#include "user_config.h"
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+/** @defgroup Profiler_Exported_Macros Macros
+ * @{
+ */
+#ifndef PROFILER_ENABLE
+/**
+ * @brief Set to 1 to collect the statistics of the registered probes.
+ * @details The value can be overridden in user_config.h.
+ */
+#define PROFILER_ENABLE					(ENABLE_PROFILING)
+#endif
+/**
+ * @brief Maximum no of probes which can be registered.
+ */
+#define PROFILER_MAX_PROBES				(8)
+/**
+ * @brief No of bins in the execution time and jitter histograms of each probe.
+ */
+#define PROFILER_HISTOGRAM_BINS			(16)
+#ifndef PROFILER_GET_CYCLES
+/**
+ * @brief Gets the current time stamp in cycles.
+ * @details Uses the DWT cycle counter by default. Can be replaced by any free running 32-bit counter,
+ * such as a monotonic clock when the module is compiled for the host machine.
+ */
+#define PROFILER_GET_CYCLES()			(DWT->CYCCNT)
+#endif
+/**
+ * @}
+ */
+/*******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Structures
+ ******************************************************************************/
+/** @defgroup Profiler_Exported_Structures Structures
+ * @{
+ */
+/**
+ * @brief Defines the statistics of a single probe.
+ * @note All times are measured in CPU cycles of the control core.
+ */
+typedef struct
+{
+	const char* name;								/*!< Name of the probe. Should point to a constant string */
+	uint32_t sequence;								/*!< Incremented before and after each update.
+														An odd value shows that the statistics are being updated */
+	uint32_t startCycles;							/*!< Time stamp of the last start of the probe */
+	uint32_t prevStartCycles;						/*!< Time stamp of the start of the previous measurement */
+	uint32_t lastPeriod;							/*!< Time between the last two starts of the probe */
+	uint32_t count;									/*!< No of completed measurements */
+	uint32_t minCycles;								/*!< Minimum execution time */
+	uint32_t maxCycles;								/*!< Maximum execution time */
+	uint64_t totalCycles;							/*!< Sum of all execution times. Divide by count to get the mean */
+	uint32_t maxJitter;								/*!< Maximum change in the time between consecutive starts */
+	uint32_t histogram[PROFILER_HISTOGRAM_BINS];	/*!< Bin n counts the executions taking 2^n to 2^(n+1)-1 cycles.
+														The last bin also counts all longer executions */
+	uint32_t jitterHistogram[PROFILER_HISTOGRAM_BINS];/*!< Bin n counts the start jitters of 2^n to 2^(n+1)-1 cycles.
+														The last bin also counts all larger jitters */
+} profiler_probe_t;
+/**
+ * @brief Defines the profiling data shared between both cores.
+ */
+typedef struct
+{
+	uint32_t probeCount;							/*!< No of registered probes */
+	profiler_probe_t probes[PROFILER_MAX_PROBES];	/*!< Statistics of the registered probes */
+} profiler_data_t;
+/**
+ * @}
+ */
+/*******************************************************************************
+ * Exported Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Global Function Prototypes
+ ******************************************************************************/
+/** @defgroup Profiler_Exported_Functions Functions
+ * @{
+ */
+#if PROFILER_ENABLE
+#if IS_CONTROL_CORE
+/**
+ * @brief Clears all probes and starts the DWT cycle counter.
+ * @note Called by @ref SharedMemory_Init() in the control core.
+ */
+extern void Profiler_Init(void);
+/**
+ * @brief Registers a new probe.
+ * @param name Name of the probe. Should point to a constant string.
+ * @return Pointer to the probe if successful, else <c>NULL</c> if all probes are already in use.
+ */
+extern profiler_probe_t* Profiler_Register(const char* name);
+/**
+ * @brief Resets the statistics of a probe while keeping it registered.
+ * @param probe Pointer to the probe.
+ */
+extern void Profiler_ResetProbe(profiler_probe_t* probe);
+/**
+ * @brief Records the execution time and start jitter of a probe.
+ * @note Use @ref Profiler_Stop() instead of calling this function directly.
+ * @param probe Pointer to the probe.
+ * @param cycles Execution time in cycles.
+ */
+extern void Profiler_Record(profiler_probe_t* probe, uint32_t cycles);
+#endif
+/**
+ * @brief Gets a consistent copy of the statistics of a probe.
+ * @details The copy is retried if the probe is updated by the control core while being copied.
+ * @param index Index of the probe (Range 0 to @ref profiler_data_t.probeCount - 1).
+ * @param copy Pointer to the structure to be filled.
+ * @return <c>true</c> if successful, else <c>false</c> if the probe is not registered.
+ */
+extern bool Profiler_ReadProbe(uint32_t index, profiler_probe_t* copy);
+#endif
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+#if PROFILER_ENABLE && IS_CONTROL_CORE
+/**
+ * @brief Marks the start of the code section measured by a probe.
+ * @param probe Pointer to the probe. Ignored if <c>NULL</c>.
+ */
+static inline void Profiler_Start(profiler_probe_t* probe)
+{
+	if (probe)
+		probe->startCycles = PROFILER_GET_CYCLES();
+}
+/**
+ * @brief Marks the end of the code section measured by a probe and records the statistics.
+ * @param probe Pointer to the probe. Ignored if <c>NULL</c>.
+ */
+static inline void Profiler_Stop(profiler_probe_t* probe)
+{
+	uint32_t now = PROFILER_GET_CYCLES();
+	if (probe)
+		Profiler_Record(probe, now - probe->startCycles);
+}
+#endif
+/**
+ * @}
+ */
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+/**
+ * @}
+ */
+#endif
+/* EOF */
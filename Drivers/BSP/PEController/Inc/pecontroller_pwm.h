@@ -65,6 +65,7 @@ extern "C" {
  * 		-# <b>BSP_PWM_Start:</b> Starts the PWM on required PWM pins
  * 		-# <b>BSP_PWM_Stop:</b> Stops the PWM on required PWM pins
  * 		-# <b>BSP_PWMOut_Enable:</b> Enable / disable the output for required PWM channels
+ * 		-# <b>BSP_PWMOut_ForceDisable:</b> Disable the output for required PWM channels from the interrupts
  * 		-# <b>BSP_PWM_Config_Interrupt:</b> Enable / Disable interrupt for a PWM channel as per requirement<br>
  * @{
  */
@@ -72,6 +73,7 @@ extern "C" {
  * Includes
  ******************************************************************************/
 #include "pecontroller_pwm_base.h"
+#include "pecontroller_pwm1_10.h"
 #include "pecontroller_timers.h"
 /*******************************************************************************
  * Defines
@@ -154,6 +156,50 @@ extern float BSP_PWM_UpdatePairDuty(uint32_t pwmNo, float duty, pwm_config_t* co
  * @return float Duty cycle applied in this cycle. May differ from the duty variable if outside permitted limits
  */
 extern float BSP_PWM_UpdateChannelDuty(uint32_t pwmNo, float duty, pwm_config_t* config);
+/**
+ * @brief Holds back the transfer of the preloaded registers to the active registers for the
+ * timers driving the required PWM channels. The duty cycles written after this call take effect
+ * together once @ref BSP_PWM_ReleaseUpdates() is called.
+ * @note Keep the hold window short. If a PWM period boundary occurs while the updates are held,
+ * the previous values are retained for one more period. For PWM11-16 the TIM1 update interrupt is
+ * not generated for such a period.
+ * @param pwmMask PWM channels whose updates need to be held.<br>
+ * 				<b>Valid Range</b> =  (0x0001 - 0xffff)
+ * @param masterHRTIM <c>true</c> if the master HRTIM updates should also be held else <c>false</c>
+ */
+extern void BSP_PWM_HoldUpdates(uint32_t pwmMask, bool masterHRTIM);
+/**
+ * @brief Releases the updates held by @ref BSP_PWM_HoldUpdates(). All values written in the
+ * meantime are transferred to the active registers at the next PWM period boundary.
+ * @param pwmMask PWM channels whose updates need to be released.<br>
+ * 				<b>Valid Range</b> =  (0x0001 - 0xffff)
+ * @param masterHRTIM <c>true</c> if the master HRTIM updates should also be released else <c>false</c>
+ */
+extern void BSP_PWM_ReleaseUpdates(uint32_t pwmMask, bool masterHRTIM);
+/**
+ * @brief Update the duty cycles of multiple inverted pairs so that all of them are applied
+ * in the same PWM period
+ * @details The pairs at PWM1-10 are updated using the caller's duty handle, so the duty cycle limits and the
+ * dead time compensation are not evaluated again in each call. The handle is moved to the timer of each pair,
+ * so the configuration should be shared by all pairs.
+ * @code
+ * // Create the handle once after the configuration
+ * static pwm1_10_duty_handle_t pairsHandle;
+ * BSP_PWM1_10_CreateDutyHandle(1, &pwmConfig, true, &pairsHandle);
+ * // Update the pairs at PWM1-2, PWM3-4 and PWM11-12 in one go
+ * float duties[3] = { 0.2f, 0.5f, 0.8f };
+ * BSP_PWM_UpdatePairDuties(0x405, duties, &pairsHandle, &pwmConfig);
+ * @endcode
+ * @param pwmMask Reference channels of the pairs to be updated.<br>
+ * 				<b>Valid Range</b> =  (0x0001 - 0xffff)
+ * @param duties Duty cycles to be applied. One entry for each bit set in pwmMask
+ * 				starting from the lowest channel (Range 0-1 or given in the config parameter)
+ * @param handle Handle created by @ref BSP_PWM1_10_CreateDutyHandle() for one of the pairs at PWM1-10.
+ * 				May be NULL if pwmMask only contains pairs at PWM11-16
+ * @param *config Pointer to a  pwm_config_t structure that contains the configuration
+ * 				   parameters for the PWM pairs at PWM11-16
+ */
+extern void BSP_PWM_UpdatePairDuties(uint32_t pwmMask, const float* duties, pwm1_10_duty_handle_t* handle, pwm_config_t* config);
 
 /**
  * @brief Enable / Disable interrupt for a PWM channel as per requirement
@@ -232,6 +278,17 @@ extern void BSP_PWM_GetDefaultConfig(pwm_config_t* pwmConfig, pwm_module_config_
  * @param en <c>true</c> if needs to be enabled else <c>false</c>
  */
 extern void BSP_PWMOut_Enable(uint32_t pwmMask, bool en);
+/**
+ * @brief Disables the output for required PWM channels by writing the timer registers directly.
+ * @details Unlike @ref BSP_PWMOut_Enable() the HAL handles are not locked, so the outputs are disabled even if
+ * the interrupted code is using the same handle. Use this function for the protection in interrupts.
+ * Enable the outputs again using @ref BSP_PWMOut_Enable().
+ * @note @ref BSP_PWMOut_Enable() and @ref BSP_PWM_Stop() update the TIM1 outputs with the interrupts disabled, so an
+ * interrupted read-modify-write of CCER cannot enable the outputs disabled here again.
+ * @param pwmMask Set the PWM channels needed to be disabled.<br>
+ * 				<b>Valid Range</b> =  (0x0001 - 0xffff)
+ */
+extern void BSP_PWMOut_ForceDisable(uint32_t pwmMask);
 /*******************************************************************************
  * Code
  ******************************************************************************/
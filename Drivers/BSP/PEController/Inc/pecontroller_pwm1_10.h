@@ -48,6 +48,15 @@ extern "C" {
  * - <b>Inverted Pair Channels:</b><br>
  * For configuring the channels use @ref BSP_PWM1_10_ConfigInvertedPairs(),
  * whereas for updating the duty cycle of the output PWM use @ref BSP_PWM1_10_UpdatePairDuty().<br>
+ * - <b>Time Critical Updates:</b><br>
+ * Create a @ref pwm1_10_duty_handle_t once after configuration using @ref BSP_PWM1_10_CreateDutyHandle(),
+ * and update the duty cycle in the control loop using @ref BSP_PWM1_10_UpdateDutyFast().<br>
+ * - <b>Interleaved Legs:</b><br>
+ * Up to five configured PWMs can be interleaved with the master HRTIM using @ref BSP_PWM1_10_ConfigInterleaving().
+ * Use @ref BSP_PWM1_10_SetInterleavedFrequency() to change the frequency while keeping the phase shifts.<br>
+ * - <b>Spread Spectrum:</b><br>
+ * Generate a period sequence using @ref BSP_PWM1_10_GenerateSpreadSequence() and call
+ * @ref BSP_PWM1_10_SpreadSpectrumStep() from the reset interrupt of the timer to dither the PWM frequency.<br>
  * @{
  */
 /********************************************************************************
@@ -57,14 +66,93 @@ extern "C" {
 /********************************************************************************
  * Defines
  *******************************************************************************/
+/** @defgroup PWM1_10_Exported_Macros Macros
+  * @{
+  */
+/** Maximum number of legs which can be interleaved with the master HRTIM.
+ * One leg is reset by the master period while the others use the four master compare units */
+#define PWM1_10_MAX_INTERLEAVED_LEGS				(5)
+/** Maximum period of the HRTIM timer units in ticks */
+#define PWM1_10_MAX_PERIOD_TICKS					(0xFFDF)
+/**
+ * @}
+ */
 
 /********************************************************************************
  * Typedefs
  *******************************************************************************/
+/** @defgroup PWM1_10_Exported_Typedefs Type Definitions
+  * @{
+  */
+/**
+ * @brief Defines the profile of the period sequence used for the spread spectrum mode.
+ */
+typedef enum
+{
+	SPREAD_TRIANGULAR,		/**< Period changes linearly from minimum to maximum and back */
+	SPREAD_PSEUDO_RANDOM,	/**< Period is selected from a repeatable pseudo random sequence */
+} pwm_spread_profile_t;
+/**
+ * @}
+ */
 
 /********************************************************************************
  * Structures
  *******************************************************************************/
+/** @defgroup PWM1_10_Exported_Structures Structures
+  * @{
+  */
+/**
+ * @brief Precomputed information for the fast duty cycle update of a PWM pair or channel.
+ * @details Contains the timing parameters and register addresses evaluated once from the @ref pwm_config_t,
+ * so that each update only requires one multiplication, one clamp and the register writes.
+ */
+typedef struct
+{
+	__IO uint32_t* cmpSet;		/**< @brief Compare register setting the output (CMP1xR or CMP3xR) */
+	__IO uint32_t* cmpReset;	/**< @brief Compare register resetting the output (CMP2xR or CMP4xR) */
+	uint32_t timerIdx;			/**< @brief Index of the HRTIM timer unit */
+	uint32_t periodTicks;		/**< @brief Timer period in ticks */
+	float period;				/**< @brief Timer period in ticks as floating point value */
+	int32_t deadTicks;			/**< @brief Ticks added to the on time of center aligned PWM for dead time compensation */
+	uint32_t edgeOffset;		/**< @brief Ticks added to the on time of edge aligned PWM */
+	float max;					/**< @brief Maximum duty cycle */
+	float min;					/**< @brief Minimum duty cycle */
+	bool isCenterAligned;		/**< @brief <c>true</c> if the PWM is center aligned */
+	bool isPair;				/**< @brief <c>true</c> if the handle controls an inverted pair */
+	float duty;					/**< @brief Last duty cycle applied using the handle */
+} pwm1_10_duty_handle_t;
+/**
+ * @brief Defines the configuration of interleaved PWMs synchronized with the master HRTIM.
+ */
+typedef struct
+{
+	uint16_t pwmNos[PWM1_10_MAX_INTERLEAVED_LEGS];	/**< @brief Channel no of the PWM of each leg (Valid Values 1-10).
+														Each leg should use a separate HRTIM timer */
+	float shifts[PWM1_10_MAX_INTERLEAVED_LEGS];		/**< @brief Phase shift of each leg from the master HRTIM period (Range 0-1).
+														Filled by the driver if isEvenlySpaced is <c>true</c> */
+	uint8_t legCount;								/**< @brief No of interleaved legs (Range 1-5) */
+	bool isEvenlySpaced;							/**< @brief <c>true</c> if the legs should be evenly spaced over the period */
+	hrtim_opts_t* masterOpts;						/**< @brief Configuration of the master HRTIM */
+	hrtim_comp_t comps[PWM1_10_MAX_INTERLEAVED_LEGS];	/**< @brief Master compare units assigned to the legs. Filled by the driver */
+	uint8_t resetOnPeriodIndex;						/**< @brief Index of the leg reset by the master period. Filled by the driver */
+} pwm1_10_interleave_config_t;
+/**
+ * @brief Defines the state of the spread spectrum mode for the PWMs of a single HRTIM timer.
+ * @details Every switching cycle the next period from the sequence is loaded in the timer and the
+ * duty cycles of all handles are reapplied, so that the duty cycles are preserved.
+ */
+typedef struct
+{
+	pwm1_10_duty_handle_t** handles;	/**< @brief Duty handles of all PWMs using the timer */
+	uint8_t handleCount;				/**< @brief No of duty handles */
+	const uint16_t* periods;			/**< @brief Precomputed period sequence in ticks */
+	uint16_t length;					/**< @brief Length of the period sequence */
+	uint16_t index;						/**< @brief Index of the next period in the sequence */
+} pwm1_10_spread_spectrum_t;
+/**
+ * @}
+ */
 
 /********************************************************************************
  * Exported Variables
@@ -137,9 +225,126 @@ extern void BSP_PWM1_10_Config_Interrupt(uint32_t pwmNo, bool enable, PWMResetCa
  * @param en <c>true</c> if needs activation, else false
  */
 extern void PWM1_10_ActivateInvertedPair(uint32_t pwmNo, bool en);
+/**
+ * @brief Creates the precomputed handle for the fast duty cycle update of a PWM pair or channel.
+ * @note Call after configuring the PWM. Call @ref BSP_PWM1_10_RefreshDutyHandle() if the timer period changes,
+ * and recreate the handle if the other configurations change.
+ * @param pwmNo Channel no of the PWM channel or the reference channel of the PWM pair (Valid Values 1-10).
+ * @param *config Pointer to a  pwm_config_t structure that contains the configuration
+ * 				   parameters for the PWM
+ * @param isPair <c>true</c> if configured using @ref BSP_PWM1_10_ConfigInvertedPairs(), <c>false</c> if configured
+ * 				using @ref BSP_PWM1_10_ConfigChannels()
+ * @param handle Handle to be filled
+ */
+extern void BSP_PWM1_10_CreateDutyHandle(uint32_t pwmNo, pwm_config_t* config, bool isPair, pwm1_10_duty_handle_t* handle);
+/**
+ * @brief Updates the period of the handle from the timer registers after the frequency of the timer changes.
+ * @param handle Handle to be updated
+ */
+extern void BSP_PWM1_10_RefreshDutyHandle(pwm1_10_duty_handle_t* handle);
+/**
+ * @brief Interleaves the timers of the given PWMs by resetting them with the master HRTIM.
+ * @details The first leg with zero phase shift is reset by the master period, while the other legs are
+ * reset by the compare units of the master HRTIM, which are assigned in order (COMP1-COMP4).
+ * The reset sources previously configured for these timers are replaced.
+ * @note Configure the PWMs and the master HRTIM (@ref BSP_MasterHRTIM_Config()) before calling this function.
+ * The frequency of the interleaved PWMs should be the same as the master HRTIM.
+ * @param *config Pointer to the interleaving configuration
+ * @return bool <c>true</c> if successful, <c>false</c> if the configuration is invalid or needs more than
+ * four compare units
+ */
+extern bool BSP_PWM1_10_ConfigInterleaving(pwm1_10_interleave_config_t* config);
+/**
+ * @brief Changes the frequency of the master HRTIM and the interleaved PWMs while keeping the phase shifts.
+ * @details The updates are held till all registers are written, but they are not applied on the same boundary.
+ * The master period and shifts are transferred at the next master period, whereas each leg transfers its
+ * period at its own phase shifted reset. The legs therefore settle within one master period, during which
+ * each leg may run one irregular period between the old and new period and the phase shifts are not exact.
+ * @note The new frequency should be achievable with the prescalers selected during configuration.
+ * The duty cycle limits computed from the dead time are not updated. Refresh the duty handles using
+ * @ref BSP_PWM1_10_RefreshDutyHandle() and update the duty cycles after calling this function.
+ * @param *config Pointer to the interleaving configuration configured by @ref BSP_PWM1_10_ConfigInterleaving()
+ * @param f New frequency in Hz
+ */
+extern void BSP_PWM1_10_SetInterleavedFrequency(pwm1_10_interleave_config_t* config, timer_frequency_t f);
+/**
+ * @brief Generates the period sequence for the spread spectrum mode.
+ * @details The periods are spread over nominal * (1 +/- spread). The triangular profile is symmetrical
+ * around the nominal period, whereas the pseudo random profile is uniformly distributed and always
+ * generates the same sequence for the same parameters.
+ * @param nominalTicks Nominal period of the timer in ticks
+ * @param spread Maximum deviation of the period in per unit of the nominal period (Range 0-0.5)
+ * @param profile Profile of the sequence
+ * @param periods Buffer to be filled with the sequence
+ * @param length Length of the sequence
+ */
+extern void BSP_PWM1_10_GenerateSpreadSequence(uint32_t nominalTicks, float spread, pwm_spread_profile_t profile, uint16_t* periods, int length);
+/**
+ * @brief Loads the next period of the spread spectrum sequence and reapplies the duty cycles of all handles.
+ * @details Call this function from the reset interrupt of the timer (@ref BSP_PWM1_10_Config_Interrupt()).
+ * The new values are preloaded and take effect at the next period together.
+ * @note The duty cycles of the relevant PWMs should only be updated using @ref BSP_PWM1_10_UpdateDutyFast(),
+ * and at least once before enabling the interrupt. The period and compares of each handle are written
+ * with the interrupts disabled, so the duty cycles can be updated from interrupts of any priority.
+ * @param ss Pointer to the spread spectrum state
+ */
+extern void BSP_PWM1_10_SpreadSpectrumStep(pwm1_10_spread_spectrum_t* ss);
 /********************************************************************************
  * Code
  *******************************************************************************/
+/**
+ * @brief Update the Duty Cycle of a PWM pair or channel using a precomputed handle.
+ * @details Produces the same compare values as @ref BSP_PWM1_10_UpdatePairDuty() and
+ * @ref BSP_PWM1_10_UpdateChannelDuty() for the relevant configuration. Unlike
+ * @ref BSP_PWM1_10_UpdateChannelDuty(), the minimum duty cycle limit is also applied to individual channels.
+ * @note The compare values are computed and written with the interrupts disabled, so that the function can be
+ * called at any interrupt priority together with @ref BSP_PWM1_10_SpreadSpectrumStep().
+ * @param handle Handle created by @ref BSP_PWM1_10_CreateDutyHandle()
+ * @param duty duty cycle to be applied (Range 0-1 or given in the config parameter)
+ * @return float Duty cycle applied in this cycle. May differ from the duty variable if outside permitted limits
+ */
+static inline float BSP_PWM1_10_UpdateDutyFast(pwm1_10_duty_handle_t* handle, float duty)
+{
+	/* check for duty cycle limits */
+	if (duty > handle->max)
+		duty = handle->max;
+	else if (duty < handle->min)
+		duty = handle->min;
+
+	// the period may be changed by the spread spectrum mode from the timer interrupt
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	uint32_t period = handle->periodTicks;
+	uint32_t onTime = duty * handle->period;
+	if (onTime == 0 && handle->isPair)
+	{
+		*handle->cmpSet = period + 2;
+		*handle->cmpReset = period + 2;
+	}
+	else if (handle->isCenterAligned)
+	{
+		onTime += handle->deadTicks;
+		int t0 = (period - onTime) / 2; 		// half time
+		int tEnd = t0 + onTime;					// last edge at this time
+		if (t0 < 3)
+		{
+			t0 = 3;
+			// individual channels keep the on time
+			if (!handle->isPair)
+				tEnd = t0 + onTime;
+		}
+		*handle->cmpSet = t0;
+		*handle->cmpReset = tEnd;
+	}
+	else
+	{
+		*handle->cmpSet = 3;
+		*handle->cmpReset = onTime + handle->edgeOffset;
+	}
+	handle->duty = duty;
+	__set_PRIMASK(primask);
+	return duty;
+}
 
 
 /**
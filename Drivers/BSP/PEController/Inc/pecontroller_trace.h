@@ -0,0 +1,266 @@
+/**
+ ********************************************************************************
+ * @file 		pecontroller_trace.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Records the time stamped system events in fixed size binary trace rings.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+#ifndef PECONTROLLER_TRACE_H
+#define PECONTROLLER_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/** @addtogroup BSP
+ * @{
+ */
+
+/** @defgroup Trace Trace
+ * @brief Records the time stamped system events in fixed size binary trace rings.
+ * @details Each core writes to its own ring in the shared memory, so the writers never wait for the other core.
+ * @ref Trace_Log() can be called from the interrupts and only masks the interrupts while reserving a record.
+ * Each record carries a sequence no which is written last, so that any core can read the completed records
+ * with @ref Trace_Read() without blocking the writer. When the reader falls behind the oldest records are
+ * overwritten and counted in @ref trace_reader_t.lostCount.
+ * @code
+ * // control core
+ * Trace_Log(TRACE_EVT_RELAY, 0, true);
+ *
+ * // communication core
+ * static trace_reader_t reader = {0};
+ * trace_record_t records[16];
+ * char text[64];
+ * uint32_t count = Trace_Read(TRACE_RING_CM7, &reader, records, 16);
+ * for (uint32_t i = 0; i < count; i++)
+ * 	Trace_Format(TRACE_RING_CM7, &records[i], text, sizeof(text));
+ * @endcode
+ * @{
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "general_header.h"
+#include "user_config.h"
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+/** @defgroup Trace_Exported_Macros Macros
+ * @{
+ */
+#ifndef TRACE_ENABLE
+/**
+ * @brief Set to 1 to record the system events.
+ * @details The value can be overridden in user_config.h.
+ */
+#define TRACE_ENABLE					(ENABLE_TRACE)
+#endif
+#ifndef TRACE_ENABLE_BENCHMARK
+/**
+ * @brief Set to 1 to measure the cost of logging a single event with @ref Trace_RunBenchmark().
+ * @details The value can be overridden in user_config.h.
+ */
+#define TRACE_ENABLE_BENCHMARK			(0)
+#endif
+/**
+ * @brief No of records in each ring. Should be a power of 2.
+ */
+#define TRACE_RING_SIZE					(128)
+/**
+ * @brief Index of the ring written by the CM7 core.
+ */
+#define TRACE_RING_CM7					(0)
+/**
+ * @brief Index of the ring written by the CM4 core.
+ */
+#define TRACE_RING_CM4					(1)
+/**
+ * @brief No of trace rings.
+ */
+#define TRACE_RING_COUNT				(2)
+#ifndef TRACE_LOCAL_RING
+#ifdef CORE_CM7
+/**
+ * @brief Index of the ring written by the current core.
+ * @details The value can be overridden, e.g. by the host tests running both cores as threads.
+ */
+#define TRACE_LOCAL_RING				(TRACE_RING_CM7)
+#else
+#define TRACE_LOCAL_RING				(TRACE_RING_CM4)
+#endif
+#endif
+#ifndef TRACE_GET_TIMESTAMP
+/**
+ * @brief Gets the time stamp of an event.
+ * @details Uses the DWT cycle counter of the writing core by default. The frequency of the time stamps is
+ * saved in @ref trace_ring_t.clockHz. The counters of both cores are not synchronized.
+ * The 32-bit counter wraps around every 2^32 cycles, i.e. about 8.9 s at 480 MHz and 17.9 s at 240 MHz, so the
+ * time between two records is only valid if they are closer than this.
+ */
+#define TRACE_GET_TIMESTAMP()			(DWT->CYCCNT)
+#endif
+/**
+ * @}
+ */
+/*******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/** @defgroup Trace_Exported_Typedefs Type Definitions
+ * @{
+ */
+/**
+ * @brief List of the system events.
+ * @note Add the application specific events from @ref TRACE_EVT_USER.
+ */
+typedef enum
+{
+	TRACE_EVT_RELAY,					/**< Relay state changed. param = relay group, value = new state */
+	TRACE_EVT_PLL_STATUS,				/**< PLL status changed. param = new status, value = previous status */
+	TRACE_EVT_MODE,						/**< Operating mode changed. param = new mode, value = application specific */
+	TRACE_EVT_FAULT,					/**< Fault detected. param = fault source, value = fault data */
+	TRACE_EVT_DEADLINE_TRIP,			/**< Deadline monitor tripped. param = consecutive misses, value = overrun count */
+	TRACE_EVT_BENCHMARK,				/**< Event logged by @ref Trace_RunBenchmark(). value = event no */
+	TRACE_EVT_USER = 0x100,				/**< First application specific event */
+} trace_event_t;
+/**
+ * @}
+ */
+/*******************************************************************************
+ * Structures
+ ******************************************************************************/
+/** @defgroup Trace_Exported_Structures Structures
+ * @{
+ */
+/**
+ * @brief Defines a single binary trace record.
+ */
+typedef struct
+{
+	uint32_t sequence;					/*!< Index of the record + 1 once the record is complete */
+	uint32_t timestamp;					/*!< Time stamp of the event */
+	uint16_t id;						/*!< Event id. Use @ref trace_event_t values */
+	uint16_t param;						/*!< Small event specific parameter */
+	uint32_t value;						/*!< Event specific value */
+} trace_record_t;
+/**
+ * @brief Defines the trace ring of a single core.
+ * @note Each ring starts at a new cache line, as the rings are written by different cores.
+ */
+typedef struct
+{
+	uint32_t writeIndex SHARED_REGION_ALIGN;	/*!< No of records reserved since initialization */
+	uint32_t clockHz;							/*!< Frequency of the time stamps. Set by the first logged event */
+#if TRACE_ENABLE_BENCHMARK
+	uint32_t benchmarkEvents;					/*!< No of events logged in the last benchmark */
+	uint32_t benchmarkCycles;					/*!< Total cycles taken by the last benchmark */
+#endif
+	trace_record_t records[TRACE_RING_SIZE];	/*!< Records of the ring */
+} trace_ring_t;
+/**
+ * @brief Defines the trace data shared between both cores.
+ */
+typedef struct
+{
+	trace_ring_t rings[TRACE_RING_COUNT];		/*!< Trace rings of both cores */
+} trace_data_t;
+/**
+ * @brief Defines the state of a trace reader for a single ring.
+ * @note Initialize with zeros before the first read.
+ */
+typedef struct
+{
+	uint32_t readIndex;							/*!< Index of the next record to be read */
+	uint32_t lostCount;							/*!< No of records overwritten before being read */
+} trace_reader_t;
+/**
+ * @}
+ */
+/*******************************************************************************
+ * Exported Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Global Function Prototypes
+ ******************************************************************************/
+/** @defgroup Trace_Exported_Functions Functions
+ * @{
+ */
+#if TRACE_ENABLE
+/**
+ * @brief Clears the ring of the current core and starts the DWT cycle counter.
+ * @note Called by @ref SharedMemory_Init() in both cores before the clock configuration, so the frequency of the
+ * time stamps is only saved by @ref Trace_Log().
+ */
+extern void Trace_Init(void);
+/**
+ * @brief Logs an event in the ring of the current core.
+ * @details Updates @ref trace_ring_t.clockHz if the core clock has changed since the last event.
+ * @note Can be called from the interrupts.
+ * @param id Event id. Use @ref trace_event_t values.
+ * @param param Small event specific parameter.
+ * @param value Event specific value.
+ */
+extern void Trace_Log(uint16_t id, uint16_t param, uint32_t value);
+/**
+ * @brief Reads the completed records of a ring.
+ * @details Records being written are left for the next read. Records overwritten before being read are
+ * skipped and counted in @ref trace_reader_t.lostCount.
+ * @param ringNo Index of the ring. Use @ref TRACE_RING_CM7 or @ref TRACE_RING_CM4.
+ * @param reader Pointer to the reader state of the ring.
+ * @param records Pointer to the buffer to be filled.
+ * @param maxCount Maximum no of records to be read.
+ * @return No of records read.
+ */
+extern uint32_t Trace_Read(uint8_t ringNo, trace_reader_t* reader, trace_record_t* records, uint32_t maxCount);
+/**
+ * @brief Converts a record to text for display or export.
+ * @details The format is <b>time_us,ring,event,param,value</b> with the time in micro seconds.
+ * @param ringNo Index of the ring containing the record.
+ * @param record Pointer to the record.
+ * @param text Pointer to the text buffer.
+ * @param len Size of the text buffer.
+ * @return No of characters written excluding the null character.
+ */
+extern int Trace_Format(uint8_t ringNo, const trace_record_t* record, char* text, size_t len);
+#if TRACE_ENABLE_BENCHMARK
+/**
+ * @brief Measures the cost of logging an event by logging consecutive @ref TRACE_EVT_BENCHMARK events.
+ * @details Can be run in both cores at the same time to measure the cost with two writers.
+ * The results are stored in @ref trace_ring_t.benchmarkEvents and @ref trace_ring_t.benchmarkCycles.
+ * @param eventCount No of events to be logged.
+ * @return Average cycles per event.
+ */
+extern float Trace_RunBenchmark(uint32_t eventCount);
+#endif
+#endif
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/**
+ * @}
+ */
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+/**
+ * @}
+ */
+#endif
+/* EOF */
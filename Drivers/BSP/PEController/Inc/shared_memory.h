@@ -45,12 +45,38 @@ extern "C" {
 #include "general_header.h"
 #include "adc_config.h"
 #include "p2p_comms.h"
+#include "pecontroller_profiler.h"
+#include "pecontroller_trace.h"
 /********************************************************************************
  * Defines
  *******************************************************************************/
 /** @defgroup SHAREDMEM_Exported_Macros Macros
  * @{
  */
+/**
+ * @brief Start address of the memory shared between both cores (SRAM4).
+ */
+#define SHARED_MEMORY_BASE_ADDR		(0x38000000)
+/**
+ * @brief Size of the memory shared between both cores in bytes.
+ */
+#define SHARED_MEMORY_SIZE			(0x10000)
+/**
+ * @brief Start address of @ref shared_data_t in the shared memory.
+ */
+#define SHARED_DATA_ADDR			(SHARED_MEMORY_BASE_ADDR)
+/**
+ * @brief Maximum size of @ref shared_data_t in bytes.
+ */
+#define SHARED_DATA_MAX_SIZE		(0xF000)
+/**
+ * @brief Start address of the ADC DMA buffer in the shared memory.
+ */
+#define ADC_DMA_DATA_ADDR			(SHARED_DATA_ADDR + SHARED_DATA_MAX_SIZE)
+/**
+ * @brief Maximum size of the ADC DMA buffer in bytes.
+ */
+#define ADC_DMA_DATA_MAX_SIZE		(SHARED_MEMORY_BASE_ADDR + SHARED_MEMORY_SIZE - ADC_DMA_DATA_ADDR)
 /**
  * @brief Shortcut for accessing raw ADC data.
  */
@@ -71,6 +97,14 @@ extern "C" {
  * @brief Shortcut for accessing data shared between CM4 and CM7 core.
  */
 #define INTER_CORE_DATA				(sharedData->p2pMsgs.dataBuffs)
+/**
+ * @brief Shortcut for accessing the profiling data.
+ */
+#define PROFILER_DATA				(sharedData->profiler)
+/**
+ * @brief Shortcut for accessing the event trace rings.
+ */
+#define TRACE_DATA					(sharedData->trace)
 /**
  * @}
  */
@@ -86,17 +120,41 @@ extern "C" {
  */
 /**
  * @brief Buffer containing all shared data between both cores
+ * @note Each member starts at a new cache line (@ref SHARED_REGION_ALIGN). Keep this property when adding
+ * new members, and align the fields inside the members that are written by a different core than the
+ * preceding fields.
  */
 typedef struct
 {
-	volatile bool isStateStorageInitialized;		/**< Flag indicating if the state storage module has restored states. */
-	adc_raw_data_t rawAdcData;						/**< Raw ADC data */
-	adc_processed_data_t processedAdcData;			/**< Converted ADC data */
-	p2p_msg_data_t p2pMsgs;							/**< Structure handling the parameters and commjunications between CM4 and CM7 core. */
+	volatile bool isStateStorageInitialized SHARED_REGION_ALIGN;	/**< Flag indicating if the state storage module has restored states. */
+	adc_raw_data_t rawAdcData SHARED_REGION_ALIGN;					/**< Raw ADC data */
+	adc_processed_data_t processedAdcData SHARED_REGION_ALIGN;		/**< Converted ADC data */
+	p2p_msg_data_t p2pMsgs SHARED_REGION_ALIGN;						/**< Structure handling the parameters and commjunications between CM4 and CM7 core. */
+#if PROFILER_ENABLE
+	profiler_data_t profiler SHARED_REGION_ALIGN;					/**< Execution time statistics of the profiled code sections. */
+#endif
+#if TRACE_ENABLE
+	trace_data_t trace SHARED_REGION_ALIGN;							/**< Event trace rings of both cores. */
+#endif
 } shared_data_t;
+/**
+ * @brief Defines the memory attributes for a region in the shared memory.
+ */
+typedef struct
+{
+	uint32_t baseAddr;			/**< Start address of the region. Should be aligned to the region size */
+	uint8_t size;				/**< Size of the region. Use MPU_REGION_SIZE_xxx values */
+	uint8_t number;				/**< MPU region number. Use MPU_REGION_NUMBERx values */
+	bool isCacheable;			/**< <c>true</c> if the data cache can be used for the region */
+	bool isShareable;			/**< <c>true</c> if the region is shared between the bus masters */
+} shared_memory_region_t;
 /**
  * @}
  */
+/* Compile time checks for the shared memory layout */
+_Static_assert(sizeof(shared_data_t) <= SHARED_DATA_MAX_SIZE, "shared_data_t overlaps the ADC DMA buffer. Reduce the buffer sizes.");
+_Static_assert((SHARED_DATA_ADDR % SHARED_MEMORY_ALIGNMENT) == 0, "Shared data should be aligned to the cache line.");
+_Static_assert((ADC_DMA_DATA_ADDR % SHARED_MEMORY_ALIGNMENT) == 0, "ADC DMA buffer should be aligned to the cache line.");
 /********************************************************************************
  * Exported Variables
  *******************************************************************************/
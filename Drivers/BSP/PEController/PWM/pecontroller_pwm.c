@@ -140,6 +140,101 @@ float BSP_PWM_UpdateChannelDuty(uint32_t pwmNo, float duty, pwm_config_t* config
 	return 0;
 }
 
+/**
+ * @brief Gets the HRTIM update disable bits for the timers driving the required PWM channels
+ * @param pwmMask PWM channels to be considered.<br>
+ * 				<b>Valid Range</b> =  (0x0001 - 0xffff)
+ * @param masterHRTIM <c>true</c> if the master HRTIM should also be included else <c>false</c>
+ * @return uint32_t Bits to be written in the HRTIM_CR1 register
+ */
+static inline uint32_t GetHRTIMUpdateDisableBits(uint32_t pwmMask, bool masterHRTIM)
+{
+	return (pwmMask & 0x3 ? HRTIM_CR1_TAUDIS : 0) |
+			(pwmMask & 0xc ? HRTIM_CR1_TBUDIS : 0) |
+			(pwmMask & 0x30 ? HRTIM_CR1_TCUDIS : 0) |
+			(pwmMask & 0xc0 ? HRTIM_CR1_TDUDIS : 0) |
+			(pwmMask & 0x300 ? HRTIM_CR1_TEUDIS : 0) |
+			(masterHRTIM ? HRTIM_CR1_MUDIS : 0);
+}
+
+/**
+ * @brief Holds back the transfer of the preloaded registers to the active registers for the
+ * timers driving the required PWM channels. The duty cycles written after this call take effect
+ * together once @ref BSP_PWM_ReleaseUpdates() is called.
+ * @note Keep the hold window short. If a PWM period boundary occurs while the updates are held,
+ * the previous values are retained for one more period. For PWM11-16 the TIM1 update interrupt is
+ * not generated for such a period.
+ * @param pwmMask PWM channels whose updates need to be held.<br>
+ * 				<b>Valid Range</b> =  (0x0001 - 0xffff)
+ * @param masterHRTIM <c>true</c> if the master HRTIM updates should also be held else <c>false</c>
+ */
+void BSP_PWM_HoldUpdates(uint32_t pwmMask, bool masterHRTIM)
+{
+	uint32_t bits = GetHRTIMUpdateDisableBits(pwmMask, masterHRTIM);
+	if (bits)
+		hhrtim.Instance->sCommonRegs.CR1 |= bits;
+	if (pwmMask & 0xfc00)
+		htim1.Instance->CR1 |= TIM_CR1_UDIS;
+}
+
+/**
+ * @brief Releases the updates held by @ref BSP_PWM_HoldUpdates(). All values written in the
+ * meantime are transferred to the active registers at the next PWM period boundary.
+ * @param pwmMask PWM channels whose updates need to be released.<br>
+ * 				<b>Valid Range</b> =  (0x0001 - 0xffff)
+ * @param masterHRTIM <c>true</c> if the master HRTIM updates should also be released else <c>false</c>
+ */
+void BSP_PWM_ReleaseUpdates(uint32_t pwmMask, bool masterHRTIM)
+{
+	uint32_t bits = GetHRTIMUpdateDisableBits(pwmMask, masterHRTIM);
+	if (bits)
+		hhrtim.Instance->sCommonRegs.CR1 &= ~bits;
+	if (pwmMask & 0xfc00)
+		htim1.Instance->CR1 &= ~TIM_CR1_UDIS;
+}
+
+/**
+ * @brief Update the duty cycles of multiple inverted pairs so that all of them are applied
+ * in the same PWM period
+ * @details The pairs at PWM1-10 are updated using the caller's duty handle, so the duty cycle limits and the
+ * dead time compensation are not evaluated again in each call. The handle is moved to the timer of each pair,
+ * so the configuration should be shared by all pairs.
+ * @code
+ * // Create the handle once after the configuration
+ * static pwm1_10_duty_handle_t pairsHandle;
+ * BSP_PWM1_10_CreateDutyHandle(1, &pwmConfig, true, &pairsHandle);
+ * // Update the pairs at PWM1-2, PWM3-4 and PWM11-12 in one go
+ * float duties[3] = { 0.2f, 0.5f, 0.8f };
+ * BSP_PWM_UpdatePairDuties(0x405, duties, &pairsHandle, &pwmConfig);
+ * @endcode
+ * @param pwmMask Reference channels of the pairs to be updated.<br>
+ * 				<b>Valid Range</b> =  (0x0001 - 0xffff)
+ * @param duties Duty cycles to be applied. One entry for each bit set in pwmMask
+ * 				starting from the lowest channel (Range 0-1 or given in the config parameter)
+ * @param handle Handle created by @ref BSP_PWM1_10_CreateDutyHandle() for one of the pairs at PWM1-10.
+ * 				May be NULL if pwmMask only contains pairs at PWM11-16
+ * @param *config Pointer to a  pwm_config_t structure that contains the configuration
+ * 				   parameters for the PWM pairs at PWM11-16
+ */
+void BSP_PWM_UpdatePairDuties(uint32_t pwmMask, const float* duties, pwm1_10_duty_handle_t* handle, pwm_config_t* config)
+{
+	uint32_t mask = pwmMask & 0xffff;
+	BSP_PWM_HoldUpdates(mask, false);
+	while (mask)
+	{
+		uint32_t pwmNo = __builtin_ctz(mask) + 1;
+		if (pwmNo <= 10)
+		{
+			PWM1_10_MoveDutyHandle(handle, pwmNo);
+			BSP_PWM1_10_UpdateDutyFast(handle, *duties++);
+		}
+		else
+			BSP_PWM11_16_UpdatePairDuty(pwmNo, *duties++, config);
+		mask &= mask - 1;
+	}
+	BSP_PWM_ReleaseUpdates(pwmMask, false);
+}
+
 /**
  * @brief Enable / Disable interrupt for a PWM channel as per requirement
  * @param pwmNo Channel no of the PWM Channel (Range 1-16)
@@ -235,6 +330,9 @@ void BSP_PWM_Start(uint32_t pwmMask, bool masterHRTIM)
  */
 void BSP_PWM_Stop(uint32_t pwmMask, bool masterHRTIM)
 {
+	// CCER is also cleared by BSP_PWMOut_ForceDisable() from the interrupts, so it is updated with the interrupts disabled
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
 	if (pwmMask & 0x400)
 		TIM_CCxChannelCmd(htim1.Instance, TIM_CHANNEL_1, TIM_CCx_DISABLE);
 	if (pwmMask & 0x800)
@@ -247,6 +345,7 @@ void BSP_PWM_Stop(uint32_t pwmMask, bool masterHRTIM)
 		TIM_CCxChannelCmd(htim1.Instance, TIM_CHANNEL_3, TIM_CCx_DISABLE);
 	if (pwmMask & 0x8000)
 		TIM_CCxNChannelCmd(htim1.Instance, TIM_CHANNEL_3, TIM_CCxN_DISABLE);
+	__set_PRIMASK(primask);
 
 	HAL_HRTIM_WaveformOutputStop(&hhrtim,
 			(pwmMask & 0x1 ? HRTIM_OUTPUT_TA1 : 0) |
@@ -332,6 +431,9 @@ void BSP_PWM_GetDefaultConfig(pwm_config_t* pwmConfig, pwm_module_config_t* modu
  */
 void BSP_PWMOut_Enable(uint32_t pwmMask, bool en)
 {
+	// CCER is also cleared by BSP_PWMOut_ForceDisable() from the interrupts, so it is updated with the interrupts disabled
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
 	if (en)
 	{
 		if (pwmMask & 0xC00)
@@ -350,6 +452,7 @@ void BSP_PWMOut_Enable(uint32_t pwmMask, bool en)
 			TIM_CCxNChannelCmd(htim1.Instance, TIM_CHANNEL_3, TIM_CCxN_ENABLE);
 		}
 
+		__set_PRIMASK(primask);
 		HAL_HRTIM_WaveformOutputStart(&hhrtim,
 				(pwmMask & 0x1 ? HRTIM_OUTPUT_TA1 : 0) |
 				(pwmMask & 0x2 ? HRTIM_OUTPUT_TA2 : 0) |
@@ -380,6 +483,7 @@ void BSP_PWMOut_Enable(uint32_t pwmMask, bool en)
 			TIM_CCxNChannelCmd(htim1.Instance, TIM_CHANNEL_3, TIM_CCxN_DISABLE);
 		}
 
+		__set_PRIMASK(primask);
 		HAL_HRTIM_WaveformOutputStop(&hhrtim,
 				(pwmMask & 0x1 ? HRTIM_OUTPUT_TA1 : 0) |
 				(pwmMask & 0x2 ? HRTIM_OUTPUT_TA2 : 0) |
@@ -393,5 +497,31 @@ void BSP_PWMOut_Enable(uint32_t pwmMask, bool en)
 				(pwmMask & 0x200 ? HRTIM_OUTPUT_TE2 : 0));
 	}
 }
+/**
+ * @brief Disables the output for required PWM channels by writing the timer registers directly.
+ * @details Unlike @ref BSP_PWMOut_Enable() the HAL handles are not locked, so the outputs are disabled even if
+ * the interrupted code is using the same handle. Use this function for the protection in interrupts.
+ * Enable the outputs again using @ref BSP_PWMOut_Enable().
+ * @note @ref BSP_PWMOut_Enable() and @ref BSP_PWM_Stop() update the TIM1 outputs with the interrupts disabled, so an
+ * interrupted read-modify-write of CCER cannot enable the outputs disabled here again.
+ * @param pwmMask Set the PWM channels needed to be disabled.<br>
+ * 				<b>Valid Range</b> =  (0x0001 - 0xffff)
+ */
+TCritical void BSP_PWMOut_ForceDisable(uint32_t pwmMask)
+{
+	// HRTIM output disable bits follow the PWM channel order
+	if (pwmMask & 0x3FF)
+		hhrtim.Instance->sCommonRegs.ODISR = pwmMask & 0x3FF;
+
+	uint32_t ccer = 0;
+	if (pwmMask & 0xC00)
+		ccer |= TIM_CCER_CC1E | TIM_CCER_CC1NE;
+	if (pwmMask & 0x3000)
+		ccer |= TIM_CCER_CC2E | TIM_CCER_CC2NE;
+	if (pwmMask & 0xC000)
+		ccer |= TIM_CCER_CC3E | TIM_CCER_CC3NE;
+	if (ccer)
+		htim1.Instance->CCER &= ~ccer;
+}
 
 /* EOF */
@@ -397,6 +397,254 @@ DutyCycleUpdateFnc BSP_PWM1_10_ConfigChannels(uint32_t pwmNo, pwm_config_t* conf
 	return BSP_PWM1_10_UpdateChannelDuty;
 }
 
+/**
+ * @brief Creates the precomputed handle for the fast duty cycle update of a PWM pair or channel.
+ * @note Call after configuring the PWM. Call @ref BSP_PWM1_10_RefreshDutyHandle() if the timer period changes,
+ * and recreate the handle if the other configurations change.
+ * @param pwmNo Channel no of the PWM channel or the reference channel of the PWM pair (Valid Values 1-10).
+ * @param *config Pointer to a  pwm_config_t structure that contains the configuration
+ * 				   parameters for the PWM
+ * @param isPair <c>true</c> if configured using @ref BSP_PWM1_10_ConfigInvertedPairs(), <c>false</c> if configured
+ * 				using @ref BSP_PWM1_10_ConfigChannels()
+ * @param handle Handle to be filled
+ */
+void BSP_PWM1_10_CreateDutyHandle(uint32_t pwmNo, pwm_config_t* config, bool isPair, pwm1_10_duty_handle_t* handle)
+{
+	uint32_t TimerIdx = (pwmNo - 1) / 2;
+	pwm_module_config_t* mod = config->module;
+	HRTIM_Timerx_TypeDef* regs = &hhrtim.Instance->sTimerxRegs[TimerIdx];
+
+	handle->timerIdx = TimerIdx;
+	handle->isPair = isPair;
+	handle->isCenterAligned = mod->alignment == CENTER_ALIGNED;
+	handle->max = config->lim.max;
+	handle->min = config->lim.min;
+	handle->deadTicks = 0;
+	handle->edgeOffset = 3;
+	handle->duty = config->lim.min;
+
+	if (isPair || pwmNo % 2)
+	{
+		handle->cmpSet = &regs->CMP1xR;
+		handle->cmpReset = &regs->CMP2xR;
+	}
+	else
+	{
+		handle->cmpSet = &regs->CMP3xR;
+		handle->cmpReset = &regs->CMP4xR;
+	}
+
+	/* dead time compensation evaluated once instead of every cycle */
+	if (isPair && config->dutyMode == OUTPUT_DUTY_AT_PWMH && IsDeadtimeEnabled(&mod->deadtime))
+	{
+		if (handle->isCenterAligned)
+			handle->deadTicks = (mod->deadtime.nanoSec) * (BSP_HRTIM_GetTimerFreq(TimerIdx) / 1000000000.f);
+		else
+			handle->edgeOffset += (mod->deadtime.nanoSec) * (BSP_HRTIM_GetTimerFreq(TimerIdx) / 1000000000.f);
+	}
+	if (!isPair)
+		MODIFY_REG(regs->TIMxCR, (pwmNo % 2) ? HRTIM_TIMCR_DELCMP2 : HRTIM_TIMCR_DELCMP4, 0U);
+
+	BSP_PWM1_10_RefreshDutyHandle(handle);
+}
+
+/**
+ * @brief Updates the period of the handle from the timer registers after the frequency of the timer changes.
+ * @param handle Handle to be updated
+ */
+void BSP_PWM1_10_RefreshDutyHandle(pwm1_10_duty_handle_t* handle)
+{
+	handle->periodTicks = hhrtim.Instance->sTimerxRegs[handle->timerIdx].PERxR;
+	handle->period = handle->periodTicks;
+}
+
+/**
+ * @brief Moves the handle of an inverted pair to the timer of another pair with the same configuration.
+ * @details Only the register addresses and the period are updated. The dead time compensation is kept,
+ * as the timers configured with the same module use the same prescaler.
+ * @param handle Handle created by @ref BSP_PWM1_10_CreateDutyHandle() for an inverted pair
+ * @param pwmNo Channel no of the reference channel of the PWM pair (Valid Values 1-10).
+ */
+static void PWM1_10_MoveDutyHandle(pwm1_10_duty_handle_t* handle, uint32_t pwmNo)
+{
+	uint32_t TimerIdx = (pwmNo - 1) / 2;
+	HRTIM_Timerx_TypeDef* regs = &hhrtim.Instance->sTimerxRegs[TimerIdx];
+	handle->timerIdx = TimerIdx;
+	handle->cmpSet = &regs->CMP1xR;
+	handle->cmpReset = &regs->CMP2xR;
+	BSP_PWM1_10_RefreshDutyHandle(handle);
+}
+
+/**
+ * @brief Writes the master compare values of the interleaved legs for the current master period.
+ * @param *config Pointer to the interleaving configuration
+ */
+static void UpdateInterleavedShifts(pwm1_10_interleave_config_t* config)
+{
+	for (int i = 0; i < config->legCount; i++)
+	{
+		if (i != config->resetOnPeriodIndex)
+			BSP_MasterHRTIM_SetShiftPercent(config->masterOpts, config->comps[i], config->shifts[i]);
+	}
+}
+
+/**
+ * @brief Interleaves the timers of the given PWMs by resetting them with the master HRTIM.
+ * @details The first leg with zero phase shift is reset by the master period, while the other legs are
+ * reset by the compare units of the master HRTIM, which are assigned in order (COMP1-COMP4).
+ * The reset sources previously configured for these timers are replaced.
+ * @note Configure the PWMs and the master HRTIM (@ref BSP_MasterHRTIM_Config()) before calling this function.
+ * The frequency of the interleaved PWMs should be the same as the master HRTIM.
+ * @param *config Pointer to the interleaving configuration
+ * @return bool <c>true</c> if successful, <c>false</c> if the configuration is invalid or needs more than
+ * four compare units
+ */
+bool BSP_PWM1_10_ConfigInterleaving(pwm1_10_interleave_config_t* config)
+{
+	static const hrtim_comp_t comps[4] = { HRTIM_COMP1, HRTIM_COMP2, HRTIM_COMP3, HRTIM_COMP4 };
+	static const uint32_t compResets[4] = { HRTIM_TIMRESETTRIGGER_MASTER_CMP1, HRTIM_TIMRESETTRIGGER_MASTER_CMP2,
+			HRTIM_TIMRESETTRIGGER_MASTER_CMP3, HRTIM_TIMRESETTRIGGER_MASTER_CMP4 };
+	uint32_t resets[PWM1_10_MAX_INTERLEAVED_LEGS];
+	uint32_t timerMask = 0;
+	int compIndex = 0;
+
+	if (config->legCount == 0 || config->legCount > PWM1_10_MAX_INTERLEAVED_LEGS || config->masterOpts == NULL)
+		return false;
+
+	config->resetOnPeriodIndex = PWM1_10_MAX_INTERLEAVED_LEGS;
+	for (int i = 0; i < config->legCount; i++)
+	{
+		uint32_t pwmNo = config->pwmNos[i];
+		if (pwmNo < 1 || pwmNo > 10)
+			return false;
+		// each leg needs a separate timer
+		uint32_t TimerIdx = (pwmNo - 1) / 2;
+		if (timerMask & (1U << TimerIdx))
+			return false;
+		timerMask |= (1U << TimerIdx);
+
+		if (config->isEvenlySpaced)
+			config->shifts[i] = (float)i / config->legCount;
+		// the first leg without phase shift is reset with the master period
+		if (config->shifts[i] == 0 && config->resetOnPeriodIndex == PWM1_10_MAX_INTERLEAVED_LEGS)
+		{
+			config->resetOnPeriodIndex = i;
+			resets[i] = HRTIM_TIMRESETTRIGGER_MASTER_PER;
+		}
+		else
+		{
+			if (compIndex >= 4)
+				return false;
+			config->comps[i] = comps[compIndex];
+			resets[i] = compResets[compIndex++];
+		}
+	}
+
+	UpdateInterleavedShifts(config);
+	for (int i = 0; i < config->legCount; i++)
+		hhrtim.Instance->sTimerxRegs[(config->pwmNos[i] - 1) / 2].RSTxR = resets[i];
+	return true;
+}
+
+/**
+ * @brief Changes the frequency of the master HRTIM and the interleaved PWMs while keeping the phase shifts.
+ * @details The updates are held till all registers are written, but they are not applied on the same boundary.
+ * The master period and shifts are transferred at the next master period, whereas each leg transfers its
+ * period at its own phase shifted reset. The legs therefore settle within one master period, during which
+ * each leg may run one irregular period between the old and new period and the phase shifts are not exact.
+ * @note The new frequency should be achievable with the prescalers selected during configuration.
+ * The duty cycle limits computed from the dead time are not updated. Refresh the duty handles using
+ * @ref BSP_PWM1_10_RefreshDutyHandle() and update the duty cycles after calling this function.
+ * @param *config Pointer to the interleaving configuration configured by @ref BSP_PWM1_10_ConfigInterleaving()
+ * @param f New frequency in Hz
+ */
+void BSP_PWM1_10_SetInterleavedFrequency(pwm1_10_interleave_config_t* config, timer_frequency_t f)
+{
+	uint32_t updateDisable = HRTIM_CR1_MUDIS;
+	for (int i = 0; i < config->legCount; i++)
+		updateDisable |= HRTIM_CR1_TAUDIS << ((config->pwmNos[i] - 1) / 2);
+
+	// hold the preloaded values till all registers are written
+	hhrtim.Instance->sCommonRegs.CR1 |= updateDisable;
+	config->masterOpts->f = f;
+	hhrtim.Instance->sMasterRegs.MPER = BSP_HRTIM_GetTimerFreq(HRTIM_TIMERINDEX_MASTER) / f;
+	for (int i = 0; i < config->legCount; i++)
+	{
+		uint32_t TimerIdx = (config->pwmNos[i] - 1) / 2;
+		hhrtim.Instance->sTimerxRegs[TimerIdx].PERxR = BSP_HRTIM_GetTimerFreq(TimerIdx) / f;
+	}
+	UpdateInterleavedShifts(config);
+	hhrtim.Instance->sCommonRegs.CR1 &= ~updateDisable;
+}
+
+/**
+ * @brief Generates the period sequence for the spread spectrum mode.
+ * @details The periods are spread over nominal * (1 +/- spread). The triangular profile is symmetrical
+ * around the nominal period, whereas the pseudo random profile is uniformly distributed and always
+ * generates the same sequence for the same parameters.
+ * @param nominalTicks Nominal period of the timer in ticks
+ * @param spread Maximum deviation of the period in per unit of the nominal period (Range 0-0.5)
+ * @param profile Profile of the sequence
+ * @param periods Buffer to be filled with the sequence
+ * @param length Length of the sequence
+ */
+void BSP_PWM1_10_GenerateSpreadSequence(uint32_t nominalTicks, float spread, pwm_spread_profile_t profile, uint16_t* periods, int length)
+{
+	uint32_t seed = 0x2545F491U;
+	for (int i = 0; i < length; i++)
+	{
+		float deviation;		// normalized deviation (Range -1 to 1)
+		if (profile == SPREAD_TRIANGULAR)
+		{
+			float phase = (i + 0.5f) / length;
+			deviation = phase < 0.5f ? (4 * phase - 1) : (3 - 4 * phase);
+		}
+		else
+		{
+			/* xorshift generator so that the sequence is repeatable */
+			seed ^= seed << 13;
+			seed ^= seed >> 17;
+			seed ^= seed << 5;
+			deviation = ((int32_t)seed) / 2147483648.f;
+		}
+		float ticks = nominalTicks * (1 + spread * deviation) + 0.5f;
+		if (ticks > PWM1_10_MAX_PERIOD_TICKS)
+			ticks = PWM1_10_MAX_PERIOD_TICKS;
+		else if (ticks < 6)
+			ticks = 6;
+		periods[i] = (uint16_t)ticks;
+	}
+}
+
+/**
+ * @brief Loads the next period of the spread spectrum sequence and reapplies the duty cycles of all handles.
+ * @details Call this function from the reset interrupt of the timer (@ref BSP_PWM1_10_Config_Interrupt()).
+ * The new values are preloaded and take effect at the next period together.
+ * @note The duty cycles of the relevant PWMs should only be updated using @ref BSP_PWM1_10_UpdateDutyFast(),
+ * and at least once before enabling the interrupt. The period and compares of each handle are written
+ * with the interrupts disabled, so the duty cycles can be updated from interrupts of any priority.
+ * @param ss Pointer to the spread spectrum state
+ */
+void BSP_PWM1_10_SpreadSpectrumStep(pwm1_10_spread_spectrum_t* ss)
+{
+	uint32_t period = ss->periods[ss->index];
+	if (++ss->index >= ss->length)
+		ss->index = 0;
+
+	for (int i = 0; i < ss->handleCount; i++)
+	{
+		// the period and compares are updated together, as the duty cycle may be updated from other interrupts
+		pwm1_10_duty_handle_t* handle = ss->handles[i];
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
+		hhrtim.Instance->sTimerxRegs[handle->timerIdx].PERxR = period;
+		handle->periodTicks = period;
+		handle->period = period;
+		BSP_PWM1_10_UpdateDutyFast(handle, handle->duty);
+		__set_PRIMASK(primask);
+	}
+}
+
 /**
  * @brief Enable / Disable interrupt for a PWM channel as per requirement
  * @param pwmNo Channel no of the PWM Channel (Range 1-10)
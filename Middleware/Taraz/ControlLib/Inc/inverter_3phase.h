@@ -103,6 +103,9 @@ typedef struct
 														This value represents the first switch of the 4th leg. To disable duplication set this to 0 */
 	DutyCycleUpdateFnc updateCallbackDuplicate; /**< @brief These call backs are used by the drivers to update
 													the duty cycles of the duplicate leg according to the configuration */
+	pwm1_10_duty_handle_t dutyHandles[4];		/**< @brief Precomputed handles used instead of the call backs if all legs are
+													default legs at PWM1-10. The last handle is used for the duplicate leg */
+	bool isFastUpdate;							/**< @brief <c>true</c> if the duty cycles are updated using @ref dutyHandles */
 
 } inverter3Ph_config_t;
 /**
@@ -97,6 +97,53 @@ static DutyCycleUpdateFnc ConfigSingleLeg(inverter3Ph_config_t* config, uint16_t
 	return callback;
 }
 
+/**
+ * @brief Create the precomputed handles for the fast duty cycle update if all legs are default legs at PWM1-10.
+ * @param *config Pointer to the Inverter Configurations.
+ * @return bool <c>true</c> if the handles are created, else <c>false</c>.
+ */
+static bool CreateDutyHandles(inverter3Ph_config_t* config)
+{
+	if (config->legType != LEG_DEFAULT || config->s1PinDuplicate > 10)
+		return false;
+	for (int i = 0; i < 3; i++)
+	{
+		if (config->s1PinNos[i] > 10)
+			return false;
+	}
+	for (int i = 0; i < 3; i++)
+		BSP_PWM1_10_CreateDutyHandle(config->s1PinNos[i], &config->pwmConfig, true, &config->dutyHandles[i]);
+	if (config->s1PinDuplicate)
+		BSP_PWM1_10_CreateDutyHandle(config->s1PinDuplicate, &config->pwmConfig, true, &config->dutyHandles[3]);
+	return true;
+}
+
+/**
+ * @brief Get the PWM mask for a single leg of the inverter.
+ * @param *config Pointer to the Inverter Configurations.
+ * @param pwmNo Channel no of the first switch of the leg.
+ * @return uint32_t Mask of all PWM channels used by the leg.
+ */
+static inline uint32_t GetSingleLegMask(inverter3Ph_config_t* config, uint16_t pwmNo)
+{
+	return ((config->legType == LEG_TNPC ? 15U : 3U) << (pwmNo - 1));
+}
+
+/**
+ * @brief Get the PWM mask for all legs of the inverter.
+ * @param *config Pointer to the Inverter Configurations.
+ * @return uint32_t Mask of all PWM channels used by the inverter.
+ */
+static uint32_t GetInverterMask(inverter3Ph_config_t* config)
+{
+	uint32_t mask = GetSingleLegMask(config, config->s1PinNos[0]) |
+			GetSingleLegMask(config, config->s1PinNos[1]) |
+			GetSingleLegMask(config, config->s1PinNos[2]);
+	if (config->s1PinDuplicate)
+		mask |= GetSingleLegMask(config, config->s1PinDuplicate);
+	return mask;
+}
+
 /**
  * @brief Enable/Disable the PWMs for a single leg of the inverter.
  * @param *config Pointer to the Inverter Configurations.
@@ -105,7 +152,7 @@ static DutyCycleUpdateFnc ConfigSingleLeg(inverter3Ph_config_t* config, uint16_t
  */
 static void EnableSingleLeg(inverter3Ph_config_t* config, uint16_t pwmNo, bool en)
 {
-	BSP_PWMOut_Enable(((config->legType == LEG_TNPC ? 15U : 3U) << (pwmNo - 1)) , en);
+	BSP_PWMOut_Enable(GetSingleLegMask(config, pwmNo), en);
 }
 
 /**
@@ -132,6 +179,7 @@ void Inverter3Ph_Init(inverter3Ph_config_t* config)
 		config->updateCallbackDuplicate = ConfigSingleLeg(config, config->s1PinDuplicate);
 		config->updateCallbackDuplicate(config->s1PinDuplicate, 0.5f, &config->pwmConfig);
 	}
+	config->isFastUpdate = CreateDutyHandles(config);
 
 	// enable the pwm signals by disabling any disable feature. Disable is by default active high
 	for (int i = 0; i < config->dsblPinCount; i++)
@@ -143,17 +191,36 @@ void Inverter3Ph_Init(inverter3Ph_config_t* config)
 
 /**
  * @brief Update the duty cycles of the inverter.
+ * @note The updates of all legs are held back till the last leg is written,
+ * so that the complete three phase vector is applied in the same PWM period.
  * @param *config Pointer to the Inverter Configurations.
  * @param *duties pointer to the three duty cycles of the inverter (Range 0-1)
  */
 void Inverter3Ph_UpdateDuty(inverter3Ph_config_t* config, float* duties)
 {
-	for (int i = 0; i < 3; i++)
-		config->updateCallbacks[i](config->s1PinNos[i], duties[i], &config->pwmConfig);
+	uint32_t pwmMask = GetInverterMask(config);
+	BSP_PWM_HoldUpdates(pwmMask, false);
 
-	// if the duplicate pin is defined also process it
-	if (config->s1PinDuplicate)
-		config->updateCallbackDuplicate(config->s1PinDuplicate, duties[2], &config->pwmConfig);
+	if (config->isFastUpdate)
+	{
+		for (int i = 0; i < 3; i++)
+			BSP_PWM1_10_UpdateDutyFast(&config->dutyHandles[i], duties[i]);
+
+		// if the duplicate pin is defined also process it
+		if (config->s1PinDuplicate)
+			BSP_PWM1_10_UpdateDutyFast(&config->dutyHandles[3], duties[2]);
+	}
+	else
+	{
+		for (int i = 0; i < 3; i++)
+			config->updateCallbacks[i](config->s1PinNos[i], duties[i], &config->pwmConfig);
+
+		// if the duplicate pin is defined also process it
+		if (config->s1PinDuplicate)
+			config->updateCallbackDuplicate(config->s1PinDuplicate, duties[2], &config->pwmConfig);
+	}
+
+	BSP_PWM_ReleaseUpdates(pwmMask, false);
 }
 
 /**
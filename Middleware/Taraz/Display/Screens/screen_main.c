@@ -72,6 +72,18 @@
 
 #define MEASUREMENT_CH_NAME_FONT	(lv_font_montserrat_22)
 #define MEASUREMENT_TYPE_FONT		(lv_font_montserrat_16)
+
+/**
+ * @brief Number of characters reserved for each text of the measurement and parameter values
+ */
+#define MEASUREMENT_TXT_SIZE		(10)
+#define PARAM_TXT_SIZE				(20)
+#define MEASUREMENT_COUNT			(16)
+/**
+ * @brief Max digits of the parameter values, same as the default text representation
+ */
+#define PARAM_MAX_DIGITS			(7)
+#define PARAM_CELLS_MAX				(CONTROL_CONFS_COUNT > MONITOR_CONFS_COUNT ? CONTROL_CONFS_COUNT : MONITOR_CONFS_COUNT)
 /********************************************************************************
  * Typedefs
  *******************************************************************************/
@@ -97,6 +109,18 @@ static ch_disp_t chDisplay[16];
 static volatile bool isActive;
 static volatile uint8_t tag = TAG_NONE;
 static bool isNotFirstRefresh = false;
+static char measureValueTxts[MEASUREMENT_COUNT * MEASUREMENT_TXT_SIZE];
+static value_format_t measureValueFormats[MEASUREMENT_COUNT];
+#if DRAW_APP_SPECIFIC_VIEW
+#if CONTROL_CONFS_COUNT > 0
+static char controlValueTxts[CONTROL_CONFS_COUNT * PARAM_TXT_SIZE];
+static value_format_t controlValueFormats[CONTROL_CONFS_COUNT];
+#endif
+#if MONITOR_CONFS_COUNT > 0
+static char monitorValueTxts[MONITOR_CONFS_COUNT * PARAM_TXT_SIZE];
+static value_format_t monitorValueFormats[MONITOR_CONFS_COUNT];
+#endif
+#endif
 /********************************************************************************
  * Global Variables
  *******************************************************************************/
@@ -357,67 +381,87 @@ __weak void MainScreen_CreateAppArea(lv_obj_t* parent, int row, int col)
 	/******************************* Parameters *********************************/
 }
 
+#if CONTROL_CONFS_COUNT > 0 || MONITOR_CONFS_COUNT > 0
 /**
- * @brief Refreshes the application dependent area of the main screen.
+ * @brief Get the format of the parameter for batch formatting.
+ * Toggleable parameters and parameters with custom text representation are excluded from batch formatting.
+ * All parameters are excluded if the application overrides the default text representation, see @ref P2PComms_IsDefaultTextFormat().
+ * @param _paramInfo Relevant parameter information.
+ * @param format Format to be filled.
  */
-__weak void MainScreen_RefreshAppArea(void)
+static void GetParameterFormat(data_param_info_t* _paramInfo, value_format_t* format)
 {
-	char txt[20];
-#if CONTROL_CONFS_COUNT > 0
-	for (int i = 0; i < CONTROL_CONFS_COUNT; i++)
+	bool isBatched = P2PComms_IsDefaultTextFormat() && !IsToggleableParameter(_paramInfo) && _paramInfo->Getter_InText == NULL;
+	format->type = isBatched ? _paramInfo->type : DTYPE_COUNT;
+	format->maxDigits = PARAM_MAX_DIGITS;
+	format->precision = (uint8_t)_paramInfo->arg;
+	format->suffix = _paramInfo->unit < UNIT_COUNT ? unitTxts[_paramInfo->unit] : NULL;
+}
+
+/**
+ * @brief Refreshes the parameter cells of the application dependent area.
+ * Parameters with default text representation are formatted in a batch and only the labels with changed text are invalidated.
+ * @param confs Parameters displayed in the cells.
+ * @param vals Buffered values of the parameters.
+ * @param lbls Label or LED objects of the cells.
+ * @param formats Formats of the parameters.
+ * @param txts Text arena of the parameter values.
+ * @param count Number of parameters.
+ */
+static void RefreshParameterCells(data_param_info_t** confs, data_union_t* vals, lv_obj_t** lbls, value_format_t* formats, char* txts, int count)
+{
+	char txt[PARAM_TXT_SIZE];
+	for (int i = 0; i < count; i++)
 	{
+		data_union_t value;
+		value.u32 = 0;
+		GetDataParameter(confs[i], &value);
 		// No need to refresh area if nothing changed
-		if (isNotFirstRefresh)
-		{
-			data_union_t value;
-			GetDataParameter(mainScreenControlConfs[i], &value);
-			if (mainScreenParamDisp.controlVals[i].u32 == value.u32)
-				continue;
-			mainScreenParamDisp.controlVals[i].u32 = value.u32;
-		}
+		bool isChanged = !isNotFirstRefresh || vals[i].u32 != value.u32;
+		vals[i].u32 = value.u32;
+		if (!isNotFirstRefresh)
+			GetParameterFormat(confs[i], &formats[i]);
 
-		// Refresh area
-		if (IsToggleableParameter(mainScreenControlConfs[i]))
+		// Refresh individually if not batched
+		if (formats[i].type != DTYPE_COUNT || !isChanged)
+			continue;
+		if (IsToggleableParameter(confs[i]))
 		{
-			if (MainScreen_GetToggleableParameterValue(mainScreenControlConfs[i]))
-				lv_led_on(mainScreenParamDisp.lblsControl[i]);
+			if (MainScreen_GetToggleableParameterValue(confs[i]))
+				lv_led_on(lbls[i]);
 			else
-				lv_led_off(mainScreenParamDisp.lblsControl[i]);
+				lv_led_off(lbls[i]);
 		}
 		else
 		{
-			GetDataParameter_InText(mainScreenControlConfs[i], txt, true);
-			lv_label_set_text(mainScreenParamDisp.lblsControl[i], txt);
+			GetDataParameter_InText(confs[i], txt, true);
+			lv_label_set_text(lbls[i], txt);
 		}
 	}
-#endif
-#if MONITOR_CONFS_COUNT > 0
-	for (int i = 0; i < MONITOR_CONFS_COUNT; i++)
-	{
-		// No need to refresh area if nothing changed
-		if (isNotFirstRefresh)
-		{
-			data_union_t value;
-			GetDataParameter(mainScreenMonitorConfs[i], &value);
-			if (mainScreenParamDisp.monitorVals[i].u32 == value.u32)
-				continue;
-			mainScreenParamDisp.monitorVals[i].u32 = value.u32;
-		}
 
-		// Refresh area
-		if (IsToggleableParameter(mainScreenMonitorConfs[i]))
-		{
-			if (MainScreen_GetToggleableParameterValue(mainScreenMonitorConfs[i]))
-				lv_led_on(mainScreenParamDisp.lblsMonitor[i]);
-			else
-				lv_led_off(mainScreenParamDisp.lblsMonitor[i]);
-		}
-		else
-		{
-			GetDataParameter_InText(mainScreenMonitorConfs[i], txt, true);
-			lv_label_set_text(mainScreenParamDisp.lblsMonitor[i], txt);
-		}
+	uint32_t changedMask[STRING_BATCH_MASK_WORDS(PARAM_CELLS_MAX)];
+	if (String_FormatBatch(vals, formats, count, txts, PARAM_TXT_SIZE, changedMask) == 0)
+		return;
+	for (int i = 0; i < count; i++)
+	{
+		if (changedMask[i / 32] & (1UL << (i % 32)))
+			lv_label_set_text_static(lbls[i], &txts[i * PARAM_TXT_SIZE]);
 	}
+}
+#endif
+
+/**
+ * @brief Refreshes the application dependent area of the main screen.
+ */
+__weak void MainScreen_RefreshAppArea(void)
+{
+#if CONTROL_CONFS_COUNT > 0
+	RefreshParameterCells(mainScreenControlConfs, mainScreenParamDisp.controlVals, mainScreenParamDisp.lblsControl,
+			controlValueFormats, controlValueTxts, CONTROL_CONFS_COUNT);
+#endif
+#if MONITOR_CONFS_COUNT > 0
+	RefreshParameterCells(mainScreenMonitorConfs, mainScreenParamDisp.monitorVals, mainScreenParamDisp.lblsMonitor,
+			monitorValueFormats, monitorValueTxts, MONITOR_CONFS_COUNT);
 #endif
 	isNotFirstRefresh = true;
 }
@@ -529,6 +573,7 @@ static void MeasurementCell_Create(lv_obj_t * parent, int index)
 	int row = index / 4;
 
 	ch_disp_t* disp = &chDisplay[index];
+	measureValueFormats[index] = (value_format_t){ .type = DTYPE_FLOAT, .maxDigits = 4, .precision = 1, .suffix = NULL };
 
 	disp->lastType = dispMeasures.chMeasures[index].type;
 	disp->lastUnit = UNIT_V;
@@ -624,13 +669,22 @@ static void Unload(void)
 
 static void MeasurementArea_Refresh(void)
 {
-	for (int i = 0; i < 16; i++)
+	data_union_t values[MEASUREMENT_COUNT];
+	for (int i = 0; i < MEASUREMENT_COUNT; i++)
 	{
 		measure_type_t type = dispMeasures.chMeasures[i].type;
 		float* stats = ((float*)&dispMeasures.adcInfo->stats[i]);
-		char txt[10];
-		ftoa_custom(stats[(uint8_t)type], txt, 4, 1);
-		lv_label_set_text(chDisplay[i].lblValue, txt);
+		values[i].f = stats[(uint8_t)type];
+	}
+
+	// only invalidate the labels with changed text
+	uint32_t changedMask[STRING_BATCH_MASK_WORDS(MEASUREMENT_COUNT)];
+	String_FormatBatch(values, measureValueFormats, MEASUREMENT_COUNT, measureValueTxts, MEASUREMENT_TXT_SIZE, changedMask);
+
+	for (int i = 0; i < MEASUREMENT_COUNT; i++)
+	{
+		if (changedMask[i / 32] & (1UL << (i % 32)))
+			lv_label_set_text_static(chDisplay[i].lblValue, &measureValueTxts[i * MEASUREMENT_TXT_SIZE]);
 
 		if (chDisplay[i].lastType == dispMeasures.chMeasures[i].type && chDisplay[i].lastUnit == dispMeasures.adcInfo->units[i])
 			continue;
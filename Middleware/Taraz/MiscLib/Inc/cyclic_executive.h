@@ -0,0 +1,208 @@
+/**
+ ********************************************************************************
+ * @file 		cyclic_executive.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Runs the control tasks at integer sub-multiples of the control rate.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+
+#ifndef CYCLIC_EXECUTIVE_H_
+#define CYCLIC_EXECUTIVE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/** @addtogroup Misc_Library
+ * @{
+ */
+
+/** @defgroup Cyclic_Executive Cyclic Executive
+ * @brief Runs the control tasks at integer sub-multiples of the control rate.
+ * @details The executive is ticked from the ADC callback at the base rate. Each task runs once in
+ * @ref executive_task_t.divider ticks at the tick given by its phase, so that the slow tasks such as
+ * outer voltage loops or relay control are spread over different ticks instead of running together.
+ * The budget of each tick is the time left in the sampling period after the work preceding the executive,
+ * such as the ADC conversion. Set @ref executive_t.periodCycles and pass the start of the period to
+ * @ref Executive_TickFrom() to measure it at each tick, or set a fixed @ref executive_t.budgetCycles.
+ * @code
+ * static executive_t executive = { .periodCycles = 480000000 / 20000 };
+ *
+ * static void ADC_Callback(adc_measures_t* result)
+ * {
+ * 	Executive_TickFrom(&executive, periodStartCycles);
+ * }
+ *
+ * void MainControl_Init(void)
+ * {
+ * 	// current loop at the base rate, voltage loop and relays at 1/10 and 1/100 of the base rate
+ * 	Executive_AddTask(&executive, CurrentLoop, NULL, 1, EXECUTIVE_AUTO_PHASE, 1);
+ * 	Executive_AddTask(&executive, VoltageLoop, NULL, 10, EXECUTIVE_AUTO_PHASE, 1);
+ * 	Executive_AddTask(&executive, RelayControl, NULL, 100, EXECUTIVE_AUTO_PHASE, 1);
+ * }
+ * @endcode
+ * @{
+ */
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "general_header.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+/** @defgroup CyclicExecutive_Exported_Macros Macros
+ * @{
+ */
+/**
+ * @brief Maximum no of tasks in a single executive.
+ */
+#define EXECUTIVE_MAX_TASKS				(12)
+/**
+ * @brief Select the phase of the task automatically to distribute the load evenly over the ticks.
+ */
+#define EXECUTIVE_AUTO_PHASE			(0xFFFF)
+#ifndef EXECUTIVE_GET_CYCLES
+/**
+ * @brief Gets the current time stamp in cycles.
+ * @details Uses the DWT cycle counter by default. Can be replaced by any free running 32-bit counter.
+ * The DWT cycle counter should be started before using the budget monitoring.
+ */
+#define EXECUTIVE_GET_CYCLES()			(DWT->CYCCNT)
+#endif
+/**
+ * @}
+ */
+/********************************************************************************
+ * Typedefs
+ *******************************************************************************/
+/** @defgroup CyclicExecutive_Exported_Typedefs Type Definitions
+ * @{
+ */
+/**
+ * @brief Defines the function called by the executive for a task.
+ * @param arg Argument provided while adding the task.
+ */
+typedef void (*ExecutiveTaskFnc)(void* arg);
+/**
+ * @}
+ */
+/********************************************************************************
+ * Structures
+ *******************************************************************************/
+/** @defgroup CyclicExecutive_Exported_Structures Structures
+ * @{
+ */
+/**
+ * @brief Defines a single task of the executive.
+ */
+typedef struct
+{
+	ExecutiveTaskFnc fnc;		/**< @brief Function to be called */
+	void* arg;					/**< @brief Argument for the function */
+	uint16_t divider;			/**< @brief Task runs once every divider ticks */
+	uint16_t phase;				/**< @brief Tick within the divider at which the task runs (Range 0 to divider - 1) */
+	uint16_t ticksLeft;			/**< @brief Ticks left before the task is due again */
+	uint16_t weight;			/**< @brief Relative execution time of the task, used to select the automatic phase */
+	bool isPending;				/**< @brief <c>true</c> if the task is due but not yet executed */
+	uint32_t runCount;			/**< @brief No of completed runs */
+	uint32_t deferCount;		/**< @brief No of runs deferred to the next tick because the tick budget was consumed */
+	uint32_t maxCycles;			/**< @brief Maximum execution time of the task in cycles */
+} executive_task_t;
+/**
+ * @brief Defines the cyclic executive.
+ * @note Only set the periodCycles or budgetCycles before adding the tasks. All other members are managed by the executive.
+ */
+typedef struct
+{
+	executive_task_t tasks[EXECUTIVE_MAX_TASKS];	/**< @brief Registered tasks in order of execution */
+	uint8_t taskCount;								/**< @brief No of registered tasks */
+	uint32_t periodCycles;							/**< @brief Tick period in cycles. If set, the budget of each tick is the period
+														minus the time before the tick, see @ref Executive_TickFrom() */
+	uint32_t budgetCycles;							/**< @brief Time available in each tick in cycles. Set to 0 to disable budget monitoring.
+														Updated at each tick if periodCycles is set */
+	uint32_t lastPreTickCycles;						/**< @brief Time from the start of the period to the last tick in cycles */
+	uint32_t maxPreTickCycles;						/**< @brief Maximum time from the start of the period to a tick in cycles */
+	uint32_t tickCount;								/**< @brief No of executed ticks */
+	uint32_t overrunCount;							/**< @brief No of ticks exceeding the budget */
+	uint32_t lastTickCycles;						/**< @brief Execution time of the last tick in cycles */
+	uint32_t maxTickCycles;							/**< @brief Maximum execution time of a tick in cycles */
+} executive_t;
+/**
+ * @}
+ */
+/********************************************************************************
+ * Exported Variables
+ *******************************************************************************/
+
+/********************************************************************************
+ * Global Function Prototypes
+ *******************************************************************************/
+/** @defgroup CyclicExecutive_Exported_Functions Functions
+ * @{
+ */
+/**
+ * @brief Adds a task to the executive.
+ * @details Tasks run in the order they are added. For @ref EXECUTIVE_AUTO_PHASE the phase sharing the
+ * ticks with the least weight of the previously added tasks is selected.
+ * @param exec Pointer to the executive.
+ * @param fnc Function to be called.
+ * @param arg Argument for the function.
+ * @param divider Task runs once every divider ticks. Use 1 to run at the base rate.
+ * @param phase Tick within the divider at which the task runs (Range 0 to divider - 1) or @ref EXECUTIVE_AUTO_PHASE.
+ * @param weight Relative execution time of the task. Only used for the automatic phase selection.
+ * @return Pointer to the task if successful, else <c>NULL</c> if the parameters are invalid or no space is left.
+ */
+extern executive_task_t* Executive_AddTask(executive_t* exec, ExecutiveTaskFnc fnc, void* arg, uint16_t divider, uint16_t phase, uint16_t weight);
+/**
+ * @brief Runs the tasks due in the current tick. Call this function at the base rate.
+ * @details Tasks running at the base rate always run. If the budget of the tick is already consumed,
+ * the other due tasks are deferred to the next tick and the overrun is reported in @ref executive_t.overrunCount.
+ * A task deferred for its complete period runs when it is due again, even if the budget is consumed.
+ * @param exec Pointer to the executive.
+ * @return Execution time of the tick in cycles.
+ */
+extern uint32_t Executive_Tick(executive_t* exec);
+/**
+ * @brief Runs the tasks due in the current tick, with the budget measured from the start of the sampling period.
+ * @details If @ref executive_t.periodCycles is set, the budget of the tick is the period minus the time
+ * already spent in the period, e.g. by the ADC conversion and the callback before the tick.
+ * @param exec Pointer to the executive.
+ * @param periodStartCycles Time stamp of the start of the sampling period from @ref EXECUTIVE_GET_CYCLES().
+ * @return Execution time of the tick in cycles.
+ */
+extern uint32_t Executive_TickFrom(executive_t* exec, uint32_t periodStartCycles);
+/**
+ * @brief Resets the timing statistics of the executive and all its tasks.
+ * @param exec Pointer to the executive.
+ */
+extern void Executive_ResetStats(executive_t* exec);
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+
+/**
+ * @}
+ */
+#ifdef __cplusplus
+}
+#endif
+/**
+ * @}
+ */
+/**
+ * @}
+ */
+#endif
+/* EOF */
@@ -46,6 +46,14 @@ extern "C" {
 #pragma GCC diagnostic push
 // turn off the specific warning. Can also use "-Wall"
 #pragma GCC diagnostic ignored "-Wunused-function"
+#ifndef RING_BUFFER_INDEX_ALIGN
+/**
+ * @brief Alignment attribute of the read and write indices.
+ * @details Can be defined by the platform to keep the indices in separate cache lines, when the reader and
+ * the writer run on different cores.
+ */
+#define RING_BUFFER_INDEX_ALIGN
+#endif
 /********************************************************************************
  * Typedefs
  *******************************************************************************/
@@ -61,8 +69,8 @@ extern "C" {
  */
 typedef struct
 {
-	int wrIndex;			/**< @brief Array index at which the next data needs to be placed */
-	int rdIndex;			/**< @brief Array index from which the next data read should be done */
+	int wrIndex RING_BUFFER_INDEX_ALIGN;	/**< @brief Array index at which the next data needs to be placed */
+	int rdIndex RING_BUFFER_INDEX_ALIGN;	/**< @brief Array index from which the next data read should be done */
 	int modulo;				/**< @brief Array Size - 1 */
 } ring_buffer_t;
 /**
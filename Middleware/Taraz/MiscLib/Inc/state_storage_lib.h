@@ -39,7 +39,7 @@ extern "C" {
 client.dataWordLen = xxxxx; // Set it to the number of 32-bit memory units required.
 client.InitStatesFromStorage = xxxxx; // Set the callback to the local function which can initiate local states.
 client.RefreshStates = xxxxx; // Set the callback to the local function which can refresh local states storage if states are updated .
-//Configure the flash sectors in @ref flash_sector_config_t for both sectors.
+//Configure the flash sectors in @ref flash_sector_config_t for all sectors, and set the sector count in @ref state_storage_config_t if more than two sectors are used.
 //Configure the client count in @ref state_storage_config_t
 storage.clientCount = xxxxx;
 //Initialize storage
@@ -58,6 +58,11 @@ StateStorage_Refresh();
  * Defines
  *******************************************************************************/
 #define STORE_WORD_SIZE				(128)
+/** @brief Maximum no of flash sectors which can be used for the state storage */
+#define STATE_STORAGE_MAX_SECTORS	(4)
+/** @brief Maximum no of flash words (32 bytes each) programmed by a single call to @ref StateStorage_Refresh()
+ * while a complete image is being written in the background */
+#define STATE_STORAGE_CHUNK_FLASH_WORDS	(2)
 
 // Computations
 #define STORE_BYTE_SIZE				(STORE_WORD_SIZE * 4)
@@ -118,6 +123,12 @@ static uint32_t RefreshStates(uint32_t* data, uint32_t* indexPtr)
 	 	 	 	 	 	 	 	 	 	 	 	 @param data Buffer to be updated by the client if states have been updated.
 	 	 	 	 	 	 	 	 	 	 	 	 @param indexPtr Pointer for the initial index of the client, used in case of multiple blocks of state storages by a single client.
 	 	 	 	 	 	 	 	 	 	 	 	 @return uint32_t Word count if the data is updated by the client, else 0 */
+	void (*StorageProgress)(uint8_t percent);	/**< @brief Optional callback invoked after each step while the complete image of the states is written in the background.
+	 	 	 	 	 	 	 	 	 	 	 	 @param percent Progress of the image in percent. */
+	void (*StorageCompleted)(void);				/**< @brief Optional callback invoked once the updated states are completely written to the flash. */
+	const uint32_t* defaults;					/**< @brief Optional default states of the client containing @ref dataWordLen words.
+	 	 	 	 	 	 	 	 	 	 	 	 Used as reference for the compressed images, so that only the states differing from the defaults are stored.
+	 	 	 	 	 	 	 	 	 	 	 	 The compressed images are not restored if the defaults of any client change. */
 } state_storage_client_t;
 /**
  * @brief Defines the flash sectors for configuring storage.
@@ -140,16 +151,60 @@ typedef struct
 	uint32_t byteCount;		/**< No of bytes in a sector */
 	uint32_t bank;			/**< Flash Bank */
 	uint32_t* addr;			/**< Sector start address */
+	bool isFaulty;			/**< Set by the module if the sector fails to erase or program. Faulty sectors are skipped in the rotation */
+	uint32_t eraseCount;	/**< No of times the sector has been erased since @ref StateStorage_ResetStats() */
 } flash_sector_config_t;
+/**
+ * @brief Defines the flash operations used by the state storage.
+ * @details The HAL flash driver is used by default. Custom operations can be provided to model the flash device,
+ * e.g. to add program/erase latencies or to inject power failures after any write while testing the storage.
+ * The module verifies the results of all operations by reading back the flash contents.
+ */
+typedef struct
+{
+	bool (*Program)(uint32_t* addr, const uint32_t* data);		/**< @brief Programs a single flash word of 32 bytes.
+																	 @param addr 32 byte aligned address in the flash.
+																	 @param data Data to be programmed.
+																	 @return <c>true</c> if successful, else <c>false</c>. */
+	bool (*Erase)(flash_sector_config_t* sector);				/**< @brief Starts erasing the complete sector without waiting for the completion.
+																	 @param sector Sector to be erased.
+																	 @return <c>true</c> if the erase is started, else <c>false</c>. */
+	bool (*IsBusy)(flash_sector_config_t* sector);				/**< @brief Checks if an operation is still in progress in the flash bank of the sector.
+																	 @param sector Sector being erased.
+																	 @return <c>true</c> if the operation is in progress, else <c>false</c>. */
+} state_storage_flash_ops_t;
+/**
+ * @brief Contains the statistics of the state storage.
+ * @details Timings are measured with the DWT cycle counter, which is started by @ref StateStorage_ResetStats().
+ */
+typedef struct
+{
+	uint32_t programCount;		/**< No of flash words programmed */
+	uint32_t recordCount;		/**< No of partial records appended to the journals */
+	uint32_t imageCount;		/**< No of complete images written at the sector start or checkpoints */
+	uint32_t compactionCount;	/**< No of times the states have been moved to the next sector */
+	uint32_t eraseCount;		/**< No of sectors erased */
+	uint32_t failureCount;		/**< No of failed program or erase operations */
+	uint32_t savedWordCount;	/**< No of words saved by compressing the complete images */
+	uint32_t initCycles;		/**< CPU cycles taken by @ref StateStorage_Init() */
+	uint32_t maxProgramCycles;	/**< Maximum CPU cycles taken to program a single flash word */
+	uint32_t maxEraseCycles;	/**< Maximum CPU cycles between the start and completion of a sector erase */
+	uint32_t maxRefreshCycles;	/**< Maximum CPU cycles taken by @ref StateStorage_Refresh(), i.e. the worst case blocking interval */
+} state_storage_stats_t;
 /**
  * @brief Defines the state storage configuration.
  */
 typedef struct
 {
-	flash_sector_config_t sectors[2];	/**< Both sectors' information */
+	flash_sector_config_t sectors[STATE_STORAGE_MAX_SECTORS];	/**< Sectors' information. Only the first @ref sectorCount sectors are used */
+	int sectorCount;					/**< No of sectors used in rotation for the storage. If 0, two sectors are used */
 	int clientCount;					/**< No of clients for the module */
 	state_storage_client_t* clients;	/**< Client configuration */
 	uint32_t store[STORE_WORD_SIZE];	/**< Data storage for clients' states */
+	uint32_t flashStore[STORE_WORD_SIZE];	/**< Copy of the clients' states available in the flash. Used to journal only the changed words */
+	const state_storage_flash_ops_t* flashOps;	/**< Flash operations. If NULL, the HAL flash driver is used */
+	bool isCompressionEnabled;			/**< Compress the complete images against the clients' default states. Both formats are always readable */
+	state_storage_stats_t stats;		/**< Statistics of the storage, updated by the module */
 } state_storage_config_t;
 /**
  * @}
@@ -166,11 +221,12 @@ typedef struct
  */
 /**
  * @brief This function initializes the state storage according to the application requirements.
- * @details This function utilizes two distinct sectors to retrieve the states of all system components.
- * By using a ping-pong approach, only one sector is active at a time for updating the states.
- * The first packet within each sector either remains empty or contains the states of all system components.
- * If the first packet is not present, the sector is considered empty and will be promptly erased if it hasn't
- * been already. Following the initial packet, subsequent partial data packets are used to update the system states.
+ * @details This function utilizes @ref state_storage_config_t.sectorCount distinct sectors to retrieve the states of all system components.
+ * The sectors are used in a rotation, and only one sector is active at a time for updating the states.
+ * Each used sector starts with a header containing the generation of the image, followed by a packet containing
+ * the states of all system components. The valid sector with the highest generation is used to restore the states,
+ * while older sectors are used only if the newer ones are corrupted. The next sector in the rotation is erased
+ * if it hasn't been already. Following the initial packet, subsequent partial data packets are used to update the system states.
  * @code
 static state_storage_config_t storageConfig = {0};
 // Initialize both sectors
@@ -232,12 +288,24 @@ extern void StateStorage_Init(state_storage_config_t* _config);
  * @brief Refreshes the storage state if required.
  * @details Poll this function periodically to refresh the stored states for all parameters. If the index in the
  * sector is 0 or the packet cannot fit within the remaining space in the sector, the \"isFirstSectorPacket\" flag
- * is set. This flag ensures that all parameters are completely flushed to the beginning of the sector.
+ * is set. This flag ensures that all parameters are completely flushed to the beginning of the next sector in the rotation.
  * To obtain the necessary data, each client is prompted to refresh their states using the @ref state_storage_client_t.RefreshStates() function.
  * It is the responsibility of the client to provide the refreshed data, if necessary, and return the size of
- * the updated data. Finally, the partial data will be flushed to the storage flash.
+ * the updated data. Only the words differing from the flash contents are then appended to the journal as a CRC protected record.
+ * While a background operation is in progress (see @ref StateStorage_IsBusy()), each call only advances that operation
+ * by a single bounded step and the clients are not refreshed, so poll more frequently in this case.
  */
 extern void StateStorage_Refresh(void);
+/**
+ * @brief Checks if a background erase or image write is in progress.
+ * @return <c>true</c> if a background operation is in progress, else <c>false</c>.
+ */
+extern bool StateStorage_IsBusy(void);
+/**
+ * @brief Resets the statistics in @ref state_storage_config_t.stats and the erase counts of all sectors.
+ * @details The DWT cycle counter is also started for the timing measurements.
+ */
+extern void StateStorage_ResetStats(void);
 /********************************************************************************
  * Code
  *******************************************************************************/
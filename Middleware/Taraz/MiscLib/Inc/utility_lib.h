@@ -43,7 +43,16 @@ extern "C" {
 /********************************************************************************
  * Defines
  *******************************************************************************/
-
+/** @defgroup UTILITYLIB_Exported_Macros Macros
+ * @{
+ */
+/**
+ * @brief Number of 32-bit words required by the changed mask of @ref String_FormatBatch() for count items
+ */
+#define STRING_BATCH_MASK_WORDS(count)			(((count) + 31) / 32)
+/**
+ * @}
+ */
 /********************************************************************************
  * Typedefs
  *******************************************************************************/
@@ -51,6 +60,22 @@ extern "C" {
 /********************************************************************************
  * Structures
  *******************************************************************************/
+/** @defgroup UTILITYLIB_Exported_Structures Structures
+ * @{
+ */
+/**
+ * @brief Format information of a value used by @ref String_FormatBatch()
+ */
+typedef struct
+{
+	base_data_type_t type;		/**< @brief Type of the value. Items with unsupported types such as DTYPE_BIT_ACCESS are skipped */
+	uint8_t maxDigits;			/**< @brief Max number of digits to be displayed for floating point values */
+	uint8_t precision;			/**< @brief Precision of floating point values */
+	const char* suffix;			/**< @brief Text appended after the value such as the unit. Use NULL if not required */
+} value_format_t;
+/**
+ * @}
+ */
 
 /********************************************************************************
  * Exported Variables
@@ -79,6 +104,8 @@ extern void CopyString(char *dest, const char *src);
 extern int strcat_custom(char* dest, const char* src, int destLen, bool insertSpace);
 /**
  * @brief This function converts the floating point number to character string
+ * @details The number is rounded to nearest (ties to even) at the displayed decimals using exact
+ * integer arithmetic. Numbers having more integer digits than maxDigits are displayed as "d.de<exp>".
  * @param f Single precision floating point number to be converted
  * @param txt Pointer to the string
  * @param maxDigits Max number of digits to be displayed
@@ -86,11 +113,27 @@ extern int strcat_custom(char* dest, const char* src, int destLen, bool insertSp
  * @return Number of characters in the string
  */
 extern int ftoa_custom(float f, char* txt, int maxDigits, int precision);
+/**
+ * @brief This function converts the floating point number to the shortest character string
+ * that converts back to the same single precision number.
+ * @details The decimal candidates are verified against the rounding interval of the number
+ * in double precision, which is exact for magnitudes between 1e-13 and 1e22.
+ * Numbers with decimal exponent in [-5, 9) are displayed without the scientific notation.
+ * The string needs space for at least 16 characters.
+ * @param f Single precision floating point number to be converted
+ * @param txt Pointer to the string
+ * @return Number of characters in the string
+ */
+extern int ftoa_shortest(float f, char* txt);
 /**
  * @brief Custom implementation to convert string to single precision number if possible.
+ * @details The format is [+|-]digits[.digits][(e|E)[+|-]digits] with at least one mantissa digit.
+ * The result is correctly rounded to nearest, ties to even. Up to 19 significant digits are accumulated
+ * in a 64-bit integer for the fast conversion. Close to a rounding midpoint the complete digits are
+ * compared exactly, where digits after the first 120 significant digits only influence exact ties.
  * @param txt Pointer to the text field.
- * @param val Pointer to the single precision value to be updated
- * @return <c>true</c> if successful else <c>false</c>
+ * @param val Pointer to the single precision value to be updated. Not modified on failure
+ * @return <c>true</c> if successful else <c>false</c> for malformed text or overflow
  */
 extern bool atof_custom(const char* txt, float* f);
 /**
@@ -121,6 +164,24 @@ extern int itoa_custom(int32_t val, char* txt);
  * @return Number of characters in the string.
  */
 extern int utoa_custom(uint32_t val, char* txt);
+/**
+ * @brief This function converts the integer number to a character string of fixed minimum width, for aligned display fields.
+ * @param val Value of the integer
+ * @param txt Pointer to the string
+ * @param width Minimum number of characters including the sign. Longer numbers are written completely
+ * @param padChar Padding character e.g. ' ' for right aligned or '0' for leading zeros placed after the sign
+ * @return Number of characters in the string.
+ */
+extern int itoa_padded(int32_t val, char* txt, int width, char padChar);
+/**
+ * @brief This function converts the unsigned integer number to a character string of fixed minimum width, for aligned display fields.
+ * @param val Value of the unsigned integer
+ * @param txt Pointer to the string
+ * @param width Minimum number of characters. Longer numbers are written completely
+ * @param padChar Padding character e.g. ' ' for right aligned or '0' for leading zeros
+ * @return Number of characters in the string.
+ */
+extern int utoa_padded(uint32_t val, char* txt, int width, char padChar);
 /**
  * @brief Custom implementation to convert string to integer if possible.
  * @param txt Text representation
@@ -135,6 +196,21 @@ extern bool atoi_custom(const char *txt, int32_t *result);
  * @return <c>true</c> if successful else <c>false</c>
  */
 extern bool atou_custom(const char *txt, uint32_t *result);
+/**
+ * @brief Formats a batch of values into a preallocated arena of strings, and reports the strings that changed.
+ * @details Each item occupies itemSize characters in the arena, starting at index * itemSize.
+ * The arena retains the previous strings, so only items whose text differs are rewritten and marked as changed.
+ * Items with unsupported types are skipped and never marked. Strings longer than itemSize - 1 are truncated.
+ * @param values Values to be formatted
+ * @param formats Format information of each value
+ * @param count Number of values
+ * @param arena Arena of count * itemSize characters containing the strings
+ * @param itemSize Number of characters reserved for each item including the null-terminator
+ * @param changedMask Bit mask of the changed items of @ref STRING_BATCH_MASK_WORDS(count) words.
+ * Bit (index % 32) of word (index / 32) is set if the text of the item changed
+ * @return Number of changed items
+ */
+extern int String_FormatBatch(const data_union_t* values, const value_format_t* formats, int count, char* arena, int itemSize, uint32_t* changedMask);
 /********************************************************************************
  * Code
  *******************************************************************************/
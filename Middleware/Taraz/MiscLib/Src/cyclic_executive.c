@@ -0,0 +1,234 @@
+/**
+ ********************************************************************************
+ * @file    	cyclic_executive.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Runs the control tasks at integer sub-multiples of the control rate.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "cyclic_executive.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+
+/********************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/********************************************************************************
+ * Structures
+ *******************************************************************************/
+
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+
+/********************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+/**
+ * @brief Gets the greatest common divisor of two numbers.
+ * @param a First number.
+ * @param b Second number.
+ * @return Greatest common divisor.
+ */
+static uint32_t GetGCD(uint32_t a, uint32_t b)
+{
+	while (b)
+	{
+		uint32_t t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+/**
+ * @brief Selects the phase for which the new task shares the ticks with the least weight of the existing tasks.
+ * @details Two tasks with dividers d1, d2 and phases p1, p2 run in the same tick only if p1 and p2 are equal
+ * modulo gcd(d1, d2). In that case gcd(d1, d2) / d2 of the runs of the new task coincide with the other task.
+ * @param exec Pointer to the executive.
+ * @param divider Divider of the new task.
+ * @return Selected phase.
+ */
+static uint16_t SelectPhase(executive_t* exec, uint16_t divider)
+{
+	uint16_t bestPhase = 0;
+	float bestLoad = 0;
+	for (uint16_t phase = 0; phase < divider; phase++)
+	{
+		float load = 0;
+		for (int i = 0; i < exec->taskCount; i++)
+		{
+			executive_task_t* task = &exec->tasks[i];
+			uint32_t gcd = GetGCD(divider, task->divider);
+			if ((phase % gcd) == (task->phase % gcd))
+				load += task->weight * ((float)gcd / task->divider);
+		}
+		if (phase == 0 || load < bestLoad)
+		{
+			bestLoad = load;
+			bestPhase = phase;
+		}
+	}
+	return bestPhase;
+}
+
+/**
+ * @brief Adds a task to the executive.
+ * @details Tasks run in the order they are added. For @ref EXECUTIVE_AUTO_PHASE the phase sharing the
+ * ticks with the least weight of the previously added tasks is selected.
+ * @param exec Pointer to the executive.
+ * @param fnc Function to be called.
+ * @param arg Argument for the function.
+ * @param divider Task runs once every divider ticks. Use 1 to run at the base rate.
+ * @param phase Tick within the divider at which the task runs (Range 0 to divider - 1) or @ref EXECUTIVE_AUTO_PHASE.
+ * @param weight Relative execution time of the task. Only used for the automatic phase selection.
+ * @return Pointer to the task if successful, else <c>NULL</c> if the parameters are invalid or no space is left.
+ */
+executive_task_t* Executive_AddTask(executive_t* exec, ExecutiveTaskFnc fnc, void* arg, uint16_t divider, uint16_t phase, uint16_t weight)
+{
+	if (exec->taskCount >= EXECUTIVE_MAX_TASKS || fnc == NULL || divider == 0)
+		return NULL;
+	if (phase == EXECUTIVE_AUTO_PHASE)
+		phase = SelectPhase(exec, divider);
+	else if (phase >= divider)
+		return NULL;
+
+	executive_task_t* task = &exec->tasks[exec->taskCount];
+	memset(task, 0, sizeof(executive_task_t));
+	task->fnc = fnc;
+	task->arg = arg;
+	task->divider = divider;
+	task->phase = phase;
+	task->weight = weight;
+	/* align with the ticks already executed */
+	task->ticksLeft = (phase + divider - (exec->tickCount % divider)) % divider;
+	exec->taskCount++;
+	return task;
+}
+
+/**
+ * @brief Runs the tasks due in the current tick. Call this function at the base rate.
+ * @details Tasks running at the base rate always run. If the budget of the tick is already consumed,
+ * the other due tasks are deferred to the next tick and the overrun is reported in @ref executive_t.overrunCount.
+ * A task deferred for its complete period runs when it is due again, even if the budget is consumed.
+ * @param exec Pointer to the executive.
+ * @return Execution time of the tick in cycles.
+ */
+TCritical uint32_t Executive_Tick(executive_t* exec)
+{
+	return Executive_TickFrom(exec, EXECUTIVE_GET_CYCLES());
+}
+
+/**
+ * @brief Runs the tasks due in the current tick, with the budget measured from the start of the sampling period.
+ * @details If @ref executive_t.periodCycles is set, the budget of the tick is the period minus the time
+ * already spent in the period, e.g. by the ADC conversion and the callback before the tick.
+ * @param exec Pointer to the executive.
+ * @param periodStartCycles Time stamp of the start of the sampling period from @ref EXECUTIVE_GET_CYCLES().
+ * @return Execution time of the tick in cycles.
+ */
+TCritical uint32_t Executive_TickFrom(executive_t* exec, uint32_t periodStartCycles)
+{
+	uint32_t tickStart = EXECUTIVE_GET_CYCLES();
+	bool isOverrun = false;
+
+	if (exec->periodCycles)
+	{
+		uint32_t preTickCycles = tickStart - periodStartCycles;
+		exec->lastPreTickCycles = preTickCycles;
+		if (preTickCycles > exec->maxPreTickCycles)
+			exec->maxPreTickCycles = preTickCycles;
+		// a period already consumed leaves the minimum budget, so only the base rate tasks run
+		exec->budgetCycles = preTickCycles < exec->periodCycles ? exec->periodCycles - preTickCycles : 1;
+	}
+
+	for (int i = 0; i < exec->taskCount; i++)
+	{
+		executive_task_t* task = &exec->tasks[i];
+		bool isLate = false;
+		if (task->ticksLeft == 0)
+		{
+			/* still pending from the previous period, so run it regardless of the budget */
+			isLate = task->isPending;
+			task->isPending = true;
+			task->ticksLeft = task->divider - 1;
+		}
+		else
+			task->ticksLeft--;
+
+		if (!task->isPending)
+			continue;
+
+		uint32_t start = EXECUTIVE_GET_CYCLES();
+		if (!isLate && exec->budgetCycles && task->divider > 1 && (start - tickStart) >= exec->budgetCycles)
+		{
+			task->deferCount++;
+			isOverrun = true;
+			continue;
+		}
+		task->fnc(task->arg);
+		uint32_t cycles = EXECUTIVE_GET_CYCLES() - start;
+		if (cycles > task->maxCycles)
+			task->maxCycles = cycles;
+		task->runCount++;
+		task->isPending = false;
+	}
+
+	uint32_t tickCycles = EXECUTIVE_GET_CYCLES() - tickStart;
+	if (exec->budgetCycles && tickCycles > exec->budgetCycles)
+		isOverrun = true;
+	if (isOverrun)
+		exec->overrunCount++;
+	if (tickCycles > exec->maxTickCycles)
+		exec->maxTickCycles = tickCycles;
+	exec->lastTickCycles = tickCycles;
+	exec->tickCount++;
+	return tickCycles;
+}
+
+/**
+ * @brief Resets the timing statistics of the executive and all its tasks.
+ * @param exec Pointer to the executive.
+ */
+void Executive_ResetStats(executive_t* exec)
+{
+	for (int i = 0; i < exec->taskCount; i++)
+	{
+		exec->tasks[i].runCount = 0;
+		exec->tasks[i].deferCount = 0;
+		exec->tasks[i].maxCycles = 0;
+	}
+	exec->overrunCount = 0;
+	exec->lastTickCycles = 0;
+	exec->maxTickCycles = 0;
+	exec->lastPreTickCycles = 0;
+	exec->maxPreTickCycles = 0;
+}
+
+/* EOF */
@@ -18,10 +18,31 @@
  *                        www.opensource.org/licenses/BSD-3-Clause</center>
  *
  * @details
- * This file uses two memory sectors to record the required states of the program.
- * First call @ref StateStorage_Init() to initialize the library according to the
+ * This file rotates the storage across two or more memory sectors to record the
+ * required states of the program. First call @ref StateStorage_Init() to initialize the library according to the
  * application requirements. Periodically call StateStorage_Refresh() to update the
  * application state storage whenever needed.
+ *
+ * The active sector is used as a journal. Each record in the sector has the format
+ * [len, index, data[len], crc, padding, len] where the crc is computed over the
+ * len, index and data words. Only the changed words are appended to the journal,
+ * while the complete image is written to the alternate sector only when the active
+ * sector is full. Each image is written to the next sector in the rotation with an
+ * incremented generation counter in the sector header, so that all sectors see the
+ * same number of erase cycles and the newest valid image is selected at startup.
+ * The complete image is also written at fixed checkpoints within the sector, and the
+ * journal records never cross a checkpoint. At startup the last checkpoint is located
+ * with a binary search, so only the records following it need to be replayed.
+ * Sector erases and complete images are processed in the background across multiple
+ * calls to @ref StateStorage_Refresh(), programming at most @ref STATE_STORAGE_CHUNK_FLASH_WORDS
+ * flash words per call, so that the calling task is never blocked for a complete operation.
+ * If @ref state_storage_config_t.isCompressionEnabled is set, the complete images are stored
+ * as the difference from the clients' default states, with the runs of unchanged words removed.
+ * The compressed images also store the CRC of the default states they were compressed against, so that
+ * an image compressed against the defaults of another firmware is treated as invalid and the older images
+ * or the defaults are used instead.
+ * If no sector of the current format is found, the states written by the previous two sector
+ * format are imported once and rewritten in the current format by the next refresh.
  ********************************************************************************
  */
 
@@ -34,29 +55,76 @@
  *******************************************************************************/
 #define EMPTY_WORD						(0xFFFFFFFF)
 #define HEADER_WORD_SIZE				(2)
-#define FOOTER_WORD_SIZE				(1)
+#define FOOTER_WORD_SIZE				(2)
 #define FLASH_BYTE_ALIGNMENT			(32)
 #define STORAGE_HEADER_VALUE			(0xA5A5A5A5)
 #define STORAGE_FOOTER_VALUE			(0x5A5A5A5A)
+#define CRC_INITIAL_VALUE				(0xFFFFFFFF)
+#define SECTOR_HEADER_VALUE				(0x53544F52)
 
 // Computations
 #define EXTRA_WORDS						(HEADER_WORD_SIZE + FOOTER_WORD_SIZE)
 #define FLASH_WORD_ALIGNMENT			(FLASH_BYTE_ALIGNMENT / 4)
 #define GET_FLASH_ALIGNED_SIZE(size)	((size + EXTRA_WORDS - 1) + (FLASH_WORD_ALIGNMENT - ((size + EXTRA_WORDS - 1) % FLASH_WORD_ALIGNMENT)))
 #define GET_LOCAL_LEN(size)				(size ? size + 2 : 0)
+#define SECTOR_HEADER_WORD_SIZE			(FLASH_WORD_ALIGNMENT)
+/** @brief Distance in words between consecutive checkpoints in a sector */
+#define CHECKPOINT_WORD_INTERVAL		(2048)
+#define FLASH_TIMEOUT_MS				(50000U)
+/** @brief Set in the index of the records containing compressed images */
+#define RECORD_FLAG_COMPRESSED			(0x80000000U)
+#define RLE_MAX_COUNT					(0xFFFFU)
+/** @brief Flash aligned size of the records [len, index, data[len], padding, len] written by the previous two sector format */
+#define GET_LEGACY_ALIGNED_SIZE(size)	((size + 2) + (FLASH_WORD_ALIGNMENT - ((size + 2) % FLASH_WORD_ALIGNMENT)))
+
+#if (CHECKPOINT_WORD_INTERVAL % FLASH_WORD_ALIGNMENT) || (CHECKPOINT_WORD_INTERVAL <= GET_FLASH_ALIGNED_SIZE(STORE_WORD_SIZE))
+#error "Invalid checkpoint interval."
+#endif
 /********************************************************************************
  * Typedefs
  *******************************************************************************/
+/**
+ * @brief Background operations of the state storage.
+ */
+typedef enum
+{
+	STORAGE_STATE_IDLE,				/**< No background operation in progress */
+	STORAGE_STATE_ERASING,			/**< A sector is being erased */
+	STORAGE_STATE_WRITING_IMAGE,	/**< The complete image of the states is being written */
+} storage_state_t;
 
 /********************************************************************************
  * Structures
  *******************************************************************************/
+/**
+ * @brief Describes a single journal record while it is being written to the flash.
+ */
+typedef struct
+{
+	const uint32_t* data;		/**< Source of the data words */
+	uint32_t index;				/**< Index of the data in the store */
+	uint32_t wordSize;			/**< No of data words */
+	uint32_t crc;				/**< CRC of the length, index and data words */
+	uint32_t packetWordSize;	/**< Flash aligned size of the record */
+} storage_record_t;
 
 /********************************************************************************
  * Static Variables
  *******************************************************************************/
 static state_storage_config_t* config;
 static int sectorIndex = -1;
+static int sectorCount = 2;
+static uint32_t generation = 0;
+static const state_storage_flash_ops_t* flashOps;
+static storage_state_t state = STORAGE_STATE_IDLE;
+static int targetIndex = -1;
+static bool isImagePending = false;
+static bool isNewSectorImage = false;
+static storage_record_t image;
+static uint32_t imageWordNo = 0;
+static uint32_t eraseStartCycles = 0;
+static uint32_t compressedStore[STORE_WORD_SIZE];
+static uint32_t defaultsCrc = 0;
 /********************************************************************************
  * Global Variables
  *******************************************************************************/
@@ -64,6 +132,10 @@ static int sectorIndex = -1;
 /********************************************************************************
  * Function Prototypes
  *******************************************************************************/
+static void PrepareNextSector(void);
+static void CompactStates(void);
+static void CompleteImageWrite(bool _isSuccessful);
+static void CompleteErase(bool _isSuccessful);
 
 /********************************************************************************
  * Code
@@ -93,28 +165,42 @@ static bool IsSectorErased(flash_sector_config_t* sector)
 	return true;
 }
 
-static void EraseSector(flash_sector_config_t* sector)
+static bool Storage_ProgramFlashWord(uint32_t* addr, const uint32_t* data)
 {
-	sector->index = 0;
+	return HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD, (uint32_t)addr, (uint32_t)data) == HAL_OK;
+}
+
+static bool Storage_EraseSector(flash_sector_config_t* sector)
+{
+	if (FLASH_WaitForLastOperation(FLASH_TIMEOUT_MS, sector->bank) != HAL_OK)
+		return false;
 	FLASH_Erase_Sector(sector->sectorNo, sector->bank, FLASH_VOLTAGE_RANGE_4);
+	return true;
 }
 
-static void EraseSectorIfRequired(flash_sector_config_t* sector)
+static bool Storage_IsFlashBusy(flash_sector_config_t* sector)
 {
-	sector->index = 0;
-	if (IsSectorErased(sector) == false)
-		EraseSector(sector);
+	// poll without waiting
+	if (FLASH_WaitForLastOperation(0, sector->bank) == HAL_TIMEOUT)
+		return true;
+	// disable the sector erase once completed
+	if (sector->bank == FLASH_BANK_1)
+		FLASH->CR1 &= ~(FLASH_CR_SER | FLASH_CR_SNB);
+	else
+		FLASH->CR2 &= ~(FLASH_CR_SER | FLASH_CR_SNB);
+	return false;
 }
 
-static int GetSectorWordCount(flash_sector_config_t* sector)
+static const state_storage_flash_ops_t halFlashOps =
 {
-	int wordSize = GetSectorWordSize(sector);
-	while (wordSize--)
-	{
-		if(sector->addr[wordSize] != EMPTY_WORD)
-			break;
-	}
-	return wordSize + 1;
+		.Program = Storage_ProgramFlashWord,
+		.Erase = Storage_EraseSector,
+		.IsBusy = Storage_IsFlashBusy,
+};
+
+static inline int GetNextSector(int _sectorIndex)
+{
+	return (_sectorIndex + 1) % sectorCount;
 }
 
 static int GetSectorWordsLeft(flash_sector_config_t* sector)
@@ -128,102 +214,385 @@ static int HasEnoughSpace(flash_sector_config_t* sector, int wordSize)
 	return GetSectorWordsLeft(sector) > GET_FLASH_ALIGNED_SIZE(wordSize);
 }
 
-static bool IsFirstSectorPacketValid(flash_sector_config_t* _sector)
+static inline uint32_t GetCheckpointIndex(int checkpoint)
+{
+	return SECTOR_HEADER_WORD_SIZE + (checkpoint * CHECKPOINT_WORD_INTERVAL);
+}
+
+static inline int GetCheckpointCount(flash_sector_config_t* sector)
+{
+	return ((GetSectorWordSize(sector) - SECTOR_HEADER_WORD_SIZE - 1) / CHECKPOINT_WORD_INTERVAL) + 1;
+}
+
+static uint32_t GetNextCheckpointIndex(uint32_t index)
+{
+	return GetCheckpointIndex((index - SECTOR_HEADER_WORD_SIZE + CHECKPOINT_WORD_INTERVAL - 1) / CHECKPOINT_WORD_INTERVAL);
+}
+
+static inline bool IsCompactionRequired(flash_sector_config_t* sector)
+{
+	return sector->index == 0 || GetSectorWordsLeft(sector) <= 0;
+}
+
+/**
+ * @brief Computes the CRC-32 (IEEE 802.3) of the given words.
+ * @param _data Pointer to the data words.
+ * @param _wordCount No of words to be included in the CRC.
+ * @param _crc Initial value of the CRC. Use the returned value to chain multiple blocks.
+ * @return Computed CRC (without final inversion).
+ */
+static uint32_t GetCrc(const uint32_t* _data, uint32_t _wordCount, uint32_t _crc)
+{
+	static const uint32_t crcTable[16] =
+	{
+			0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+			0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+	};
+	const uint8_t* bytes = (const uint8_t*)_data;
+	uint32_t byteCount = _wordCount * 4;
+	while (byteCount--)
+	{
+		_crc ^= *bytes++;
+		_crc = (_crc >> 4) ^ crcTable[_crc & 0xF];
+		_crc = (_crc >> 4) ^ crcTable[_crc & 0xF];
+	}
+	return _crc;
+}
+
+static bool IsRecordValid(const uint32_t* _addr0, const uint32_t* _endAddr)
+{
+	uint32_t dataLen = _addr0[0];
+	if (dataLen > STORE_WORD_SIZE || dataLen == 0)
+		return false;
+	uint32_t packetSize = GET_FLASH_ALIGNED_SIZE(dataLen);
+	// both start and end lengths should match
+	if ((_addr0 + packetSize) > _endAddr || _addr0[packetSize - 1] != dataLen)
+		return false;
+	// the compressed flag is only valid on its own, as the index of the journal records is used for copying
+	if (_addr0[1] & RECORD_FLAG_COMPRESSED)
+	{
+		if (_addr0[1] != RECORD_FLAG_COMPRESSED)
+			return false;
+	}
+	else if (_addr0[1] > (STORE_WORD_SIZE - dataLen))
+		return false;
+	return ~GetCrc(_addr0, dataLen + HEADER_WORD_SIZE, CRC_INITIAL_VALUE) == _addr0[dataLen + HEADER_WORD_SIZE];
+}
+
+static bool IsSectorHeaderValid(flash_sector_config_t* _sector)
 {
 	uint32_t* addr0 = _sector->addr;
-	uint32_t packageSize = GET_FLASH_ALIGNED_SIZE(STORE_WORD_SIZE);
+	return addr0[0] == SECTOR_HEADER_VALUE && addr0[1] == ~addr0[2];
+}
+
+static bool IsImageValid(flash_sector_config_t* _sector, uint32_t _index)
+{
+	uint32_t* addr0 = _sector->addr + _index;
 
+	// compressed images are only valid for the same default states, the tokens are validated while decompressing
+	if (addr0[1] == RECORD_FLAG_COMPRESSED)
+		return IsRecordValid(addr0, _sector->addr + GetSectorWordSize(_sector)) && addr0[HEADER_WORD_SIZE] == defaultsCrc;
 
 	return (addr0[0] != STORE_WORD_SIZE ||
-			addr0[packageSize - 1] != STORE_WORD_SIZE ||
 			addr0[1] != 0 ||
-			addr0[2] != STORAGE_HEADER_VALUE) ? false : true; //addr0[STORE_WORD_SIZE + 3] != STORAGE_FOOTER_VALUE
+			addr0[2] != STORAGE_HEADER_VALUE ||
+			IsRecordValid(addr0, _sector->addr + GetSectorWordSize(_sector)) == false) ? false : true;
 }
 
-static int GetInitialSector(void)
+/**
+ * @brief Gets the default value of a word in the store.
+ * @details Local headers and footers of the clients default to their markers, while the client states
+ * default to @ref state_storage_client_t.defaults if available, else 0.
+ * @param _index Index of the word in the store.
+ * @return Default value of the word.
+ */
+static uint32_t GetDefaultWord(uint32_t _index)
 {
-	bool isSectorValid[2];
-	int _sectorIndex = -1;
-	int sectorCount[2];
-	isSectorValid[0] = IsFirstSectorPacketValid(&config->sectors[0]);
-	isSectorValid[1] = IsFirstSectorPacketValid(&config->sectors[1]);
+	for (int i = 0; i < config->clientCount; i++)
+	{
+		state_storage_client_t* client = &config->clients[i];
+		uint32_t localLen = GET_LOCAL_LEN(client->dataWordLen);
+		if (_index < localLen)
+		{
+			if (_index == 0)
+				return STORAGE_HEADER_VALUE;
+			if (_index == localLen - 1)
+				return STORAGE_FOOTER_VALUE;
+			return client->defaults ? client->defaults[_index - 1] : 0;
+		}
+		_index -= localLen;
+	}
+	return 0;
+}
 
-	// if both sectors have valid data select the one to use and erase the other one if required
-	if (isSectorValid[0] && isSectorValid[1])
+static inline uint32_t GetDeltaWord(uint32_t _index)
+{
+	return config->store[_index] ^ GetDefaultWord(_index);
+}
+
+/**
+ * @brief Computes the CRC of the default values of the complete store.
+ * @return CRC of the default values.
+ */
+static uint32_t GetDefaultsCrc(void)
+{
+	uint32_t crc = CRC_INITIAL_VALUE;
+	for (uint32_t i = 0; i < STORE_WORD_SIZE; i++)
 	{
-		sectorCount[0] = GetSectorWordCount(&config->sectors[0]);
-		sectorCount[1] = GetSectorWordCount(&config->sectors[1]);
+		uint32_t word = GetDefaultWord(i);
+		crc = GetCrc(&word, 1, crc);
+	}
+	return ~crc;
+}
 
-		_sectorIndex = sectorCount[0] < sectorCount[1] ? 0 : 1;
-		EraseSectorIfRequired(&config->sectors[_sectorIndex == 0 ? 1 : 0]);
+/**
+ * @brief Compresses the store in @ref compressedStore.
+ * @details The first word contains the CRC of the default values. Each word is then replaced by its difference (XOR)
+ * from the default value. The resulting words are stored as tokens, each containing the no of default words to be
+ * skipped in the upper 16 bits and the no of following literal words in the lower 16 bits.
+ * The trailing default words are not stored.
+ * @return No of compressed words, or @ref STORE_WORD_SIZE if the store can't be compressed.
+ */
+static uint32_t CompressStore(void)
+{
+	uint32_t len = 0;
+	uint32_t index = 0;
+	compressedStore[len++] = defaultsCrc;
+	while (index < STORE_WORD_SIZE)
+	{
+		uint32_t zeroCount = 0;
+		uint32_t literalCount = 0;
+		while (index < STORE_WORD_SIZE && zeroCount < RLE_MAX_COUNT && GetDeltaWord(index) == 0)
+		{
+			zeroCount++;
+			index++;
+		}
+		if (index == STORE_WORD_SIZE)
+			break;
+		uint32_t tokenIndex = len++;
+		// a single default word is cheaper as a literal than a new token
+		while (index < STORE_WORD_SIZE && literalCount < RLE_MAX_COUNT)
+		{
+			uint32_t delta = GetDeltaWord(index);
+			if (delta == 0 && (index + 1 == STORE_WORD_SIZE || GetDeltaWord(index + 1) == 0))
+				break;
+			if (len >= STORE_WORD_SIZE)
+				return STORE_WORD_SIZE;
+			compressedStore[len++] = delta;
+			literalCount++;
+			index++;
+		}
+		if (len >= STORE_WORD_SIZE)
+			return STORE_WORD_SIZE;
+		compressedStore[tokenIndex] = (zeroCount << 16) | literalCount;
+	}
+	return len;
+}
+
+/**
+ * @brief Decompresses the image compressed by @ref CompressStore() into the store.
+ * @param _src Compressed words.
+ * @param _wordSize No of compressed words.
+ * @return <c>true</c> if the image is decompressed successfully, <c>false</c> if the image is invalid or
+ * compressed against different default values.
+ */
+static bool DecompressStore(const uint32_t* _src, uint32_t _wordSize)
+{
+	const uint32_t* endSrc = _src + _wordSize;
+	uint32_t index = 0;
+	if (*_src++ != defaultsCrc)
+		return false;
+	while (_src < endSrc)
+	{
+		uint32_t zeroCount = *_src >> 16;
+		uint32_t literalCount = *_src++ & RLE_MAX_COUNT;
+		if ((index + zeroCount + literalCount) > STORE_WORD_SIZE || (_src + literalCount) > endSrc)
+			return false;
+		while (zeroCount--)
+		{
+			config->store[index] = GetDefaultWord(index);
+			index++;
+		}
+		while (literalCount--)
+		{
+			config->store[index] = GetDefaultWord(index) ^ *_src++;
+			index++;
+		}
+	}
+	while (index < STORE_WORD_SIZE)
+	{
+		config->store[index] = GetDefaultWord(index);
+		index++;
 	}
-	else if (isSectorValid[0])
+	return true;
+}
+
+static bool IsFirstSectorPacketValid(flash_sector_config_t* _sector)
+{
+	return IsSectorHeaderValid(_sector) && IsImageValid(_sector, GetCheckpointIndex(0));
+}
+
+/**
+ * @brief Gets the last used checkpoint in the sector using a binary search.
+ * @details Checkpoints are written in order, so all used checkpoints precede the unused ones.
+ * @param _sector Sector to be searched.
+ * @return Last used checkpoint.
+ */
+static int GetLastCheckpoint(flash_sector_config_t* _sector)
+{
+	int low = 0;
+	int high = GetCheckpointCount(_sector) - 1;
+	while (low < high)
 	{
-		_sectorIndex = 0;
-		EraseSectorIfRequired(&config->sectors[1]);
+		int mid = (low + high + 1) / 2;
+		if (_sector->addr[GetCheckpointIndex(mid)] != EMPTY_WORD)
+			low = mid;
+		else
+			high = mid - 1;
 	}
-	else if (isSectorValid[1])
+	return low;
+}
+
+/**
+ * @brief Gets the sector with the newest valid image.
+ * @details The generation counter is also updated to the highest generation found in the flash,
+ * so that the new images always supersede the existing ones.
+ * @return Index of the sector with the newest valid image, -1 if no valid image is available.
+ */
+static int GetInitialSector(void)
+{
+	int _sectorIndex = -1;
+	uint32_t latestGeneration = 0;
+	generation = 0;
+	for (int i = 0; i < sectorCount; i++)
+	{
+		flash_sector_config_t* sector = &config->sectors[i];
+		sector->index = 0;
+		sector->isFaulty = false;
+		if (IsSectorHeaderValid(sector) == false)
+			continue;
+		uint32_t sectorGeneration = sector->addr[1];
+		if (sectorGeneration > generation)
+			generation = sectorGeneration;
+		// older valid images are used only if the newer ones are corrupted
+		if (IsFirstSectorPacketValid(sector) && (_sectorIndex == -1 || sectorGeneration > latestGeneration))
 		{
-			_sectorIndex = 1;
-			EraseSectorIfRequired(&config->sectors[0]);
+			_sectorIndex = i;
+			latestGeneration = sectorGeneration;
 		}
-	else
+	}
+	return _sectorIndex;
+}
+
+static bool IsLegacySectorValid(flash_sector_config_t* _sector)
+{
+	uint32_t* addr0 = _sector->addr;
+	return addr0[0] == STORE_WORD_SIZE &&
+			addr0[GET_LEGACY_ALIGNED_SIZE(STORE_WORD_SIZE) - 1] == STORE_WORD_SIZE &&
+			addr0[1] == 0 &&
+			addr0[2] == STORAGE_HEADER_VALUE;
+}
+
+static int GetLegacyUsedWords(flash_sector_config_t* _sector)
+{
+	int wordSize = GetSectorWordSize(_sector);
+	while (wordSize--)
 	{
-		EraseSectorIfRequired(&config->sectors[0]);
-		EraseSectorIfRequired(&config->sectors[1]);
+		if(_sector->addr[wordSize] != EMPTY_WORD)
+			break;
 	}
+	return wordSize + 1;
+}
+
+/**
+ * @brief Imports the states written by the previous two sector format, which had no sector headers and CRCs.
+ * @details Each sector of the previous format starts with the complete image followed by the partial records,
+ * all as [len, index, data[len], padding, len]. If both of the first two sectors are valid, the one with the least
+ * used words is the latest, as the previous format compacted the states into the other sector without erasing the old one.
+ * The imported sector is marked as used, so that the next refresh writes the states in the current format to the next sector.
+ * @return Index of the imported sector, -1 if no sector of the previous format is available.
+ */
+static int ImportLegacySector(void)
+{
+	int _sectorIndex = -1;
+	for (int i = 0; i < 2; i++)
+	{
+		if (IsLegacySectorValid(&config->sectors[i]) &&
+				(_sectorIndex == -1 || GetLegacyUsedWords(&config->sectors[i]) < GetLegacyUsedWords(&config->sectors[_sectorIndex])))
+			_sectorIndex = i;
+	}
+	if (_sectorIndex == -1)
+		return -1;
+
+	flash_sector_config_t* sector = &config->sectors[_sectorIndex];
+	uint32_t* addr = sector->addr;
+	uint32_t* endAddr = addr + GetSectorWordSize(sector);
+	while (addr < endAddr && *addr != EMPTY_WORD)
+	{
+		uint32_t dataLen = addr[0];
+		if (dataLen > STORE_WORD_SIZE || dataLen == 0)
+			break;
+		uint32_t packetSize = GET_LEGACY_ALIGNED_SIZE(dataLen);
+		// both start and end lengths should match
+		if ((addr + packetSize) > endAddr || addr[packetSize - 1] != dataLen)
+			break;
+		// records with invalid index are skipped
+		if (addr[1] <= (STORE_WORD_SIZE - dataLen))
+			memcpy((void*)(config->store + addr[1]), (void*)(addr + HEADER_WORD_SIZE), dataLen * 4);
+		addr += packetSize;
+	}
+	sector->index = GetSectorWordSize(sector);
 	return _sectorIndex;
 }
 
 static void FillDataFromSector(flash_sector_config_t* sector)
 {
-	uint32_t* addr = sector->addr;
-	uint32_t* endAddr = addr + (sector->byteCount / 4);
+	int lastCheckpoint = GetLastCheckpoint(sector);
+	int checkpoint = lastCheckpoint;
+	// Fall back to the older checkpoints if the newer ones are corrupted, the first checkpoint is already validated
+	while (checkpoint > 0 && IsImageValid(sector, GetCheckpointIndex(checkpoint)) == false)
+		checkpoint--;
+	bool isCorrupted = checkpoint != lastCheckpoint;
+
+	uint32_t* addr = sector->addr + GetCheckpointIndex(checkpoint);
+	uint32_t* endAddr = sector->addr + GetSectorWordSize(sector);
 	while(addr < endAddr)
 	{
 		if (*addr == EMPTY_WORD)
 			break;
-		/****** Basic Validation *****/
-		uint32_t* addr0 = addr;
-		int dataLen = *addr++;
-		// Skip further writes in sector if invalid start and end length,
-		// as both should match
-		if (dataLen > STORE_WORD_SIZE || dataLen <= 0)
+		// Stop replaying the journal at the first invalid record, as it may have been interrupted while writing.
+		if (IsRecordValid(addr, endAddr) == false)
 		{
-			addr = endAddr;
+			isCorrupted = true;
 			break;
 		}
-		uint32_t packageSize = GET_FLASH_ALIGNED_SIZE(dataLen);
-		if (addr0[packageSize - 1] != dataLen)
+		uint32_t dataLen = addr[0];
+		if (addr[1] == RECORD_FLAG_COMPRESSED)
 		{
-			addr = endAddr;
-			break;
+			if (DecompressStore(addr + HEADER_WORD_SIZE, dataLen) == false)
+			{
+				isCorrupted = true;
+				break;
+			}
 		}
-		uint32_t index = *addr++;
-		// skip sector
-		if (index > (STORE_WORD_SIZE - dataLen))
-		{
-			addr = endAddr;
-			addr = addr0 + packageSize;
-			continue;
-		}
-		/****** Basic Validation *****/
-		uint32_t* storeLoc = config->store;
-		storeLoc += index;
-		while (dataLen--)
-			*storeLoc++ = *addr++;
-		addr = addr0 + packageSize;
+		else
+			memcpy((void*)(config->store + addr[1]), (void*)(addr + HEADER_WORD_SIZE), dataLen * 4);
+		addr += GET_FLASH_ALIGNED_SIZE(dataLen);
 	}
 	sector->index = addr - sector->addr;
+	// The rest of the sector is marked as used so that the next update compacts the states in the next sector
+	if (isCorrupted)
+		sector->index = GetSectorWordSize(sector);
 }
 
 /**
  * @brief This function initializes the state storage according to the application requirements.
- * @details This function utilizes two distinct sectors to retrieve the states of all system components.
- * By using a ping-pong approach, only one sector is active at a time for updating the states.
- * The first packet within each sector either remains empty or contains the states of all system components.
- * If the first packet is not present, the sector is considered empty and will be promptly erased if it hasn't
- * been already. Following the initial packet, subsequent partial data packets are used to update the system states.
+ * @details This function utilizes @ref state_storage_config_t.sectorCount distinct sectors to retrieve the states of all system components.
+ * The sectors are used in a rotation, and only one sector is active at a time for updating the states.
+ * Each used sector starts with a header containing the generation of the image, followed by a packet containing
+ * the states of all system components. The valid sector with the highest generation is used to restore the states,
+ * while older sectors are used only if the newer ones are corrupted. The next sector in the rotation is erased
+ * if it hasn't been already. Following the initial packet, subsequent partial data packets are used to update the system states.
  * @code
 static state_storage_config_t storageConfig = {0};
 // Initialize both sectors
@@ -283,17 +652,35 @@ StateStorage_Init(&storageConfig);
 void StateStorage_Init(state_storage_config_t* _config)
 {
 	config = _config;
+	flashOps = config->flashOps == NULL ? &halFlashOps : config->flashOps;
+	if (flashOps->Program == NULL || flashOps->Erase == NULL || flashOps->IsBusy == NULL)
+		Error_Handler();
+	state = STORAGE_STATE_IDLE;
+	StateStorage_ResetStats();
+	uint32_t startCycles = DWT->CYCCNT;
+
+	// use two sectors if not specified
+	sectorCount = config->sectorCount == 0 ? 2 : config->sectorCount;
+	if (sectorCount < 2 || sectorCount > STATE_STORAGE_MAX_SECTORS)
+		Error_Handler();
 
 	// force the initial values of each variable to zero.
 	memset((void*)config->store, 0, STORE_BYTE_SIZE);
-	config->sectors[0].index = config->sectors[1].index = 0;
+	// compressed images are only restored with the same default states
+	defaultsCrc = GetDefaultsCrc();
 
 	sectorIndex = GetInitialSector();
 	bool isDataValid = sectorIndex != -1;
 	if (isDataValid)
 		FillDataFromSector(&config->sectors[sectorIndex]);
 	else
-		sectorIndex = 0;
+	{
+		// states saved by the previous firmware are converted once
+		sectorIndex = ImportLegacySector();
+		isDataValid = sectorIndex != -1;
+		if (isDataValid == false)
+			sectorIndex = 0;
+	}
 
 	uint32_t* storeLoc = config->store;
 	for (int i = 0; i < config->clientCount; i++)
@@ -317,56 +704,342 @@ void StateStorage_Init(state_storage_config_t* _config)
 	// Invalid store size, kindly increase store size
 	if ((storeLoc - (uint32_t*)config->store) > STORE_WORD_SIZE)
 		Error_Handler();
+
+	// keep track of the states available in the flash to journal only the changes
+	memcpy((void*)config->flashStore, (void*)config->store, STORE_BYTE_SIZE);
+
+	PrepareNextSector();
+	config->stats.initCycles = DWT->CYCCNT - startCycles;
 }
 
-static void PutDataInFlash(uint32_t* _storeLoc, uint32_t _index, uint32_t _wordSize, bool _isFirstSectorPacket)
+static uint32_t GetRecordWord(const storage_record_t* _record, uint32_t _wordNo)
 {
-	uint32_t packetWordSize = GET_FLASH_ALIGNED_SIZE(_wordSize);
-	if (_isFirstSectorPacket)
-	{
-		if (config->sectors[sectorIndex].index != 0)
-			sectorIndex = sectorIndex == 0 ? 1 : 0;
-	}
+	if (_wordNo == 0 || _wordNo == _record->packetWordSize - 1)
+		return _record->wordSize;
+	if (_wordNo == 1)
+		return _record->index;
+	_wordNo -= HEADER_WORD_SIZE;
+	if (_wordNo < _record->wordSize)
+		return _record->data[_wordNo];
+	return _wordNo == _record->wordSize ? _record->crc : 0;
+}
 
-	if (packetWordSize % FLASH_WORD_ALIGNMENT)
+/**
+ * @brief Programs a single flash word at the current index of the sector and verifies it.
+ * @param _sector Sector to be programmed.
+ * @param _data Flash word to be programmed.
+ * @return <c>true</c> if programmed successfully, else <c>false</c>.
+ */
+static bool ProgramFlashWord(flash_sector_config_t* _sector, const uint32_t* _data)
+{
+	uint32_t* addr = _sector->addr + _sector->index;
+	_sector->index += FLASH_WORD_ALIGNMENT;
+	config->stats.programCount++;
+	uint32_t startCycles = DWT->CYCCNT;
+	bool isProgrammed = flashOps->Program(addr, _data) && memcmp((void*)addr, (void*)_data, FLASH_BYTE_ALIGNMENT) == 0;
+	uint32_t cycles = DWT->CYCCNT - startCycles;
+	if (cycles > config->stats.maxProgramCycles)
+		config->stats.maxProgramCycles = cycles;
+	if (isProgrammed == false)
+		config->stats.failureCount++;
+	return isProgrammed;
+}
+
+static void InitRecord(storage_record_t* _record, const uint32_t* _data, uint32_t _index, uint32_t _wordSize)
+{
+	uint32_t header[HEADER_WORD_SIZE] = { _wordSize, _index };
+	_record->data = _data;
+	_record->index = _index;
+	_record->wordSize = _wordSize;
+	_record->packetWordSize = GET_FLASH_ALIGNED_SIZE(_wordSize);
+	_record->crc = ~GetCrc(_record->data, _wordSize, GetCrc(header, HEADER_WORD_SIZE, CRC_INITIAL_VALUE));
+
+	if (_record->packetWordSize % FLASH_WORD_ALIGNMENT)
 		Error_Handler();
+}
 
-	uint32_t packCount = packetWordSize / FLASH_WORD_ALIGNMENT;
+/**
+ * @brief Initializes the record for the complete image of the states, compressed if enabled and beneficial.
+ * @param _record Record to be initialized.
+ */
+static void InitImageRecord(storage_record_t* _record)
+{
+	uint32_t wordSize = config->isCompressionEnabled ? CompressStore() : STORE_WORD_SIZE;
+	if (wordSize < STORE_WORD_SIZE)
+	{
+		InitRecord(_record, compressedStore, RECORD_FLAG_COMPRESSED, wordSize);
+		config->stats.savedWordCount += STORE_WORD_SIZE - wordSize;
+	}
+	else
+		InitRecord(_record, config->store, 0, STORE_WORD_SIZE);
+	config->stats.imageCount++;
+}
 
-	// Create first word
+/**
+ * @brief Programs the next flash words of the record.
+ * @param _sector Sector to be programmed.
+ * @param _record Record to be programmed.
+ * @param _wordNo Pointer to the next word of the record to be programmed. Updated as the words are programmed.
+ * @param _maxFlashWords Maximum no of flash words to be programmed.
+ * @return <c>true</c> if programmed successfully, else <c>false</c>.
+ */
+static bool ProgramRecord(flash_sector_config_t* _sector, const storage_record_t* _record, uint32_t* _wordNo, uint32_t _maxFlashWords)
+{
+	// Stream the record in flash words to avoid a large local buffer
 	uint32_t data[FLASH_WORD_ALIGNMENT];
-	data[0] = _wordSize;
-	data[1] = _index;
-	uint32_t len = (FLASH_WORD_ALIGNMENT - HEADER_WORD_SIZE);
-	if (packCount == 1)
+	while (*_wordNo < _record->packetWordSize && _maxFlashWords--)
 	{
-		len = _wordSize;
-		data[FLASH_WORD_ALIGNMENT - 1] = _wordSize;
+		for (uint32_t i = 0; i < FLASH_WORD_ALIGNMENT; i++)
+			data[i] = GetRecordWord(_record, *_wordNo + i);
+		if (ProgramFlashWord(_sector, data) == false)
+			return false;
+		*_wordNo += FLASH_WORD_ALIGNMENT;
 	}
-	uint32_t* storeLoc = _storeLoc;
-	for (uint32_t i = 2; i < len + 2; i++)
-		data[i] = *storeLoc++;
-	uint32_t dataLeft = _wordSize - len;
-	HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD, (uint32_t)(config->sectors[sectorIndex].addr + config->sectors[sectorIndex].index), (uint32_t)data);
-	config->sectors[sectorIndex].index += FLASH_WORD_ALIGNMENT;
+	return true;
+}
 
-	for (uint32_t packNo = 1; packNo < packCount; packNo++)
+static bool WriteRecord(flash_sector_config_t* _sector, uint32_t _index, uint32_t _wordSize)
+{
+	storage_record_t record;
+	uint32_t wordNo = 0;
+	InitRecord(&record, config->store + _index, _index, _wordSize);
+	config->stats.recordCount++;
+	return ProgramRecord(_sector, &record, &wordNo, UINT32_MAX);
+}
+
+static bool WriteSectorHeader(flash_sector_config_t* _sector, uint32_t _generation)
+{
+	uint32_t data[SECTOR_HEADER_WORD_SIZE] = { SECTOR_HEADER_VALUE, _generation, ~_generation };
+	return ProgramFlashWord(_sector, data);
+}
+
+static void NotifyProgress(uint8_t _percent)
+{
+	for (int i = 0; i < config->clientCount; i++)
 	{
-		uint32_t len = FLASH_WORD_ALIGNMENT;
-		if(packNo == packCount - 1)
-		{
-			len = dataLeft;
-			data[FLASH_WORD_ALIGNMENT - 1] = _wordSize;
-		}
-		for (uint32_t i = 0; i < len; i++)
-			data[i] = *storeLoc++;
-		dataLeft -= len;
-		HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD, (uint32_t)(config->sectors[sectorIndex].addr + config->sectors[sectorIndex].index), (uint32_t)data);
-		config->sectors[sectorIndex].index += FLASH_WORD_ALIGNMENT;
+		if (config->clients[i].StorageProgress)
+			config->clients[i].StorageProgress(_percent);
+	}
+}
+
+static void NotifyCompletion(void)
+{
+	for (int i = 0; i < config->clientCount; i++)
+	{
+		if (config->clients[i].StorageCompleted)
+			config->clients[i].StorageCompleted();
+	}
+}
+
+/**
+ * @brief Starts erasing the sector in the background.
+ * @param _targetIndex Index of the sector to be erased.
+ * @param _isImagePending If <c>true</c>, the complete image of the states is written to the sector once erased.
+ */
+static void StartErase(int _targetIndex, bool _isImagePending)
+{
+	flash_sector_config_t* sector = &config->sectors[_targetIndex];
+	targetIndex = _targetIndex;
+	isImagePending = _isImagePending;
+	sector->index = 0;
+	sector->eraseCount++;
+	config->stats.eraseCount++;
+	eraseStartCycles = DWT->CYCCNT;
+	state = STORAGE_STATE_ERASING;
+	if (flashOps->Erase(sector) == false)
+		CompleteErase(false);
+}
+
+/**
+ * @brief Starts writing the complete image of the states in the background.
+ * @param _targetIndex Index of the sector to be written.
+ * @param _isNewSector If <c>true</c>, the image is written after a new sector header at the start of the sector,
+ * else it is written at the current index of the active sector as a checkpoint.
+ */
+static void StartImageWrite(int _targetIndex, bool _isNewSector)
+{
+	flash_sector_config_t* sector = &config->sectors[_targetIndex];
+	targetIndex = _targetIndex;
+	isNewSectorImage = _isNewSector;
+	imageWordNo = 0;
+	InitImageRecord(&image);
+	state = STORAGE_STATE_WRITING_IMAGE;
+	if (_isNewSector)
+	{
+		sector->index = 0;
+		if (WriteSectorHeader(sector, generation + 1) == false)
+			CompleteImageWrite(false);
+	}
+}
+
+static void CompleteErase(bool _isSuccessful)
+{
+	flash_sector_config_t* sector = &config->sectors[targetIndex];
+	uint32_t cycles = DWT->CYCCNT - eraseStartCycles;
+	if (cycles > config->stats.maxEraseCycles)
+		config->stats.maxEraseCycles = cycles;
+	state = STORAGE_STATE_IDLE;
+
+	// faulty sectors are skipped in the rotation
+	if (_isSuccessful == false || IsSectorErased(sector) == false)
+	{
+		sector->isFaulty = true;
+		config->stats.failureCount++;
+		if (isImagePending)
+			CompactStates();
+		else
+			PrepareNextSector();
+	}
+	else if (isImagePending)
+		StartImageWrite(targetIndex, true);
+}
+
+static void CompleteImageWrite(bool _isSuccessful)
+{
+	flash_sector_config_t* sector = &config->sectors[targetIndex];
+	state = STORAGE_STATE_IDLE;
+
+	if (_isSuccessful == false)
+	{
+		// skip the new sector in the rotation, or stop using the active sector if the checkpoint fails
+		if (isNewSectorImage)
+			sector->isFaulty = true;
+		else
+			sector->index = GetSectorWordSize(sector);
+		CompactStates();
+		return;
+	}
+
+	if (isNewSectorImage)
+	{
+		generation++;
+		config->stats.compactionCount++;
+		sectorIndex = targetIndex;
+	}
+	memcpy((void*)config->flashStore, (void*)config->store, STORE_BYTE_SIZE);
+	NotifyCompletion();
+	if (isNewSectorImage)
+		PrepareNextSector();
+}
+
+/**
+ * @brief Advances the background operation in progress by a single step.
+ */
+static void ProcessBackgroundOperation(void)
+{
+	flash_sector_config_t* sector = &config->sectors[targetIndex];
+	if (state == STORAGE_STATE_ERASING)
+	{
+		if (flashOps->IsBusy(sector) == false)
+			CompleteErase(true);
+	}
+	else if (state == STORAGE_STATE_WRITING_IMAGE)
+	{
+		bool isSuccessful = ProgramRecord(sector, &image, &imageWordNo, STATE_STORAGE_CHUNK_FLASH_WORDS);
+		if (isSuccessful && imageWordNo < image.packetWordSize)
+			NotifyProgress((imageWordNo * 100) / image.packetWordSize);
+		else
+			CompleteImageWrite(isSuccessful);
+	}
+}
+
+/**
+ * @brief Starts erasing the next healthy sector in the rotation if required, so that it is ready for the next image.
+ */
+static void PrepareNextSector(void)
+{
+	for (int nextIndex = GetNextSector(sectorIndex); nextIndex != sectorIndex; nextIndex = GetNextSector(nextIndex))
+	{
+		flash_sector_config_t* sector = &config->sectors[nextIndex];
+		if (sector->isFaulty)
+			continue;
+		if (IsSectorErased(sector))
+			sector->index = 0;
+		else
+			StartErase(nextIndex, false);
+		return;
+	}
+}
+
+/**
+ * @brief Starts writing the complete image of the states to the next healthy sector in the rotation.
+ * @details If the current sector is still empty it is used directly. The sector is erased first if required.
+ * Sectors which fail to erase or program are marked faulty and skipped, so that the storage keeps working
+ * with the remaining sectors.
+ */
+static void CompactStates(void)
+{
+	int nextIndex = config->sectors[sectorIndex].index == 0 ? sectorIndex : GetNextSector(sectorIndex);
+	for (int tries = 0; tries < sectorCount; tries++, nextIndex = GetNextSector(nextIndex))
+	{
+		flash_sector_config_t* sector = &config->sectors[nextIndex];
+		if (sector->isFaulty || (nextIndex == sectorIndex && sector->index != 0))
+			continue;
+		if (IsSectorErased(sector))
+			StartImageWrite(nextIndex, true);
+		else
+			StartErase(nextIndex, true);
+		return;
 	}
+	// No healthy sector available for the storage
+	Error_Handler();
+}
 
-	if (_isFirstSectorPacket)
-		EraseSector(&config->sectors[sectorIndex == 0 ? 1 : 0]);
+/**
+ * @brief Appends the data to the journal in the active sector.
+ * @details Records never cross the checkpoints. If the record can't fit before the next checkpoint,
+ * the complete image is written at the checkpoint in the background instead.
+ * @param _index Start index of the data in the store.
+ * @param _wordSize No of words to be written.
+ * @return <c>true</c> if the data is written, else <c>false</c> if the states need to be compacted in the next sector.
+ */
+static bool PutDataInFlash(uint32_t _index, uint32_t _wordSize)
+{
+	flash_sector_config_t* sector = &config->sectors[sectorIndex];
+	uint32_t checkpointIndex = GetNextCheckpointIndex(sector->index);
+	bool isCheckpoint = (sector->index + GET_FLASH_ALIGNED_SIZE(_wordSize)) > checkpointIndex;
+	if (isCheckpoint)
+	{
+		sector->index = checkpointIndex;
+		_wordSize = STORE_WORD_SIZE;
+	}
+	if (HasEnoughSpace(sector, _wordSize) == false)
+		return false;
+	if (isCheckpoint)
+	{
+		StartImageWrite(sectorIndex, false);
+		return true;
+	}
+	// stop using the sector if the write fails
+	if (WriteRecord(sector, _index, _wordSize) == false)
+	{
+		sector->index = GetSectorWordSize(sector);
+		return false;
+	}
+	memcpy((void*)(config->flashStore + _index), (void*)(config->store + _index), _wordSize * 4);
+	return true;
+}
+
+/**
+ * @brief Gets the range of words which differ from the states already written in the flash.
+ * @param _index Start index of the updated words in the store.
+ * @param _wordSize No of updated words.
+ * @param _changedIndex Pointer to get the start index of the changed words.
+ * @param _changedSize Pointer to get the no of changed words.
+ * @return <c>true</c> if any word has been changed, else <c>false</c>.
+ */
+static bool GetChangedWords(uint32_t _index, uint32_t _wordSize, uint32_t* _changedIndex, uint32_t* _changedSize)
+{
+	uint32_t endIndex = _index + _wordSize;
+	if (endIndex > STORE_WORD_SIZE)
+		endIndex = STORE_WORD_SIZE;
+	while (_index < endIndex && config->store[_index] == config->flashStore[_index])
+		_index++;
+	while (endIndex > _index && config->store[endIndex - 1] == config->flashStore[endIndex - 1])
+		endIndex--;
+	*_changedIndex = _index;
+	*_changedSize = endIndex - _index;
+	return endIndex > _index;
 }
 
 static uint32_t RefreshStatesLocal(uint32_t* storeLoc, state_storage_client_t* client, uint32_t* index)
@@ -382,40 +1055,85 @@ static uint32_t RefreshStatesLocal(uint32_t* storeLoc, state_storage_client_t* c
 	return GET_LOCAL_LEN(wordSize);
 }
 
-/**
- * @brief Refreshes the storage state if required.
- * @details Poll this function periodically to refresh the stored states for all parameters. If the index in the
- * sector is 0 or the packet cannot fit within the remaining space in the sector, the \"isFirstSectorPacket\" flag
- * is set. This flag ensures that all parameters are completely flushed to the beginning of the sector.
- * To obtain the necessary data, each client is prompted to refresh their states using the @ref state_storage_client_t.RefreshStates() function.
- * It is the responsibility of the client to provide the refreshed data, if necessary, and return the size of
- * the updated data. Finally, the partial data will be flushed to the storage flash.
- */
-void StateStorage_Refresh(void)
+static void UpdateStates(void)
 {
-	if (sectorIndex == -1)
-		Error_Handler();
 	uint32_t* storeLoc = config->store;
-	bool isFirstSectorPacket = config->sectors[sectorIndex].index == 0;
+	bool isFirstSectorPacket = IsCompactionRequired(&config->sectors[sectorIndex]);
+	bool isWritten = false;
 	uint32_t index = 0;
 	uint32_t localIndex = 0;
-	for (int i = 0; i < config->clientCount; i++)
+	// stop refreshing the clients once a background operation starts, the rest are refreshed after its completion
+	for (int i = 0; i < config->clientCount && state == STORAGE_STATE_IDLE; i++)
 	{
 		localIndex = 0;
 		uint32_t wordSize = RefreshStatesLocal(storeLoc, &config->clients[i], &localIndex);
-		if (wordSize > 0 && !isFirstSectorPacket)
+		uint32_t changedIndex, changedSize;
+		// only the words differing from the flash contents are appended to the journal
+		if (wordSize > 0 && !isFirstSectorPacket &&
+				GetChangedWords(index + localIndex, wordSize, &changedIndex, &changedSize))
 		{
-			if (HasEnoughSpace(&config->sectors[sectorIndex], wordSize) == false)
+			if (PutDataInFlash(changedIndex, changedSize) == false)
 				isFirstSectorPacket = true;
 			else
-				PutDataInFlash(storeLoc, index + localIndex, wordSize, false);		// one index for local header
+				isWritten = true;
 		}
 		// size includes local header and footer
 		storeLoc += GET_LOCAL_LEN(config->clients[i].dataWordLen);
 		index += GET_LOCAL_LEN(config->clients[i].dataWordLen);
 	}
 	if (isFirstSectorPacket)
-		PutDataInFlash(config->store, 0, STORE_WORD_SIZE, true);
+		CompactStates();
+	else if (isWritten && state == STORAGE_STATE_IDLE)
+		NotifyCompletion();
+}
+
+/**
+ * @brief Refreshes the storage state if required.
+ * @details Poll this function periodically to refresh the stored states for all parameters. If the index in the
+ * sector is 0 or the packet cannot fit within the remaining space in the sector, the \"isFirstSectorPacket\" flag
+ * is set. This flag ensures that all parameters are completely flushed to the beginning of the next sector in the rotation.
+ * To obtain the necessary data, each client is prompted to refresh their states using the @ref state_storage_client_t.RefreshStates() function.
+ * It is the responsibility of the client to provide the refreshed data, if necessary, and return the size of
+ * the updated data. Only the words differing from the flash contents are then appended to the journal as a CRC protected record.
+ * While a background operation is in progress (see @ref StateStorage_IsBusy()), each call only advances that operation
+ * by a single bounded step and the clients are not refreshed, so poll more frequently in this case.
+ */
+void StateStorage_Refresh(void)
+{
+	if (sectorIndex == -1)
+		Error_Handler();
+	uint32_t startCycles = DWT->CYCCNT;
+
+	if (state != STORAGE_STATE_IDLE)
+		ProcessBackgroundOperation();
+	else
+		UpdateStates();
+
+	uint32_t cycles = DWT->CYCCNT - startCycles;
+	if (cycles > config->stats.maxRefreshCycles)
+		config->stats.maxRefreshCycles = cycles;
+}
+
+/**
+ * @brief Checks if a background erase or image write is in progress.
+ * @return <c>true</c> if a background operation is in progress, else <c>false</c>.
+ */
+bool StateStorage_IsBusy(void)
+{
+	return state != STORAGE_STATE_IDLE;
+}
+
+/**
+ * @brief Resets the statistics in @ref state_storage_config_t.stats and the erase counts of all sectors.
+ * @details The DWT cycle counter is also started for the timing measurements.
+ */
+void StateStorage_ResetStats(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	memset((void*)&config->stats, 0, sizeof(state_storage_stats_t));
+	for (int i = 0; i < STATE_STORAGE_MAX_SECTORS; i++)
+		config->sectors[i].eraseCount = 0;
 }
 
 /* EOF */
@@ -29,6 +29,38 @@
  *******************************************************************************/
 #define ON_TEXTS_COUNT				(3)
 #define OFF_TEXTS_COUNT				(3)
+/** Maximum decimals supported by the fixed precision conversion */
+#define FTOA_MAX_DECIMALS			(9)
+/** Significant digits always sufficient for a single precision number to round trip */
+#define FTOA_MAX_SIGNIFICANT		(9)
+/** Maximum digits of a 64-bit unsigned value */
+#define U64_MAX_DIGITS				(20)
+/** Largest power of 10 exactly representable in double precision */
+#define MAX_EXACT_POW10				(22)
+/** Decimal exponent range displayed without the scientific notation in shortest mode */
+#define SHORTEST_MIN_EXP			(-5)
+#define SHORTEST_MAX_EXP			(9)
+/** Maximum significant digits accumulated by the float parser */
+#define ATOF_MAX_SIGNIFICANT		(19)
+/** Significant digits compared exactly near a midpoint. The midpoints of single precision numbers
+ * have at most 112 significant digits, so further digits can only break exact ties */
+#define ATOF_MAX_EXACT_DIGITS		(120)
+/** Maximum decimal digits accumulated in a 32-bit chunk */
+#define U32_CHUNK_DIGITS			(9)
+/** Largest power of 10 exactly representable in single precision */
+#define MAX_EXACT_POW10_FLOAT		(10)
+/** Decimal exponent range of the single precision numbers */
+#define ATOF_MAX_EXP10				(38)
+#define ATOF_MIN_EXP10				(-46)
+/** Distance in double precision ULPs from a single precision midpoint requiring exact comparison */
+#define ATOF_MIDPOINT_TOLERANCE		(16)
+/** Number of 32-bit words in the big integers used for exact comparisons */
+#define BIGINT_WORDS				(16)
+/** Largest power of 5 fitting in 32 bits */
+#define MAX_POW5_32BIT_EXP			(13)
+#define MAX_POW5_32BIT				(1220703125UL)
+/** Size of the temporary buffer used to format a single value in batch formatting */
+#define FORMAT_BUFF_SIZE			(48)
 /********************************************************************************
  * Typedefs
  *******************************************************************************/
@@ -36,12 +68,49 @@
 /********************************************************************************
  * Structures
  *******************************************************************************/
+/**
+ * @brief Fixed size unsigned big integer used for exact decimal to binary comparisons
+ */
+typedef struct
+{
+	uint32_t words[BIGINT_WORDS];	/**< @brief Words of the number, least significant first */
+	int len;						/**< @brief Number of used words */
+} bigint_t;
 
 /********************************************************************************
  * Static Variables
  *******************************************************************************/
 static const char* onTxts[ON_TEXTS_COUNT] = { "TRUE", "ON", "1" };
 static const char* offTxts[OFF_TEXTS_COUNT] = { "FALSE", "OFF", "0" };
+static const uint64_t pow10Table[U64_MAX_DIGITS] =
+{
+		1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+		10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+		1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL,
+		10000000000000000000ULL
+};
+static const char digitPairs[200] =
+{
+		'0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+		'1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+		'2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+		'3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+		'4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+		'5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+		'6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+		'7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+		'8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+		'9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+static const float pow10Floats[MAX_EXACT_POW10_FLOAT + 1] =
+{
+		1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+static const double pow10Doubles[MAX_EXACT_POW10 + 1] =
+{
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
 /********************************************************************************
  * Global Variables
  *******************************************************************************/
@@ -89,35 +158,188 @@ void CopyString(char *dest, const char *src)
 	}
 	*dest = '\0'; // Adding null-terminator at the end
 }
-static void ReverseString(char* txt, int len)
+/**
+ * @brief Get the raw bits of a single precision number
+ * @param f Single precision floating point number
+ * @return IEEE-754 representation of the number
+ */
+static inline uint32_t GetFloatBits(float f)
 {
-	int start = 0;
-	int end = len - 1;
-	while (start < end)
+	uint32_t bits;
+	memcpy(&bits, &f, sizeof(bits));
+	return bits;
+}
+/**
+ * @brief Get the single precision number from its raw bits
+ * @param bits IEEE-754 representation of the number
+ * @return Single precision floating point number
+ */
+static inline float GetFloatFromBits(uint32_t bits)
+{
+	float f;
+	memcpy(&f, &bits, sizeof(f));
+	return f;
+}
+/**
+ * @brief Get the number of decimal digits in a value
+ * @param val Value to be evaluated
+ * @return Number of decimal digits, 0 if the value is 0
+ */
+static int GetDigitCount(uint64_t val)
+{
+	int digits = 0;
+	while (digits < U64_MAX_DIGITS && val >= pow10Table[digits])
+		digits++;
+	return digits;
+}
+/**
+ * @brief Writes the decimal digits of a 32-bit value, two digits per step
+ * @param val Value to be written
+ * @param end Pointer to the location after the last digit. Digits are written backwards from here
+ * @param digits Number of digits to be written. Leading zeros are used as padding
+ */
+static void WriteDigitsBackwards(uint32_t val, char* end, int digits)
+{
+	while (digits >= 2)
 	{
-		char temp = txt[start];
-		txt[start] = txt[end];
-		txt[end] = temp;
-		start++;
-		end--;
+		const char* pair = &digitPairs[(val % 100) * 2];
+		val /= 100;
+		*--end = pair[1];
+		*--end = pair[0];
+		digits -= 2;
 	}
+	if (digits)
+		*--end = (char)(val % 10) + '0';
 }
-static bool ceil_custom(char* firstNumLoc, char* lastNumLoc)
+/**
+ * @brief Writes the decimal digits of a value
+ * @param val Value to be written
+ * @param txt Pointer to the string
+ * @param minDigits Minimum number of digits to be written. Leading zeros are used as padding
+ * @return Number of characters written
+ */
+static int WriteDigits(uint64_t val, char* txt, int minDigits)
 {
-	if (*firstNumLoc != '9')			// --TODO-- include for '9' later also
+	int len = GetDigitCount(val);
+	if (len < minDigits)
+		len = minDigits;
+	char* end = txt + len;
+	int digits = len;
+	// avoid 64-bit divisions once the value fits in 32 bits
+	while (val > UINT32_MAX)
 	{
-		do
-		{
-			if (*lastNumLoc == '9')
-				*lastNumLoc = '0';
-			else if (*lastNumLoc < '9' && *lastNumLoc >= '0')
-			{
-				*lastNumLoc = *lastNumLoc + 1;
-				break;
-			}
-		} while (lastNumLoc-- != firstNumLoc);
+		WriteDigitsBackwards((uint32_t)(val % 100000000ULL), end, 8);
+		val /= 100000000ULL;
+		end -= 8;
+		digits -= 8;
 	}
-	return false;
+	WriteDigitsBackwards((uint32_t)val, end, digits);
+	return len;
+}
+/**
+ * @brief Rounds the division of a value by a power of 10 to the nearest integer, ties to even
+ * @param val Value to be divided
+ * @param pow10 Exponent of the divisor
+ * @return Rounded quotient
+ */
+static uint64_t DivRoundPow10(uint64_t val, int pow10)
+{
+	if (pow10 <= 0)
+		return val;
+	if (pow10 >= U64_MAX_DIGITS)
+		return 0;
+	uint64_t div = pow10Table[pow10];
+	uint64_t q = val / div;
+	uint64_t rem = val - q * div;
+	uint64_t half = div / 2;
+	if (rem > half || (rem == half && (q & 1)))
+		q++;
+	return q;
+}
+/**
+ * @brief Gets the magnitude of a finite single precision number scaled by 10^decimals.
+ * The result is rounded to the nearest integer, ties to even, using exact integer arithmetic.
+ * @param bits IEEE-754 representation of the number. Sign is ignored
+ * @param decimals Number of decimals to be retained
+ * @param isTruncated If <c>true</c> the fractional part is discarded instead of rounded
+ * @param result Scaled value
+ * @return <c>true</c> if the scaled value fits in 64 bits else <c>false</c>
+ */
+static bool ScaleFloatBits(uint32_t bits, int decimals, bool isTruncated, uint64_t* result)
+{
+	int exp = (int)((bits >> 23) & 0xFF);
+	uint64_t mant = bits & 0x7FFFFF;
+	// value = mant * 2^(exp - 150)
+	if (exp == 0)
+		exp = 1;
+	else
+		mant |= 0x800000;
+	int shift = exp - 150;
+	// mant * 10^9 is always less than 2^54
+	mant *= pow10Table[decimals];
+	if (shift >= 0)
+	{
+		if (shift >= 64 || mant > (UINT64_MAX >> shift))
+			return false;
+		*result = mant << shift;
+		return true;
+	}
+	shift = -shift;
+	if (shift >= 64)
+	{
+		*result = 0;
+		return true;
+	}
+	uint64_t q = mant >> shift;
+	if (!isTruncated)
+	{
+		uint64_t rem = mant & ((1ULL << shift) - 1);
+		uint64_t half = 1ULL << (shift - 1);
+		if (rem > half || (rem == half && (q & 1)))
+			q++;
+	}
+	*result = q;
+	return true;
+}
+/**
+ * @brief Writes the special single precision values i.e. NaN and infinity
+ * @param bits IEEE-754 representation of the number
+ * @param txt Pointer to the string
+ * @return Number of characters in the string, 0 if the number is finite
+ */
+static int WriteNonFinite(uint32_t bits, char* txt)
+{
+	if ((bits & 0x7F800000) != 0x7F800000)
+		return 0;
+	const char* src = (bits & 0x7FFFFF) ? "nan" : ((bits & 0x80000000) ? "-inf" : "inf");
+	CopyString(txt, src);
+	return (int)strlen(src);
+}
+/**
+ * @brief Writes a value in scientific notation with two significant digits i.e. "d.de<exp>"
+ * @param val Integer part of the value to be written
+ * @param exp Additional decimal exponent of the value
+ * @param txt Pointer to the string
+ * @return Number of characters written
+ */
+static int WriteShortScientific(uint64_t val, int exp, char* txt)
+{
+	int digits = GetDigitCount(val);
+	uint64_t sig = DivRoundPow10(val, digits - 2);
+	exp += digits - 1;
+	// rounding carried into an extra digit
+	if (sig >= 100)
+	{
+		sig /= 10;
+		exp++;
+	}
+	char* txt0 = txt;
+	*txt++ = (char)(sig / 10) + '0';
+	*txt++ = '.';
+	*txt++ = (char)(sig % 10) + '0';
+	*txt++ = 'e';
+	txt += WriteDigits((uint64_t)exp, txt, 1);
+	return txt - txt0;
 }
 
 /**
@@ -143,6 +365,8 @@ int strcat_custom(char* dest, const char* src, int destLen, bool insertSpace)
 }
 /**
  * @brief This function converts the floating point number to character string
+ * @details The number is rounded to nearest (ties to even) at the displayed decimals using exact
+ * integer arithmetic. Numbers having more integer digits than maxDigits are displayed as "d.de<exp>".
  * @param f Single precision floating point number to be converted
  * @param txt Pointer to the string
  * @param maxDigits Max number of digits to be displayed
@@ -154,137 +378,567 @@ int ftoa_custom(float f, char* txt, int maxDigits, int precision)
 	if (maxDigits < 1)
 		return 0;
 
+	uint32_t bits = GetFloatBits(f);
+	int len = WriteNonFinite(bits, txt);
+	if (len)
+		return len;
+
 	char* txt0 = txt;
+	bool isNeg = (bits & 0x80000000) != 0;
+	uint64_t intVal, scaledVal = 0;
 
-	int val;
-	if (f < 0)
+	// get the integer digits with exact truncation
+	if (!ScaleFloatBits(bits, 0, true, &intVal))
 	{
-		*txt++ = '-';
-		f *= -1;
+		// beyond 64 bits, reduce the magnitude before displaying
+		int exp = 0;
+		float absF = isNeg ? -f : f;
+		while (absF >= 1e19f)
+		{
+			absF /= 10;
+			exp++;
+		}
+		(void)ScaleFloatBits(GetFloatBits(absF), 0, true, &intVal);
+		if (isNeg)
+			*txt++ = '-';
+		txt += WriteShortScientific(intVal, exp, txt);
+		*txt = 0;
+		return txt - txt0;
 	}
+	int digits = GetDigitCount(intVal);
 
-	char* firstNumLoc = txt;
-
-	val = (int)f;
-	int digits = 0;
-	int div = 1;
-	while (val > 0)
+	int decimals = 0;
+	if (digits <= maxDigits)
 	{
-		val /= 10;
-		div *= 10;
-		digits++;
+		int no1 = maxDigits - digits;
+		decimals = no1 > precision ? precision : no1;
+		if (decimals > FTOA_MAX_DECIMALS)
+			decimals = FTOA_MAX_DECIMALS;
+		if (decimals < 0)
+			decimals = 0;
+		// limit the scaled value to 64 bits
+		while (!ScaleFloatBits(bits, decimals, false, &scaledVal))
+			decimals--;
+		intVal = scaledVal / pow10Table[decimals];
+		// rounding may carry into an extra digit
+		digits = GetDigitCount(intVal);
 	}
 
 	if (digits > maxDigits)
 	{
-		val = (int)f;
-		if (div > 100)
-			val /= (div / 100);
-		*txt++ = (val / 10) + '0';
-		*txt++ = '.';
-		*txt++ = (val % 10) + '0';
-		*txt++ = 'e';
-		digits -= 1;
-		if(digits >= 10)
-			*txt++ = (digits / 10) + '0';
-		*txt++ = (digits % 10) + '0';
+		if (isNeg)
+			*txt++ = '-';
+		txt += WriteShortScientific(intVal, 0, txt);
 	}
 	else
 	{
-		val = (int)f;
-		itoa_custom(val, txt);
-		txt += digits;
-		if (val == 0)
+		// avoid showing -0.0 for negligible negative numbers
+		if (isNeg && scaledVal != 0)
+			*txt++ = '-';
+		txt += WriteDigits(intVal, txt, 1);
+		if (decimals > 0)
+		{
+			*txt++ = '.';
+			txt += WriteDigits(scaledVal - intVal * pow10Table[decimals], txt, decimals);
+		}
+	}
+	*txt = 0;
+
+	return txt - txt0;
+}
+/**
+ * @brief Multiplies a value by a power of 10 in double precision.
+ * The result is correctly rounded if the power lies in [-22, 22].
+ * @param val Value to be scaled
+ * @param pow10 Exponent of the power
+ * @return Scaled value
+ */
+static double ScalePow10(double val, int pow10)
+{
+	while (pow10 > MAX_EXACT_POW10)
+	{
+		val *= pow10Doubles[MAX_EXACT_POW10];
+		pow10 -= MAX_EXACT_POW10;
+	}
+	while (pow10 < -MAX_EXACT_POW10)
+	{
+		val /= pow10Doubles[MAX_EXACT_POW10];
+		pow10 += MAX_EXACT_POW10;
+	}
+	return pow10 >= 0 ? val * pow10Doubles[pow10] : val / pow10Doubles[-pow10];
+}
+/**
+ * @brief This function converts the floating point number to the shortest character string
+ * that converts back to the same single precision number.
+ * @details The decimal candidates are verified against the rounding interval of the number
+ * in double precision, which is exact for magnitudes between 1e-13 and 1e22.
+ * Numbers with decimal exponent in [-5, 9) are displayed without the scientific notation.
+ * The string needs space for at least 16 characters.
+ * @param f Single precision floating point number to be converted
+ * @param txt Pointer to the string
+ * @return Number of characters in the string
+ */
+int ftoa_shortest(float f, char* txt)
+{
+	uint32_t bits = GetFloatBits(f);
+	int len = WriteNonFinite(bits, txt);
+	if (len)
+		return len;
+
+	char* txt0 = txt;
+	if (bits & 0x80000000)
+	{
+		*txt++ = '-';
+		bits &= 0x7FFFFFFF;
+	}
+	if (bits == 0)
+	{
+		*txt++ = '0';
+		*txt = 0;
+		return txt - txt0;
+	}
+
+	// rounding interval of the number, exact in double precision
+	double val = GetFloatFromBits(bits);
+	double prev = GetFloatFromBits(bits - 1);
+	double lo = (val + prev) / 2;
+	double hi = bits == 0x7F7FFFFF ? val + (val - lo) : (val + (double)GetFloatFromBits(bits + 1)) / 2;
+
+	// decimal exponent of the leading digit, estimated from the binary exponent
+	int exp10 = ((((int)(bits >> 23)) - 127) * 1233) >> 12;
+	while (val >= ScalePow10(1, exp10 + 1))
+		exp10++;
+	while (val < ScalePow10(1, exp10))
+		exp10--;
+
+	// find the shortest decimal in the rounding interval
+	uint32_t sig = 0;
+	int exp = 0;
+	for (int k = 1; k <= FTOA_MAX_SIGNIFICANT; k++)
+	{
+		exp = exp10 - k + 1;
+		// round to nearest with ties to even, the scaled value is exact at the ties
+		double scaled = ScalePow10(val, -exp);
+		sig = (uint32_t)scaled;
+		if (scaled - sig > 0.5 || (scaled - sig == 0.5 && (sig & 1)))
+			sig++;
+		if (sig >= pow10Table[k])
+		{
+			sig /= 10;
+			exp++;
+		}
+		double candidate = ScalePow10(sig, exp);
+		if (candidate > lo && candidate < hi)
+			break;
+		// ties round to even mantissa, only decidable when the candidate is an exact integer
+		if ((bits & 1) == 0 && exp >= 0 && exp <= MAX_EXACT_POW10 && candidate < 9007199254740992.0
+				&& (candidate == lo || candidate == hi))
+			break;
+	}
+	// remove trailing zeros
+	while (sig >= 10 && sig % 10 == 0)
+	{
+		sig /= 10;
+		exp++;
+	}
+
+	char digitTxt[FTOA_MAX_SIGNIFICANT + 1];
+	int nd = WriteDigits(sig, digitTxt, 1);
+	int lead = exp + nd - 1;
+	if (lead >= SHORTEST_MIN_EXP && lead < SHORTEST_MAX_EXP)
+	{
+		if (exp >= 0)
+		{
+			memcpy(txt, digitTxt, nd);
+			txt += nd;
+			for (int i = 0; i < exp; i++)
+				*txt++ = '0';
+		}
+		else if (lead >= 0)
+		{
+			memcpy(txt, digitTxt, lead + 1);
+			txt += lead + 1;
+			*txt++ = '.';
+			memcpy(txt, digitTxt + lead + 1, nd - lead - 1);
+			txt += nd - lead - 1;
+		}
+		else
+		{
 			*txt++ = '0';
-		int no1 = maxDigits - digits;
-		int no2 = precision;
-		int precisionCompute = no1 > no2 ? no2 : no1;
-		if (precisionCompute > 0)
+			*txt++ = '.';
+			for (int i = 0; i < -lead - 1; i++)
+				*txt++ = '0';
+			memcpy(txt, digitTxt, nd);
+			txt += nd;
+		}
+	}
+	else
+	{
+		*txt++ = digitTxt[0];
+		if (nd > 1)
 		{
 			*txt++ = '.';
-			float frac = f - val;
-			for (int i = 0; i < precisionCompute ; i++)
+			memcpy(txt, digitTxt + 1, nd - 1);
+			txt += nd - 1;
+		}
+		*txt++ = 'e';
+		if (lead < 0)
+		{
+			*txt++ = '-';
+			lead = -lead;
+		}
+		txt += WriteDigits((uint64_t)lead, txt, 1);
+	}
+	*txt = 0;
+
+	return txt - txt0;
+}
+/**
+ * @brief Initializes a big integer from a 64-bit value
+ * @param num Big integer to be initialized
+ * @param val Initial value
+ */
+static void BigInt_Set(bigint_t* num, uint64_t val)
+{
+	num->words[0] = (uint32_t)val;
+	num->words[1] = (uint32_t)(val >> 32);
+	num->len = num->words[1] ? 2 : 1;
+}
+/**
+ * @brief Multiplies a big integer by a 32-bit value
+ * @param num Big integer to be multiplied
+ * @param mul Multiplier
+ */
+static void BigInt_MulSmall(bigint_t* num, uint32_t mul)
+{
+	uint64_t carry = 0;
+	for (int i = 0; i < num->len; i++)
+	{
+		carry += (uint64_t)num->words[i] * mul;
+		num->words[i] = (uint32_t)carry;
+		carry >>= 32;
+	}
+	if (carry && num->len < BIGINT_WORDS)
+		num->words[num->len++] = (uint32_t)carry;
+}
+/**
+ * @brief Multiplies a big integer by a 32-bit value and adds a 32-bit value
+ * @param num Big integer to be updated
+ * @param mul Multiplier
+ * @param add Value added after the multiplication
+ */
+static void BigInt_MulAdd(bigint_t* num, uint32_t mul, uint32_t add)
+{
+	uint64_t carry = add;
+	for (int i = 0; i < num->len; i++)
+	{
+		carry += (uint64_t)num->words[i] * mul;
+		num->words[i] = (uint32_t)carry;
+		carry >>= 32;
+	}
+	if (carry && num->len < BIGINT_WORDS)
+		num->words[num->len++] = (uint32_t)carry;
+}
+/**
+ * @brief Accumulates the significant digits of a decimal mantissa in a big integer
+ * @param num Big integer to be initialized
+ * @param txt Pointer to the mantissa digits, optionally containing a decimal point
+ * @param isTruncated Set to <c>true</c> if non-zero digits after @ref ATOF_MAX_EXACT_DIGITS are discarded
+ * @return Number of significant digits accumulated
+ */
+static int BigInt_SetDigits(bigint_t* num, const char* txt, bool* isTruncated)
+{
+	int sigDigits = 0, chunkDigits = 0;
+	uint32_t chunk = 0;
+	*isTruncated = false;
+	BigInt_Set(num, 0);
+	for (; (*txt >= '0' && *txt <= '9') || *txt == '.'; txt++)
+	{
+		if (*txt == '.' || (sigDigits == 0 && *txt == '0'))
+			continue;
+		if (sigDigits == ATOF_MAX_EXACT_DIGITS)
+		{
+			*isTruncated |= *txt != '0';
+			continue;
+		}
+		chunk = chunk * 10 + (*txt - '0');
+		sigDigits++;
+		if (++chunkDigits == U32_CHUNK_DIGITS)
+		{
+			BigInt_MulAdd(num, (uint32_t)pow10Table[chunkDigits], chunk);
+			chunk = 0;
+			chunkDigits = 0;
+		}
+	}
+	if (chunkDigits)
+		BigInt_MulAdd(num, (uint32_t)pow10Table[chunkDigits], chunk);
+	return sigDigits;
+}
+/**
+ * @brief Multiplies a big integer by a power of 5
+ * @param num Big integer to be multiplied
+ * @param exp Exponent of the power
+ */
+static void BigInt_MulPow5(bigint_t* num, int exp)
+{
+	for (; exp >= MAX_POW5_32BIT_EXP; exp -= MAX_POW5_32BIT_EXP)
+		BigInt_MulSmall(num, MAX_POW5_32BIT);
+	uint32_t mul = 1;
+	while (exp--)
+		mul *= 5;
+	BigInt_MulSmall(num, mul);
+}
+/**
+ * @brief Shifts a big integer to the left
+ * @param num Big integer to be shifted
+ * @param shift Number of bits to shift
+ */
+static void BigInt_ShiftLeft(bigint_t* num, int shift)
+{
+	int wordShift = shift / 32;
+	int bitShift = shift % 32;
+	int len = num->len + wordShift + 1;
+	if (len > BIGINT_WORDS)
+		len = BIGINT_WORDS;
+	for (int i = len - 1; i >= 0; i--)
+	{
+		int src = i - wordShift;
+		uint32_t hi = (src >= 0 && src < num->len) ? num->words[src] : 0;
+		uint32_t lo = (src > 0 && src <= num->len) ? num->words[src - 1] : 0;
+		num->words[i] = bitShift ? (hi << bitShift) | (lo >> (32 - bitShift)) : hi;
+	}
+	while (len > 1 && num->words[len - 1] == 0)
+		len--;
+	num->len = len;
+}
+/**
+ * @brief Compares two big integers
+ * @param a First big integer
+ * @param b Second big integer
+ * @return Positive if a > b, negative if a < b else 0
+ */
+static int BigInt_Compare(const bigint_t* a, const bigint_t* b)
+{
+	if (a->len != b->len)
+		return a->len > b->len ? 1 : -1;
+	for (int i = a->len - 1; i >= 0; i--)
+	{
+		if (a->words[i] != b->words[i])
+			return a->words[i] > b->words[i] ? 1 : -1;
+	}
+	return 0;
+}
+/**
+ * @brief Gets the integer mantissa and binary exponent of a positive single precision number
+ * @param bits IEEE-754 representation of the number
+ * @param exp Binary exponent so that number = mantissa * 2^exp
+ * @return Integer mantissa
+ */
+static uint32_t GetFloatMantissa(uint32_t bits, int* exp)
+{
+	int biasedExp = (int)(bits >> 23);
+	uint32_t mant = bits & 0x7FFFFF;
+	if (biasedExp == 0)
+		biasedExp = 1;
+	else
+		mant |= 0x800000;
+	*exp = biasedExp - 150;
+	return mant;
+}
+/**
+ * @brief Compares a decimal number exactly with the midpoint of two adjacent single precision numbers
+ * @param mant Decimal mantissa
+ * @param exp10 Decimal exponent
+ * @param isTruncated <c>true</c> if non-zero digits after @ref ATOF_MAX_EXACT_DIGITS were discarded
+ * @param bits IEEE-754 representation of the lower number. The upper number is bits + 1
+ * @return Positive if decimal is above the midpoint, negative if below else 0
+ */
+static int CompareWithMidpoint(const bigint_t* mant, int exp10, bool isTruncated, uint32_t bits)
+{
+	int exp1, exp2;
+	uint32_t mant1 = GetFloatMantissa(bits, &exp1);
+	uint32_t mant2 = GetFloatMantissa(bits + 1, &exp2);
+	// midpoint = midMant * 2^midExp
+	int midExp = exp1 < exp2 ? exp1 : exp2;
+	uint64_t midMant = ((uint64_t)mant1 << (exp1 - midExp)) + ((uint64_t)mant2 << (exp2 - midExp));
+	midExp--;
+
+	// decimal = mant * 5^exp10 * 2^exp10
+	bigint_t dec = *mant, mid;
+	BigInt_Set(&mid, midMant);
+	if (exp10 >= 0)
+		BigInt_MulPow5(&dec, exp10);
+	else
+		BigInt_MulPow5(&mid, -exp10);
+	if (exp10 > midExp)
+		BigInt_ShiftLeft(&dec, exp10 - midExp);
+	else
+		BigInt_ShiftLeft(&mid, midExp - exp10);
+
+	int cmp = BigInt_Compare(&dec, &mid);
+	return (cmp == 0 && isTruncated) ? 1 : cmp;
+}
+/**
+ * @brief Converts a decimal number to the nearest single precision number, ties to even.
+ * @param mant Decimal mantissa
+ * @param exp10 Decimal exponent
+ * @param isTruncated <c>true</c> if non-zero digits of the decimal number were discarded
+ * @param digits Pointer to the complete mantissa digits, used for the exact comparisons if the mantissa is truncated
+ * @param f Resulting single precision number
+ * @return <c>true</c> if successful, <c>false</c> if the number overflows
+ */
+static bool DecimalToFloat(uint64_t mant, int exp10, bool isTruncated, const char* digits, float* f)
+{
+	// exact operands, so a single correctly rounded operation
+	if (!isTruncated && mant <= (1UL << 24) && exp10 <= MAX_EXACT_POW10_FLOAT && exp10 >= -MAX_EXACT_POW10_FLOAT)
+	{
+		*f = exp10 >= 0 ? (float)mant * pow10Floats[exp10] : (float)mant / pow10Floats[-exp10];
+		return true;
+	}
+
+	// single scaling in double precision is accurate to a few ULPs
+	double approx = ScalePow10((double)mant, exp10);
+	if (approx >= 1.1754943508222875e-38 && approx <= 3.4028234663852886e38)
+	{
+		uint64_t approxBits;
+		memcpy(&approxBits, &approx, sizeof(approxBits));
+		// the discarded 29 bits decide the rounding to single precision
+		int32_t dist = (int32_t)(approxBits & 0x1FFFFFFF) - 0x10000000;
+		if (dist > ATOF_MIDPOINT_TOLERANCE || dist < -ATOF_MIDPOINT_TOLERANCE)
+		{
+			*f = (float)approx;
+			return true;
+		}
+	}
+
+	// close to a midpoint or out of normal range, correct the candidate with exact comparisons
+	// against the complete digits, as the discarded digits may decide the side of the midpoint
+	bigint_t dec;
+	if (isTruncated)
+		exp10 -= BigInt_SetDigits(&dec, digits, &isTruncated) - ATOF_MAX_SIGNIFICANT;
+	else
+		BigInt_Set(&dec, mant);
+	float candidate = (float)approx;
+	uint32_t bits = GetFloatBits(candidate);
+	if (bits > 0x7F800000)
+		bits = 0x7F800000;
+	for (;;)
+	{
+		if (bits < 0x7F800000)
+		{
+			int cmp = CompareWithMidpoint(&dec, exp10, isTruncated, bits);
+			if (cmp > 0 || (cmp == 0 && (bits & 1)))
 			{
-				frac *= 10;
-				*txt++ = ((int)frac) % 10 + '0';
+				bits++;
+				continue;
 			}
-
-			frac *= 10;
-			if (((int)frac) % 10  >= 5)
+		}
+		if (bits > 0)
+		{
+			int cmp = CompareWithMidpoint(&dec, exp10, isTruncated, bits - 1);
+			if (cmp < 0 || (cmp == 0 && (bits & 1)))
 			{
-				if (ceil_custom(firstNumLoc, txt-1))
-					txt++;
+				bits--;
+				continue;
 			}
 		}
+		break;
 	}
-	*txt = 0;
-
-	return txt - txt0;
+	if (bits >= 0x7F800000)
+		return false;
+	*f = GetFloatFromBits(bits);
+	return true;
 }
 /**
  * @brief Custom implementation to convert string to single precision number if possible.
+ * @details The format is [+|-]digits[.digits][(e|E)[+|-]digits] with at least one mantissa digit.
+ * The result is correctly rounded to nearest, ties to even. Up to 19 significant digits are accumulated
+ * in a 64-bit integer for the fast conversion. Close to a rounding midpoint the complete digits are
+ * compared exactly, where digits after the first 120 significant digits only influence exact ties.
  * @param txt Pointer to the text field.
- * @param val Pointer to the single precision value to be updated
- * @return <c>true</c> if successful else <c>false</c>
+ * @param val Pointer to the single precision value to be updated. Not modified on failure
+ * @return <c>true</c> if successful else <c>false</c> for malformed text or overflow
  */
 bool atof_custom(const char* txt, float* val)
 {
-	// if nothing found
-	if(*txt == 0)
+	if (txt == NULL)
 		return false;
-	*val = 0;
-	uint32_t intVal = 0, floatVal = 0, div = 1;
-	int i = 0;
-	// handle negative numbers
+
 	bool isNeg = false;
-	if(txt[i] == '-')
-	{
-		isNeg = true;
-		txt++;
-	}
-	// handle decimal
-	uint8_t dotIndex = 0, dotCount = 0;
-	dotCount = String_FindnCharsIndices(txt, '.', &dotIndex, 1);
-	// more than possible dots
-	if(dotCount > 1)
-		return false;
-	// if integer part is impossible to convert due to long length
-	if(dotIndex > 8)
-		return false;
-	// get integer value
-	for(int i = 0; i < dotIndex; i++)
+	if (*txt == '-' || *txt == '+')
+		isNeg = *txt++ == '-';
+
+	uint64_t mant = 0;
+	int sigDigits = 0, exp10 = 0;
+	bool hasDigits = false, isTruncated = false;
+	const char* digits = txt;
+	// integer part
+	for (; *txt >= '0' && *txt <= '9'; txt++)
 	{
-		if(txt[i] <= '9' && txt[i] >= '0')
-			intVal = (intVal * 10) + (txt[i] - '0');
-		// error if any other character present
+		hasDigits = true;
+		if (sigDigits < ATOF_MAX_SIGNIFICANT)
+		{
+			mant = mant * 10 + (*txt - '0');
+			if (mant != 0)
+				sigDigits++;
+		}
 		else
-			return false;
+		{
+			exp10++;
+			isTruncated |= *txt != '0';
+		}
 	}
-	if(dotCount == 1)
+	// fractional part
+	if (*txt == '.')
 	{
-		for(int i = dotIndex + 1 ; txt[i] != 0; i++)
+		for (txt++; *txt >= '0' && *txt <= '9'; txt++)
 		{
-			if(txt[i] <= '9' && txt[i] >= '0')
+			hasDigits = true;
+			if (sigDigits < ATOF_MAX_SIGNIFICANT)
 			{
-				floatVal = (floatVal * 10) + (txt[i] - '0');
-				div *= 10;
+				mant = mant * 10 + (*txt - '0');
+				exp10--;
+				if (mant != 0)
+					sigDigits++;
 			}
-			// error if any other character present
 			else
-				return false;
+				isTruncated |= *txt != '0';
 		}
-		// if floating part is impossible to convert due to long length
-		if((i - dotIndex) > 9)
+	}
+	if (!hasDigits)
+		return false;
+	// exponent part
+	if (*txt == 'e' || *txt == 'E')
+	{
+		txt++;
+		bool isExpNeg = false;
+		if (*txt == '-' || *txt == '+')
+			isExpNeg = *txt++ == '-';
+		if (*txt < '0' || *txt > '9')
 			return false;
-		*val = ((float)(floatVal) / div);
-		*val += (intVal);
+		int exp = 0;
+		for (; *txt >= '0' && *txt <= '9'; txt++)
+		{
+			// saturate, far beyond the representable range
+			if (exp < 10000)
+				exp = exp * 10 + (*txt - '0');
+		}
+		exp10 += isExpNeg ? -exp : exp;
 	}
-	else
+	// trailing characters
+	if (*txt != 0)
+		return false;
+
+	float f = 0;
+	if (mant != 0)
 	{
-		*val = intVal;
+		int magnitude = GetDigitCount(mant) - 1 + exp10;
+		if (magnitude > ATOF_MAX_EXP10)
+			return false;
+		if (magnitude >= ATOF_MIN_EXP10 && !DecimalToFloat(mant, exp10, isTruncated, digits, &f))
+			return false;
 	}
-	if(isNeg)
-		*val *= (-1.0f);
+	*val = isNeg ? -f : f;
 	return true;
 }
 /**
@@ -362,44 +1016,59 @@ bool atob_custom(const char* txt, bool* val)
 	return false;
 }
 /**
- * @brief This function converts the integer number to character string
- * @param val Value of the integer
+ * @brief Get the number of decimal digits in a 32-bit value
+ * @param val Value to be evaluated
+ * @return Number of decimal digits, at least 1
+ */
+static int GetDigitCount32(uint32_t val)
+{
+	int digits = 1;
+	while (digits < 10 && val >= (uint32_t)pow10Table[digits])
+		digits++;
+	return digits;
+}
+/**
+ * @brief Writes the unsigned integer with padding
+ * @param val Value of the unsigned integer
  * @param txt Pointer to the string
+ * @param isNegative If <c>true</c> a minus sign is written before the digits
+ * @param width Minimum number of characters including the sign
+ * @param padChar Padding character. Zeros are placed after the sign, all other characters before it
  * @return Number of characters in the string.
  */
-int itoa_custom(int32_t val, char* txt)
+static int WritePadded(uint32_t val, char* txt, bool isNegative, int width, char padChar)
 {
-	bool isNegative = false;
-	int i = 0;
-
-	if (val == 0)
-	{
-		txt[i++] = '0';
-		txt[i] = 0;
-		return 1;
-	}
-
-	if (val < 0)
+	int digits = GetDigitCount32(val);
+	int len = digits + (isNegative ? 1 : 0);
+	int padLen = width > len ? width - len : 0;
+	char* txt0 = txt;
+	if (padChar == '0')
 	{
-		isNegative = true;
-		val = -val;
+		if (isNegative)
+			*txt++ = '-';
+		digits += padLen;
 	}
-
-	while (val != 0)
+	else
 	{
-		int digit = val % 10;
-		txt[i++] = digit + '0';
-		val = val / 10;
+		for (int i = 0; i < padLen; i++)
+			*txt++ = padChar;
+		if (isNegative)
+			*txt++ = '-';
 	}
-
-	if (isNegative)
-		txt[i++] = '-';
-
-	txt[i] = 0;
-
-	ReverseString(txt, i);
-
-	return i;
+	txt += digits;
+	WriteDigitsBackwards(val, txt, digits);
+	*txt = 0;
+	return txt - txt0;
+}
+/**
+ * @brief This function converts the integer number to character string
+ * @param val Value of the integer
+ * @param txt Pointer to the string
+ * @return Number of characters in the string.
+ */
+int itoa_custom(int32_t val, char* txt)
+{
+	return itoa_padded(val, txt, 0, ' ');
 }
 /**
  * @brief This function converts the unsigned integer number to character string
@@ -409,27 +1078,34 @@ int itoa_custom(int32_t val, char* txt)
  */
 int utoa_custom(uint32_t val, char* txt)
 {
-	int i = 0;
-
-	if (val == 0)
-	{
-		txt[i++] = '0';
-		txt[i] = 0;
-		return 1;
-	}
-
-	while (val != 0)
-	{
-		int digit = val % 10;
-		txt[i++] = digit + '0';
-		val = val / 10;
-	}
-
-	txt[i] = 0;
-
-	ReverseString(txt, i);
-
-	return i;
+	return WritePadded(val, txt, false, 0, ' ');
+}
+/**
+ * @brief This function converts the integer number to a character string of fixed minimum width, for aligned display fields.
+ * @param val Value of the integer
+ * @param txt Pointer to the string
+ * @param width Minimum number of characters including the sign. Longer numbers are written completely
+ * @param padChar Padding character e.g. ' ' for right aligned or '0' for leading zeros placed after the sign
+ * @return Number of characters in the string.
+ */
+int itoa_padded(int32_t val, char* txt, int width, char padChar)
+{
+	// negate in unsigned domain to support INT32_MIN
+	bool isNegative = val < 0;
+	uint32_t absVal = isNegative ? 0U - (uint32_t)val : (uint32_t)val;
+	return WritePadded(absVal, txt, isNegative, width, padChar);
+}
+/**
+ * @brief This function converts the unsigned integer number to a character string of fixed minimum width, for aligned display fields.
+ * @param val Value of the unsigned integer
+ * @param txt Pointer to the string
+ * @param width Minimum number of characters. Longer numbers are written completely
+ * @param padChar Padding character e.g. ' ' for right aligned or '0' for leading zeros
+ * @return Number of characters in the string.
+ */
+int utoa_padded(uint32_t val, char* txt, int width, char padChar)
+{
+	return WritePadded(val, txt, false, width, padChar);
 }
 /**
  * @brief Custom implementation to convert string to integer if possible.
@@ -499,6 +1175,77 @@ bool atou_custom(const char *txt, uint32_t *result)
 	return true;
 }
 
+/**
+ * @brief Formats a value according to the format information
+ * @param value Value to be formatted
+ * @param format Format information of the value
+ * @param txt Pointer to the string with space of at least @ref FORMAT_BUFF_SIZE characters
+ * @return Number of characters in the string, -1 if the type is not supported
+ */
+static int FormatValue(data_union_t value, const value_format_t* format, char* txt)
+{
+	int len;
+	switch (format->type)
+	{
+	case DTYPE_BOOL: len = btoa_custom(value.b, txt); break;
+	case DTYPE_U8: len = utoa_custom(value.u8, txt); break;
+	case DTYPE_U16: len = utoa_custom(value.u16, txt); break;
+	case DTYPE_U32: len = utoa_custom(value.u32, txt); break;
+	case DTYPE_S8: len = itoa_custom(value.s8, txt); break;
+	case DTYPE_S16: len = itoa_custom(value.s16, txt); break;
+	case DTYPE_S32: len = itoa_custom(value.s32, txt); break;
+	case DTYPE_FLOAT: len = ftoa_custom(value.f, txt, format->maxDigits, format->precision); break;
+	default: return -1;
+	}
+	// append the suffix within the buffer limits
+	if (format->suffix != NULL)
+	{
+		for (const char* src = format->suffix; *src != 0 && len < FORMAT_BUFF_SIZE - 1; src++)
+			txt[len++] = *src;
+		txt[len] = 0;
+	}
+	return len;
+}
+/**
+ * @brief Formats a batch of values into a preallocated arena of strings, and reports the strings that changed.
+ * @details Each item occupies itemSize characters in the arena, starting at index * itemSize.
+ * The arena retains the previous strings, so only items whose text differs are rewritten and marked as changed.
+ * Items with unsupported types are skipped and never marked. Strings longer than itemSize - 1 are truncated.
+ * @param values Values to be formatted
+ * @param formats Format information of each value
+ * @param count Number of values
+ * @param arena Arena of count * itemSize characters containing the strings
+ * @param itemSize Number of characters reserved for each item including the null-terminator
+ * @param changedMask Bit mask of the changed items of @ref STRING_BATCH_MASK_WORDS(count) words.
+ * Bit (index % 32) of word (index / 32) is set if the text of the item changed
+ * @return Number of changed items
+ */
+int String_FormatBatch(const data_union_t* values, const value_format_t* formats, int count, char* arena, int itemSize, uint32_t* changedMask)
+{
+	int changedCount = 0;
+	for (int i = 0; i < STRING_BATCH_MASK_WORDS(count); i++)
+		changedMask[i] = 0;
 
+	for (int i = 0; i < count; i++)
+	{
+		char txt[FORMAT_BUFF_SIZE];
+		int len = FormatValue(values[i], &formats[i], txt);
+		if (len < 0)
+			continue;
+		if (len > itemSize - 1)
+		{
+			len = itemSize - 1;
+			txt[len] = 0;
+		}
+		// keep the previous text if nothing changed
+		char* item = arena + (i * itemSize);
+		if (memcmp(item, txt, len + 1) == 0)
+			continue;
+		memcpy(item, txt, len + 1);
+		changedMask[i / 32] |= 1UL << (i % 32);
+		changedCount++;
+	}
+	return changedCount;
+}
 
 /* EOF */
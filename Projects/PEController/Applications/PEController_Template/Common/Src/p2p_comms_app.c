@@ -68,6 +68,24 @@ data_param_info_t p2pCommsParams[P2P_PARAM_COUNT] =
 		{ .name = "Floating Number", .index = P2P_SAMPLE_FLOAT, .type = DTYPE_FLOAT, .arg = 1, .unit = UNIT_Hz},
 
 };
+/**
+ * @brief Indices of @ref p2pCommsParams sorted in ascending order of their names.
+ * @details Used by @ref P2PComms_FindParameterByName() for binary search of parameters by name.
+ * @note Keep this table sorted (ASCII order) whenever a name is added or changed in @ref p2pCommsParams.
+ */
+const uint8_t p2pCommsParamsNameIndex[P2P_PARAM_COUNT] =
+{
+		P2P_PARAM_S16_SAMPLE,
+		P2P_PARAM_U16_SAMPLE,
+		P2P_PARAM_S32_SAMPLE,
+		P2P_PARAM_U32_SAMPLE,
+		P2P_PARAM_S8_SAMPLE,
+		P2P_PARAM_U8_SAMPLE,
+		P2P_PARAM_STATE_SAMPLE,
+		P2P_PARAM_FLOAT_SAMPLE,
+		P2P_PARAM_BIT1_SAMPLE,
+		P2P_PARAM_BIT2_SAMPLE,
+};
 #endif
 /********************************************************************************
  * Function Prototypes
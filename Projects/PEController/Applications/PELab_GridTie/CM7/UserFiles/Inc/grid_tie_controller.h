@@ -79,6 +79,7 @@ typedef struct
 	pll_lock_t pll;							/**< @brief PLL structure used by the grid tie controller */
 	inverter3Ph_config_t inverterConfig;	/**< @brief Output inverter configuration */
 	independent_pwm_config_t boostConfig[BOOST_COUNT];	/**< @brief Boost configuration for developing DC link */
+	pwm1_10_duty_handle_t boostHandles[BOOST_COUNT];	/**< @brief Precomputed handles for the fast update of the boost channels at PWM1-10 */
 	uint16_t boostDiodePin[BOOST_COUNT];				/**< @brief Pin no of the switches acting as diode */
 	float VbstSet;							/**< @brief Boost set point voltage */
 	float tempIndex;						/**< @brief Temporary variable */
@@ -107,6 +108,12 @@ extern void GridTieControl_Init(grid_tie_t* gridTie, PWMResetCallback pwmResetCa
  * @param gridTie Pointer to the grid tie structure
  */
 extern void GridTieControl_Loop(grid_tie_t* gridTie);
+/**
+ * @brief Turns the grid relays on or off depending upon the DC link voltage
+ * @details Should be called once in @ref RELAY_CONTROL_DIVIDER control cycles.
+ * @param gridTie Pointer to the grid tie structure
+ */
+extern void GridTie_ControlRelays(grid_tie_t* gridTie);
 /**
  * @brief Enable/Disable the boost converter for the grid tie controller
  * @param gridTie Pointer to the grid tie structure
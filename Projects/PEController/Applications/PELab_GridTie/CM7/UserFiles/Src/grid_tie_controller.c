@@ -158,6 +158,8 @@ void GridTieControl_Init(grid_tie_t* gridTie, PWMResetCallback pwmResetCallback)
 		boostConfig->pwmConfig.masterOpts = &timerTriggerOut;
 		boostConfig->dutyUpdateFnc = BSP_PWM_ConfigChannel(boostConfig->pinNo, &boostConfig->pwmConfig);
 		boostConfig->dutyUpdateFnc(boostConfig->pinNo, 0.f, &boostConfig->pwmConfig);
+		if (boostConfig->pinNo <= 10)
+			BSP_PWM1_10_CreateDutyHandle(boostConfig->pinNo, &boostConfig->pwmConfig, false, &gridTie->boostHandles[i]);
 		BSP_Dout_SetAsPWMPin(boostConfig->pinNo);
 
 		// Turn off the upper switch so that it behaves as a diode
@@ -279,7 +281,11 @@ static void GridTie_GenerateOutput(grid_tie_t* gridTie)
 	Inverter3Ph_UpdateDuty(&gridTie->inverterConfig, inverterDuties);
 }
 
-static void ControlRelays(grid_tie_t* gridTie)
+/**
+ * @brief Turns the grid relays on or off depending upon the DC link voltage
+ * @param gridTie Pointer to the grid tie structure
+ */
+void GridTie_ControlRelays(grid_tie_t* gridTie)
 {
 	// Relay Control depending On Vboost
 	if (gridTie->isRelayOn)
@@ -291,6 +297,9 @@ static void ControlRelays(grid_tie_t* gridTie)
 			gridTie->tempIndex = 0;
 			for (int i = 0; i < GRID_RELAY_COUNT; i++)
 				BSP_Dout_SetAsIOPin(GRID_RELAY_IO + i, GPIO_PIN_RESET);
+#if TRACE_ENABLE
+			Trace_Log(TRACE_EVT_RELAY, 0, false);
+#endif
 		}
 	}
 	else
@@ -299,12 +308,15 @@ static void ControlRelays(grid_tie_t* gridTie)
 		if (gridTie->vdc < RELAY_TURN_OFF_VDC)			// --FIXME-- Change with Grid Voltage
 			gridTie->tempIndex = 0;
 		// wait for stabilization of boost
-		else if (++gridTie->tempIndex == (int)PWM_FREQ_Hz)
+		else if (++gridTie->tempIndex == (int)(PWM_FREQ_Hz / RELAY_CONTROL_DIVIDER))
 		{
 			gridTie->isRelayOn = INTER_CORE_DATA.bools[P2P_RELAY_STATUS] = true;
 			for (int i = 0; i < GRID_RELAY_COUNT; i++)
 				BSP_Dout_SetAsIOPin(GRID_RELAY_IO + i, GPIO_PIN_SET);
 			gridTie->tempIndex = 0;
+#if TRACE_ENABLE
+			Trace_Log(TRACE_EVT_RELAY, 0, true);
+#endif
 		}
 	}
 }
@@ -327,15 +339,21 @@ void GridTieControl_Loop(grid_tie_t* gridTie)
 			boostDuty = 0;
 
 		for (int i = 0; i < BOOST_COUNT; i++)
-			gridTie->boostConfig[i].dutyUpdateFnc(gridTie->boostConfig[i].pinNo, boostDuty, &gridTie->boostConfig[i].pwmConfig);
+		{
+			if (gridTie->boostConfig[i].pinNo <= 10)
+				BSP_PWM1_10_UpdateDutyFast(&gridTie->boostHandles[i], boostDuty);
+			else
+				gridTie->boostConfig[i].dutyUpdateFnc(gridTie->boostConfig[i].pinNo, boostDuty, &gridTie->boostConfig[i].pwmConfig);
+		}
 	}
 
-	// Control relays for protection of the circuitry
-	ControlRelays(gridTie);
-
 	// Implement phase lock loop
 	Pll_LockGrid(pll);
 	INTER_CORE_DATA.bools[P2P_PLL_STATUS] = gridTie->pll.status == PLL_LOCKED;
+#if TRACE_ENABLE
+	if (pll->status != pll->prevStatus)
+		Trace_Log(TRACE_EVT_PLL_STATUS, pll->status, pll->prevStatus);
+#endif
 
 	// Generate inverter PWM is enabled and not faulty
 	if (gridTie->isInverterEnabled)
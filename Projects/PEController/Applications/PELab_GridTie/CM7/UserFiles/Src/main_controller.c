@@ -21,6 +21,8 @@
 #include "pecontroller_timers.h"
 #include "p2p_comms.h"
 #include "grid_tie_controller.h"
+#include "cyclic_executive.h"
+#include "max11046_drivers.h"
 /*******************************************************************************
  * Defines
  ******************************************************************************/
@@ -53,12 +55,74 @@ static void MainControl_Loop(adc_measures_t* result);
  */
 grid_tie_t gridTieConfig = {0};
 static adc_mode_t adcMode = ADC_MODE_MONITORING;
+/**
+ * @brief Runs the control loop in each ADC callback and the relay control at a lower rate
+ */
+static executive_t executive = {0};
 /*******************************************************************************
  * Code
  ******************************************************************************/
+#if ADC_FAST_PROTECTION
+/**
+ * @brief Updates the states of the boost and inverter once the fast protection disables the PWM outputs.
+ * @param tripMask Channels exceeding the limits
+ */
+static void Protection_Callback(uint16_t tripMask)
+{
+	(void)GridTie_EnableInverter(&gridTieConfig, false);
+	(void)GridTie_EnableBoost(&gridTieConfig, false);
+}
+
+/**
+ * @brief Configures the fast protection of the inverter currents and the DC link voltage
+ */
+static void Protection_Init(void)
+{
+	adc_protection_config_t config = {
+			.channelMask = 0x107,
+			.debounceCount = PROTECTION_DEBOUNCE_COUNT,
+			// inverter at PWM1-6, boost at PWM8, PWM10, PWM12 and their diode switches at PWM7, PWM9, PWM11
+			.pwmMask = 0xfff,
+			.callback = Protection_Callback };
+	// inverter currents at Ch1-Ch3
+	for (int i = 0; i < 3; i++)
+	{
+		config.min[i] = -PROTECTION_MAX_CURRENT;
+		config.max[i] = PROTECTION_MAX_CURRENT;
+	}
+	// DC link voltage at Ch9
+	config.min[8] = -PROTECTION_MAX_VDC;
+	config.max[8] = PROTECTION_MAX_VDC;
+	BSP_ADC_ConfigProtection(&config);
+}
+#endif
+/**
+ * @brief Executive task running the boost, PLL and inverter control in each cycle
+ * @param arg Pointer to the grid tie structure
+ */
+static void ControlTask(void* arg)
+{
+	GridTieControl_Loop((grid_tie_t*)arg);
+}
+
+/**
+ * @brief Executive task controlling the grid relays once in @ref RELAY_CONTROL_DIVIDER cycles
+ * @param arg Pointer to the grid tie structure
+ */
+static void RelayTask(void* arg)
+{
+	GridTie_ControlRelays((grid_tie_t*)arg);
+}
+
 #if IS_ADC_CORE
 static void ADC_Callback(adc_measures_t* result)
 {
+#if ADC_FAST_PROTECTION
+	// rearm the protection when the user enables the outputs again
+	if ((boostStateUpdateRequest.isPending && boostStateUpdateRequest.state) ||
+			(inverterStateUpdateRequest.isPending && inverterStateUpdateRequest.state))
+		BSP_ADC_ResetProtection();
+#endif
 	if (boostStateUpdateRequest.isPending)
 	{
 		boostStateUpdateRequest.err = GridTie_EnableBoost(&gridTieConfig, boostStateUpdateRequest.state);
@@ -80,6 +144,9 @@ static void ADC_Callback(adc_measures_t* result)
 			(void)BSP_ADC_SetInputOutputTrigger(&_slaveConfig, NULL, CONTROL_FREQUENCY_Hz);
 			(void) BSP_ADC_Run();
 			adcMode = ADC_MODE_CONTROL;
+#if TRACE_ENABLE
+			Trace_Log(TRACE_EVT_MODE, ADC_MODE_CONTROL, (uint32_t)CONTROL_FREQUENCY_Hz);
+#endif
 		}
 	}
 	else
@@ -90,6 +157,9 @@ static void ADC_Callback(adc_measures_t* result)
 			(void)BSP_ADC_SetInputOutputTrigger(NULL, NULL, MONITORING_FREQUENCY_Hz);
 			(void) BSP_ADC_Run();
 			adcMode = ADC_MODE_MONITORING;
+#if TRACE_ENABLE
+			Trace_Log(TRACE_EVT_MODE, ADC_MODE_MONITORING, (uint32_t)MONITORING_FREQUENCY_Hz);
+#endif
 		}
 	}
 	MainControl_Loop(result);
@@ -119,6 +189,14 @@ void MainControl_Init(void)
 	gridTieConfig.boostDiodePin[2] = 11;
 	GridTieControl_Init(&gridTieConfig, NULL);
 
+	// the cycle counter is used for the budget of the executive
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	// the budget of each tick is the rest of the control period after the ADC conversion
+	executive.periodCycles = SystemCoreClock / CONTROL_FREQUENCY_Hz;
+	(void)Executive_AddTask(&executive, ControlTask, &gridTieConfig, 1, 0, 1);
+	(void)Executive_AddTask(&executive, RelayTask, &gridTieConfig, RELAY_CONTROL_DIVIDER, EXECUTIVE_AUTO_PHASE, 1);
+
 	MainControl_Run();
 
 #if IS_ADC_CORE
@@ -126,6 +204,9 @@ void MainControl_Init(void)
 			.callback = ADC_Callback,
 			.fs = MONITORING_FREQUENCY_Hz };
 	BSP_ADC_Init(ADC_MODE_CONT, &adcConfig, &RAW_ADC_DATA, &PROCESSED_ADC_DATA);
+#if ADC_FAST_PROTECTION
+	Protection_Init();
+#endif
 	(void) BSP_ADC_Run();
 #endif
 }
@@ -161,8 +242,13 @@ static void MainControl_Loop(adc_measures_t* result)
 	gridTieConfig.iCoor.abc.b = result->Ch2;
 	gridTieConfig.iCoor.abc.c = result->Ch3;
 
-	// implement the control
-	GridTieControl_Loop(&gridTieConfig);
+	// implement the control and the slower tasks
+#if IS_ADC_CORE && DEADLINE_MONITOR_ENABLE
+	// the deadline monitor time stamps the ADC interrupt before the data collection and conversion
+	(void)Executive_TickFrom(&executive, BSP_MAX11046_GetDeadlineMonitor()->entryCycles);
+#else
+	(void)Executive_Tick(&executive);
+#endif
 }
 
 /* EOF */
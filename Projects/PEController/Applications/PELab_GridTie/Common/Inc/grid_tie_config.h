@@ -133,6 +133,10 @@ extern "C" {
 #define GRID_RELAY_IO					(15)
 #endif
 
+/**
+ * @brief The relays are controlled once in this no of control cycles
+ */
+#define RELAY_CONTROL_DIVIDER			(10)
 /**
  * @brief Defines the turn on condition for the relay
  */
@@ -141,6 +145,18 @@ extern "C" {
  * @brief Defines the turn off condition for the relay
  */
 #define RELAY_TURN_OFF_VDC				(500.f)
+/**
+ * @brief Maximum instantaneous inverter current before the fast protection disables the PWM outputs
+ */
+#define PROTECTION_MAX_CURRENT			(40.f)
+/**
+ * @brief Maximum DC link voltage before the fast protection disables the PWM outputs
+ */
+#define PROTECTION_MAX_VDC				(850.f)
+/**
+ * @brief No of consecutive samples beyond the limits before the fast protection trips
+ */
+#define PROTECTION_DEBOUNCE_COUNT		(3)
 /**
  * @brief Dead time value in nano-seconds for the inverter
  */
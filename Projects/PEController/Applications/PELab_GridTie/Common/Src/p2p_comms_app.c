@@ -67,6 +67,23 @@ data_param_info_t p2pCommsParams[P2P_PARAM_COUNT] =
 		{ .name = "Precharge Relay Status", .index = P2P_RELAY_STATUS, .type = DTYPE_BOOL },
 		{ .name = "PLL Status", .index = P2P_PLL_STATUS, .type = DTYPE_BOOL},
 };
+/**
+ * @brief Indices of @ref p2pCommsParams sorted in ascending order of their names.
+ * @details Used by @ref P2PComms_FindParameterByName() for binary search of parameters by name.
+ * @note Keep this table sorted (ASCII order) whenever a name is added or changed in @ref p2pCommsParams.
+ */
+const uint8_t p2pCommsParamsNameIndex[P2P_PARAM_COUNT] =
+{
+		P2P_PARAM_BOOST_EN,
+		P2P_PARAM_INV_EN,
+		P2P_PARAM_L_OUT_mH,
+		P2P_PARAM_f_GRID,
+		P2P_PARAM_V_GRID,
+		P2P_PARAM_PLL_STS,
+		P2P_PARAM_RELAY_STS,
+		P2P_PARAM_I_RMS,
+		P2P_PARAM_I_RMS_REQ,
+};
 #endif
 /********************************************************************************
  * Function Prototypes
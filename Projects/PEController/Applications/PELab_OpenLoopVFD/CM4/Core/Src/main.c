@@ -156,6 +156,7 @@ int main(void)
 	static state_storage_client_t storageClients[3];
 	storageConfig.clientCount = 3;
 	storageConfig.clients = storageClients;
+	storageConfig.isCompressionEnabled = true;
 	storageClients[0].arg = (void*)&PROCESSED_ADC_DATA;
 	BSP_ADC_ConfigStorage(&storageClients[0]);
 	ScreenData_ConfigStorage(&storageClients[1]);
@@ -192,6 +193,7 @@ int main(void)
 
   /* USER CODE BEGIN RTOS_SEMAPHORES */
 	/* add semaphores, ... */
+	P2PComms_InitNotifications();
   /* USER CODE END RTOS_SEMAPHORES */
 
   /* USER CODE BEGIN RTOS_TIMERS */
@@ -420,7 +422,8 @@ void StartStorageTask(void *argument)
 	for(;;)
 	{
 		StateStorage_Refresh();
-		osDelay(2000);
+		// poll faster while the background operations are in progress
+		osDelay(StateStorage_IsBusy() ? 10 : 2000);
 	}
   /* USER CODE END 5 */
 }
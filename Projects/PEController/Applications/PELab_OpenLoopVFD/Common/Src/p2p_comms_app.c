@@ -78,6 +78,32 @@ data_param_info_t p2pCommsParams[P2P_PARAM_COUNT] =
 		{ .name = "Direction\n(INV 2)", .index = P2P_INV2_DIRECTION, .type = DTYPE_BOOL },
 		{ .name = "m (INV 2)", .index = P2P_INV2_m, .type = DTYPE_FLOAT,  .arg = 2, .unit = UNIT_NONE},
 };
+/**
+ * @brief Indices of @ref p2pCommsParams sorted in ascending order of their names.
+ * @details Used by @ref P2PComms_FindParameterByName() for binary search of parameters by name.
+ * @note Keep this table sorted (ASCII order) whenever a name is added or changed in @ref p2pCommsParams.
+ */
+const uint8_t p2pCommsParamsNameIndex[P2P_PARAM_COUNT] =
+{
+		P2P_PARAM_a_INV1,
+		P2P_PARAM_a_INV2,
+		P2P_PARAM_DIR_REQ_INV1,
+		P2P_PARAM_DIR_INV1,
+		P2P_PARAM_DIR_REQ_INV2,
+		P2P_PARAM_DIR_INV2,
+		P2P_PARAM_EN_INV1,
+		P2P_PARAM_EN_INV2,
+		P2P_PARAM_f_INV1,
+		P2P_PARAM_f_INV2,
+		P2P_PARAM_f_NOM_INV1,
+		P2P_PARAM_f_NOM_INV2,
+		P2P_PARAM_m_NOM_INV1,
+		P2P_PARAM_m_NOM_INV2,
+		P2P_PARAM_f_REQ_INV1,
+		P2P_PARAM_f_REQ_INV2,
+		P2P_PARAM_m_INV1,
+		P2P_PARAM_m_INV2,
+};
 #endif
 /********************************************************************************
  * Function Prototypes
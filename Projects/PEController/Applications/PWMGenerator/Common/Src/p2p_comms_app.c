@@ -55,6 +55,15 @@ data_param_info_t p2pCommsParams[P2P_PARAM_COUNT] =
 {
 		{ .name = "PWM Phase Shift (0 - 180 degrees)", .index = P2P_PARAM_PHASE_SHIFT, .type = DTYPE_FLOAT, .arg = 0, .unit = UNIT_NONE },
 };
+/**
+ * @brief Indices of @ref p2pCommsParams sorted in ascending order of their names.
+ * @details Used by @ref P2PComms_FindParameterByName() for binary search of parameters by name.
+ * @note Keep this table sorted (ASCII order) whenever a name is added or changed in @ref p2pCommsParams.
+ */
+const uint8_t p2pCommsParamsNameIndex[P2P_PARAM_COUNT] =
+{
+		P2P_PARAM_PHASE_SHIFT,
+};
 #endif
 /********************************************************************************
  * Function Prototypes
@@ -0,0 +1,102 @@
+/**
+ ********************************************************************************
+ * @file 		cmsis_os.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Host replacement of the CMSIS-RTOS2 functions used by the BSP, running the tasks as host threads.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+#ifndef CMSIS_OS_H
+#define CMSIS_OS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/** @addtogroup Host_BSP
+ * @{
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+/** Duration of a kernel tick in microseconds */
+#define HOST_RTOS_TICK_US				(1000)
+#define osWaitForever					(0xFFFFFFFFU)
+#define osFlagsWaitAny					(0x00000000U)
+#define osFlagsWaitAll					(0x00000001U)
+#define osFlagsNoClear					(0x00000002U)
+#define osFlagsError					(0x80000000U)
+#define osFlagsErrorTimeout				(0xFFFFFFFEU)
+#define osFlagsErrorResource			(0xFFFFFFFDU)
+/*******************************************************************************
+ * Typedefs
+ ******************************************************************************/
+/** Identifies a host thread */
+typedef void* osThreadId_t;
+typedef enum
+{
+	osOK = 0,
+	osError = -1,
+	osErrorTimeout = -2,
+	osErrorResource = -3,
+	osErrorParameter = -4,
+} osStatus_t;
+/*******************************************************************************
+ * Exported Variables
+ ******************************************************************************/
+/** No of calls to osThreadFlagsWait() which timed out */
+extern volatile uint32_t hostRtosTimeoutCount;
+/*******************************************************************************
+ * Global Function Prototypes
+ ******************************************************************************/
+/**
+ * @brief Gets the identifier of the calling thread.
+ * @return osThreadId_t Identifier of the thread
+ */
+extern osThreadId_t osThreadGetId(void);
+/**
+ * @brief Sets the flags of a thread and wakes it up if it waits for them.
+ * @param thread_id Identifier of the thread.
+ * @param flags Flags to be set.
+ * @return uint32_t Flags of the thread after setting
+ */
+extern uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags);
+/**
+ * @brief Waits for the flags of the calling thread.
+ * @param flags Flags to wait for.
+ * @param options Combination of osFlagsWaitAny, osFlagsWaitAll and osFlagsNoClear.
+ * @param timeout Timeout in ticks, 0 to return immediately or osWaitForever.
+ * @return uint32_t Flags before clearing, else osFlagsErrorTimeout or osFlagsErrorResource
+ */
+extern uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout);
+/**
+ * @brief Suspends the calling thread.
+ * @param ticks No of ticks to wait.
+ * @return osStatus_t osOK
+ */
+extern osStatus_t osDelay(uint32_t ticks);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+#endif
+/* EOF */
@@ -0,0 +1,95 @@
+/**
+ ********************************************************************************
+ * @file 		host_bsp.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Forced include of the BSP host tests, which maps the peripherals to host memory.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+#ifndef HOST_BSP_H
+#define HOST_BSP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/** @defgroup Host_BSP Host BSP
+ * @brief Builds the unmodified BSP drivers and the STM32H7 HAL for the host.
+ * @details Every source of a BSP test is compiled with <c>-include host_bsp.h</c>. The CMSIS compiler
+ * header is replaced by @ref host_cmsis_gcc.h and the peripherals used by the drivers are redirected from
+ * their bus addresses to the register blocks defined in host_bsp.c, where the register models
+ * (e.g. @ref HRTIM_Model) act upon them. The NVIC functions of the HAL record the enabled interrupts, and
+ * @ref HostBsp_RaiseIrq() calls the interrupt handlers of the application in the same way as the vector table.
+ * @{
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdbool.h>
+#include "host_cmsis_gcc.h"
+#include "stm32h7xx_hal.h"
+/*******************************************************************************
+ * Exported Variables
+ ******************************************************************************/
+extern HRTIM_TypeDef hostHRTIM1;
+extern TIM_TypeDef hostTIM1;
+extern TIM_TypeDef hostTIM2;
+extern TIM_TypeDef hostTIM3;
+extern RCC_TypeDef hostRCC;
+extern GPIO_TypeDef hostGPIOB;
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#undef HRTIM1
+#define HRTIM1							(&hostHRTIM1)
+#undef TIM1
+#define TIM1							(&hostTIM1)
+#undef TIM2
+#define TIM2							(&hostTIM2)
+#undef TIM3
+#define TIM3							(&hostTIM3)
+#undef RCC
+#define RCC								(&hostRCC)
+#undef GPIOB
+#define GPIOB							(&hostGPIOB)
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/**
+ * @brief Checks if the interrupt is enabled in the emulated NVIC.
+ * @param irq Interrupt number
+ * @return bool <c>true</c> if enabled by HAL_NVIC_EnableIRQ()
+ */
+extern bool HostBsp_IsIrqEnabled(IRQn_Type irq);
+/**
+ * @brief Calls the handler of the interrupt if it is enabled in the emulated NVIC and not masked by PRIMASK.
+ * @param irq Interrupt number
+ * @return bool <c>true</c> if the handler is called
+ */
+extern bool HostBsp_RaiseIrq(IRQn_Type irq);
+/**
+ * @brief Gets the number of calls to Error_Handler() since the start of the test.
+ * @return int Number of errors reported by the drivers
+ */
+extern int HostBsp_GetErrorCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+#endif
+/* EOF */
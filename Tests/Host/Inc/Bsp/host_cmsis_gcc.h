@@ -0,0 +1,87 @@
+/**
+ ********************************************************************************
+ * @file 		host_cmsis_gcc.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Host replacement of the CMSIS compiler header for the BSP tests.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+/* Uses the guard of the CMSIS header so that the Cortex-M intrinsics are never included */
+#ifndef __CMSIS_GCC_H
+#define __CMSIS_GCC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/** @addtogroup Host_BSP
+ * @{
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define __ASM							__asm
+#define __INLINE						inline
+#define __STATIC_INLINE					static inline
+#define __STATIC_FORCEINLINE			static inline __attribute__((always_inline))
+#define __NO_RETURN						__attribute__((__noreturn__))
+#define __USED							__attribute__((used))
+#define __WEAK							__attribute__((weak))
+#define __PACKED						__attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT					struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION					union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)					__attribute__((aligned(x)))
+#define __RESTRICT						__restrict
+#define __COMPILER_BARRIER()			__asm volatile("" ::: "memory")
+/*******************************************************************************
+ * Exported Variables
+ ******************************************************************************/
+/** Emulated PRIMASK register of the core running the current thread. The simulated interrupts are not raised
+ * while it is set */
+extern _Thread_local uint32_t hostPrimask;
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+static inline void __enable_irq(void) { hostPrimask = 0; }
+static inline void __disable_irq(void) { hostPrimask = 1; }
+static inline uint32_t __get_PRIMASK(void) { return hostPrimask; }
+static inline void __set_PRIMASK(uint32_t priMask) { hostPrimask = priMask; }
+static inline uint32_t __get_IPSR(void) { return 0; }
+static inline void __DSB(void) { __sync_synchronize(); }
+static inline void __ISB(void) { __sync_synchronize(); }
+static inline void __DMB(void) { __sync_synchronize(); }
+static inline void __NOP(void) { }
+static inline uint32_t __REV(uint32_t value) { return __builtin_bswap32(value); }
+static inline uint8_t __CLZ(uint32_t value) { return value ? __builtin_clz(value) : 32; }
+static inline uint32_t __RBIT(uint32_t value)
+{
+	uint32_t result = 0;
+	for (int i = 0; i < 32; i++, value >>= 1)
+		result = (result << 1) | (value & 1);
+	return result;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+#endif
+/* EOF */
@@ -0,0 +1,59 @@
+/**
+ ********************************************************************************
+ * @file 		host_cycles.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Forced include of the timing tests, which replaces the cycle counter by a synthetic clock.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+#ifndef HOST_CYCLES_H
+#define HOST_CYCLES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/** @addtogroup Host_BSP
+ * @{
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "host_bsp.h"
+/*******************************************************************************
+ * Exported Variables
+ ******************************************************************************/
+/** Synthetic clock advanced by the test */
+extern uint32_t hostCycles;
+extern DWT_Type hostDWT;
+extern CoreDebug_Type hostCoreDebug;
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define PROFILER_GET_CYCLES()			(hostCycles)
+#define DEADLINE_GET_CYCLES()			(hostCycles)
+#undef DWT
+#define DWT								(&hostDWT)
+#undef CoreDebug
+#define CoreDebug						(&hostCoreDebug)
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+#endif
+/* EOF */
@@ -0,0 +1,83 @@
+/**
+ ********************************************************************************
+ * @file 		host_p2p.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Forced include of the inter-core communication tests, which link the code of both cores.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+#ifndef HOST_P2P_H
+#define HOST_P2P_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/** @addtogroup Host_BSP
+ * @{
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "host_bsp.h"
+/*******************************************************************************
+ * Exported Variables
+ ******************************************************************************/
+extern HSEM_TypeDef hostHSEM;
+extern HSEM_Common_TypeDef hostHSEMCommon;
+extern SCB_Type hostSCB;
+extern CoreDebug_Type hostCoreDebug;
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#undef HSEM
+#define HSEM							(&hostHSEM)
+#undef HSEM_COMMON
+#define HSEM_COMMON						(&hostHSEMCommon)
+#undef SCB
+#define SCB								(&hostSCB)
+/** The cycle counter follows the monotonic clock of the host at SystemCoreClock */
+#undef DWT
+#define DWT								(HostP2P_GetDWT())
+#undef CoreDebug
+#define CoreDebug						(&hostCoreDebug)
+/** Masking the interrupts also holds off the emulated hardware semaphore interrupt raised by the other thread */
+#define __disable_irq()					HostP2P_DisableIrq()
+#define __enable_irq()					HostP2P_EnableIrq()
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/**
+ * @brief Updates the emulated cycle counter from the monotonic clock of the host.
+ * @return DWT_Type* Pointer to the emulated DWT
+ */
+extern DWT_Type* HostP2P_GetDWT(void);
+/**
+ * @brief Masks the interrupts of the calling thread, including the emulated hardware semaphore interrupt.
+ */
+extern void HostP2P_DisableIrq(void);
+/**
+ * @brief Unmasks the interrupts masked by @ref HostP2P_DisableIrq().
+ */
+extern void HostP2P_EnableIrq(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+#endif
+/* EOF */
@@ -0,0 +1,69 @@
+/**
+ ********************************************************************************
+ * @file 		host_trace.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Forced include of the trace tests, which runs the cores as host threads.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+#ifndef HOST_TRACE_H
+#define HOST_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/** @addtogroup Host_BSP
+ * @{
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "host_bsp.h"
+/*******************************************************************************
+ * Exported Variables
+ ******************************************************************************/
+/** Ring written by the current thread, i.e. the emulated core */
+extern _Thread_local uint8_t hostTraceRing;
+extern DWT_Type hostDWT;
+extern CoreDebug_Type hostCoreDebug;
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define TRACE_LOCAL_RING				(hostTraceRing)
+#define TRACE_GET_TIMESTAMP()			HostTrace_GetTimestamp()
+#undef DWT
+#define DWT								(&hostDWT)
+#undef CoreDebug
+#define CoreDebug						(&hostCoreDebug)
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/**
+ * @brief Gets the time stamp of the event being logged by the current thread.
+ * @details Called by Trace_Log() between the reservation and the completion of a record, where the test
+ * emulates the interrupts preempting the writer.
+ * @return uint32_t Time stamp of the event
+ */
+extern uint32_t HostTrace_GetTimestamp(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+#endif
+/* EOF */
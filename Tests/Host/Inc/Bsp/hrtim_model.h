@@ -0,0 +1,166 @@
+/**
+ ********************************************************************************
+ * @file 		hrtim_model.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Host register model of the HRTIM and TIM1 driving the PWM outputs.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+#ifndef HRTIM_MODEL_H
+#define HRTIM_MODEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/** @defgroup HRTIM_Model HRTIM Model
+ * @brief Cycle based model of the HRTIM and TIM1 registers behind the PWM outputs 1-16.
+ * @details The model acts upon the register blocks @ref hostHRTIM1 and @ref hostTIM1, which are written by the
+ * unmodified HAL and PWM drivers, and generates the levels of the PWM pins. The simulated time advances
+ * in steps of the HRTIM clock (480 MHz), while TIM1 runs at half of this rate.
+ *
+ * <b>HRTIM</b>
+ * - The master and timer units count from 0 to the period - 1 and roll over, so that a period of N ticks
+ * generates the frequency fHRTIM / N as assumed by the drivers.
+ * - The compare, period and repetition registers are preloaded if PREEN is set. The active copies are
+ * updated on roll-over or reset (TRSTU), on repetition (TREPU / MREPU) and on the software update, unless
+ * the update is disabled in CR1. While a unit is stopped its active registers follow the preloaded ones.
+ * - The timer counters are reset by the master period and compare events selected in RSTxR.
+ * - The outputs are set and reset by the local and master events selected in SETx1R ... RSTx2R, where the
+ * reset has priority over a simultaneous set.
+ * - With dead time insertion, both outputs are derived from the first output. The rising and falling
+ * dead times delay the edges as selected by their signs, with the resolution of the simulation clock.
+ * - An enabled output drives its level XOR the polarity, while a disabled output drives its idle level.
+ *
+ * <b>TIM1</b>
+ * - Edge aligned up counting and center aligned counting with the repetition counter.
+ * - PWM mode 1 and 2 for channels 1-3, the preloaded compare registers and the complementary outputs with
+ * the dead time generator. An output whose CCxE / CCxNE or MOE bit is cleared is at high impedance.
+ *
+ * <b>Register access</b><br>
+ * The registers with write-one semantics (ODISR, OENR, CR2, TIMxICR, MICR, EGR) and the writes of SR are
+ * processed at the start of @ref HrtimModel_Run() and after each interrupt handler. Output disables take
+ * precedence over enables written in the same interval. The interrupts are raised by the events, which
+ * set the status flags, and call the handlers through @ref HostBsp_RaiseIrq().
+ *
+ * All level changes and register transfers are recorded with their time stamps for the checks and the
+ * VCD export (@ref HrtimModel_WriteVcd()).
+ * @{
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+/** @brief Frequency of the simulation clock, which is the HRTIM clock */
+#define HRTIM_MODEL_CLOCK_Hz			(480000000U)
+/** @brief Number of modelled PWM pins */
+#define HRTIM_MODEL_PWM_COUNT			(16)
+/** @brief Level of a pin not driven by the timer */
+#define HRTIM_MODEL_LEVEL_Z				(2)
+/** @brief Maximum number of recorded edges */
+#define HRTIM_MODEL_MAX_EDGES			(1U << 18)
+/** @brief Maximum number of recorded register transfers */
+#define HRTIM_MODEL_MAX_UPDATES			(1U << 16)
+/** @brief Unit index of TIM1 in the update timeline. The HRTIM units use HRTIM_TIMERINDEX_x */
+#define HRTIM_MODEL_UNIT_TIM1			(6)
+/*******************************************************************************
+ * Structures
+ ******************************************************************************/
+/**
+ * @brief Defines a level change of a PWM pin.
+ */
+typedef struct
+{
+	uint64_t time;						/**< Simulation ticks at which the new level is driven */
+	uint8_t pwmNo;						/**< PWM pin (Range 1-16) */
+	uint8_t level;						/**< New level (0, 1 or @ref HRTIM_MODEL_LEVEL_Z) */
+} hrtim_model_edge_t;
+/**
+ * @brief Defines a transfer of the preloaded registers to the active registers.
+ */
+typedef struct
+{
+	uint64_t time;						/**< Simulation ticks of the transfer */
+	uint8_t unit;						/**< HRTIM_TIMERINDEX_x or @ref HRTIM_MODEL_UNIT_TIM1 */
+	uint32_t period;					/**< Active period */
+	uint32_t compares[4];				/**< Active compare values (CCR1-3 for TIM1) */
+} hrtim_model_update_t;
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/**
+ * @brief Resets the registers, the simulation time and the timelines.
+ * @note Call before configuring the PWM drivers.
+ */
+extern void HrtimModel_Init(void);
+/**
+ * @brief Runs the simulation for the given time.
+ * @param ticks Number of simulation clock ticks (@ref HRTIM_MODEL_CLOCK_Hz)
+ */
+extern void HrtimModel_Run(uint64_t ticks);
+/**
+ * @brief Gets the simulation time.
+ * @return uint64_t Ticks since @ref HrtimModel_Init()
+ */
+extern uint64_t HrtimModel_GetTime(void);
+/**
+ * @brief Gets the current level of a PWM pin.
+ * @param pwmNo PWM pin (Range 1-16)
+ * @return int 0, 1 or @ref HRTIM_MODEL_LEVEL_Z
+ */
+extern int HrtimModel_GetOutput(uint32_t pwmNo);
+/**
+ * @brief Finds the first edge of a pin to the given level at or after the given time.
+ * @param pwmNo PWM pin (Range 1-16)
+ * @param level Required level
+ * @param from Start of the search in simulation ticks
+ * @return uint64_t Time of the edge, or UINT64_MAX if no such edge is recorded
+ */
+extern uint64_t HrtimModel_FindEdge(uint32_t pwmNo, int level, uint64_t from);
+/**
+ * @brief Gets the recorded edges in the order of time.
+ * @param count Filled with the number of edges
+ * @return const hrtim_model_edge_t* Recorded edges
+ */
+extern const hrtim_model_edge_t* HrtimModel_GetEdges(int* count);
+/**
+ * @brief Gets the recorded register transfers in the order of time.
+ * @param count Filled with the number of transfers
+ * @return const hrtim_model_update_t* Recorded transfers
+ */
+extern const hrtim_model_update_t* HrtimModel_GetUpdates(int* count);
+/**
+ * @brief Clears the timelines. The current levels become the initial levels of the VCD export.
+ */
+extern void HrtimModel_ClearTimeline(void);
+/**
+ * @brief Writes the recorded edges of all pins as a value change dump.
+ * @param path Path of the file
+ * @return bool <c>true</c> if successful
+ */
+extern bool HrtimModel_WriteVcd(const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+#endif
+/* EOF */
@@ -0,0 +1,83 @@
+/**
+ ********************************************************************************
+ * @file 		shared_memory_layout.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Layout of the shared memory as compiled for each core.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+#ifndef SHARED_MEMORY_LAYOUT_H
+#define SHARED_MEMORY_LAYOUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/** @addtogroup Host_BSP
+ * @{
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stddef.h>
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+/** Core writing to a field of the shared memory */
+#define LAYOUT_WRITER_CONTROL			(0)
+#define LAYOUT_WRITER_COMMS				(1)
+/** The field is written by both cores in turns, e.g. a request and its response */
+#define LAYOUT_WRITER_BOTH				(2)
+/** The field is a top level member of the shared data */
+#define LAYOUT_WRITER_REGION			(3)
+/*******************************************************************************
+ * Structures
+ ******************************************************************************/
+/**
+ * @brief Defines the location of a field in the shared memory.
+ */
+typedef struct
+{
+	const char* name;					/**< Name of the field */
+	size_t offset;						/**< Offset of the field in shared_data_t */
+	size_t size;						/**< Size of the field in bytes */
+	int writer;							/**< Core writing the field. Use LAYOUT_WRITER_xxx values */
+} layout_field_t;
+/**
+ * @brief Defines the layout of the shared memory as compiled for a core.
+ */
+typedef struct
+{
+	size_t size;						/**< Size of shared_data_t */
+	size_t alignment;					/**< Alignment of shared_data_t */
+	size_t fieldCount;					/**< No of fields in the table */
+	const layout_field_t* fields;		/**< Fields of the shared memory */
+} shared_memory_layout_t;
+/*******************************************************************************
+ * Exported Variables
+ ******************************************************************************/
+/** Layout compiled for the CM7 core */
+extern const shared_memory_layout_t layoutCM7;
+/** Layout compiled for the CM4 core */
+extern const shared_memory_layout_t layoutCM4;
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+#endif
+/* EOF */
@@ -0,0 +1,134 @@
+/**
+ ********************************************************************************
+ * @file 		flash_emulator.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Host model of the STM32H7 flash sectors used by the state storage.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+#ifndef FLASH_EMULATOR_H
+#define FLASH_EMULATOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/** @defgroup Flash_Emulator Flash Emulator
+ * @brief Host model of the STM32H7 flash sectors used by the state storage.
+ * @details The model enforces the programming semantics of the STM32H7 flash:
+ * - Flash words of 256 bits are programmed at 32 byte aligned addresses.
+ * - Erased bits read as 1. A flash word can only be programmed once after the erase, so any
+ * 0 to 1 transition or reprogramming is rejected.
+ * - Sector erases run in the background and complete after the configured latency.
+ *
+ * The simulated time is kept in the host cycle counter (DWT->CYCCNT), which is advanced by the
+ * program and erase latencies and by @ref FlashEmulator_Advance(). A power cut can be injected
+ * during any program or erase operation. The interrupted flash word is left partially programmed,
+ * or the interrupted sector partially erased, before jumping to the point saved by the test.
+ * @{
+ */
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <setjmp.h>
+#include "state_storage_lib.h"
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+/** @brief Frequency of the simulated cycle counter */
+#define FLASH_EMULATOR_CLOCK_Hz			(480000000U)
+/*******************************************************************************
+ * Structures
+ ******************************************************************************/
+/**
+ * @brief Defines the timing and fault configuration of the flash model.
+ */
+typedef struct
+{
+	uint32_t programCycles;				/**< Latency of programming a single flash word */
+	uint32_t eraseCycles;				/**< Latency of a sector erase */
+	uint32_t pollCycles;				/**< Time between the busy checks of a background erase */
+	uint32_t powerCutOp;				/**< Power is cut during this program or erase operation. Set to 0 to disable */
+	jmp_buf* powerCutJump;				/**< Point to return to after the power cut */
+	int faultySector;					/**< Index of a sector failing all operations. Set to -1 to disable */
+} flash_emulator_config_t;
+/**
+ * @brief Defines the statistics of the flash model.
+ */
+typedef struct
+{
+	uint64_t opCount;								/**< No of program and erase operations */
+	uint64_t programCount;							/**< No of programmed flash words */
+	uint64_t programBytes;							/**< No of programmed bytes */
+	uint64_t rejectedCount;							/**< No of programs rejected for non erased or unaligned flash words */
+	uint64_t eraseCount;							/**< No of sector erases */
+	uint64_t eraseCounts[STATE_STORAGE_MAX_SECTORS];/**< No of erases of each sector */
+	uint64_t cycles;								/**< Simulated time */
+	uint64_t busyCycles;							/**< Time spent programming and erasing */
+	uint32_t powerCutCount;							/**< No of injected power cuts */
+} flash_emulator_stats_t;
+/*******************************************************************************
+ * Exported Variables
+ ******************************************************************************/
+/** @brief Configuration of the flash model. Can be changed at any time */
+extern flash_emulator_config_t flashEmulatorConfig;
+/** @brief Statistics of the flash model */
+extern flash_emulator_stats_t flashEmulatorStats;
+/*******************************************************************************
+ * Global Function Prototypes
+ ******************************************************************************/
+/**
+ * @brief Creates erased sectors and connects them to the state storage configuration.
+ * @details The flash contents are kept by later calls with the same sector layout, so that the storage can be
+ * initialized again after a power cut.
+ * @param storage Storage configuration to be connected.
+ * @param sectorCount No of sectors.
+ * @param sectorBytes Size of each sector in bytes.
+ * @param keepContents If <c>true</c> the current contents are kept, else all sectors are erased.
+ */
+extern void FlashEmulator_Init(state_storage_config_t* storage, int sectorCount, uint32_t sectorBytes, bool keepContents);
+/**
+ * @brief Clears the statistics of the flash model.
+ */
+extern void FlashEmulator_ResetStats(void);
+/**
+ * @brief Advances the simulated time.
+ * @param cycles No of cycles.
+ */
+extern void FlashEmulator_Advance(uint32_t cycles);
+/**
+ * @brief Gets the next value of the pseudo random sequence used for the partial operations and the tests.
+ * @return Pseudo random value.
+ */
+extern uint32_t FlashEmulator_Random(void);
+/**
+ * @brief Sets the seed of the pseudo random sequence.
+ * @param seed Non-zero seed.
+ */
+extern void FlashEmulator_Seed(uint32_t seed);
+/**
+ * @brief Prints the statistics of the flash model.
+ * @param title Title of the report.
+ * @param updateCount No of state updates in the report, used to normalize the results. Use 0 to skip.
+ */
+extern void FlashEmulator_PrintReport(const char* title, uint32_t updateCount);
+/**
+ * @}
+ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/* EOF */
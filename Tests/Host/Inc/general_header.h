@@ -0,0 +1,113 @@
+/**
+ ********************************************************************************
+ * @file 		general_header.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Host replacement of the BSP general header for the host tests.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+#ifndef GENERAL_HEADER_H
+#define GENERAL_HEADER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define __weak							__attribute__((weak))
+#define TCritical
+#define IS_CONTROL_CORE					(1)
+#define IS_COMMS_CORE					(1)
+/* HAL flash definitions used by the default flash operations of the state storage */
+#define HAL_OK							(0)
+#define HAL_ERROR						(1)
+#define HAL_TIMEOUT						(3)
+#define FLASH_TYPEPROGRAM_FLASHWORD		(1)
+#define FLASH_VOLTAGE_RANGE_4			(3)
+#define FLASH_BANK_1					(1)
+#define FLASH_BANK_2					(2)
+#define FLASH_CR_SER					(1U << 2)
+#define FLASH_CR_SNB					(7U << 8)
+#define CoreDebug_DEMCR_TRCENA_Msk		(1U << 24)
+#define DWT_CTRL_CYCCNTENA_Msk			(1U)
+#define DWT								(&hostDWT)
+#define CoreDebug						(&hostCoreDebug)
+#define FLASH							(&hostFlash)
+/*******************************************************************************
+ * Structures
+ ******************************************************************************/
+typedef struct
+{
+	volatile uint32_t CTRL;
+	volatile uint32_t CYCCNT;
+} host_dwt_t;
+typedef struct
+{
+	volatile uint32_t DEMCR;
+} host_core_debug_t;
+typedef struct
+{
+	volatile uint32_t CR1;
+	volatile uint32_t CR2;
+} host_flash_t;
+/*******************************************************************************
+ * Exported Variables
+ ******************************************************************************/
+/** @brief Cycle counter of the host tests. Advanced by the device models */
+extern host_dwt_t hostDWT;
+extern host_core_debug_t hostCoreDebug;
+extern host_flash_t hostFlash;
+/*******************************************************************************
+ * Global Function Prototypes
+ ******************************************************************************/
+/**
+ * @brief Reports the fatal errors detected by the modules under test.
+ */
+extern void Error_Handler(void);
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+/* The HAL flash driver is replaced by the flash emulator in the host tests */
+static inline int HAL_FLASH_Program(uint32_t type, uint32_t addr, uint32_t data)
+{
+	(void)type; (void)addr; (void)data;
+	return HAL_ERROR;
+}
+static inline int FLASH_WaitForLastOperation(uint32_t timeout, uint32_t bank)
+{
+	(void)timeout; (void)bank;
+	return HAL_OK;
+}
+static inline void FLASH_Erase_Sector(uint32_t sector, uint32_t bank, uint32_t voltageRange)
+{
+	(void)sector; (void)bank; (void)voltageRange;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/* EOF */
@@ -0,0 +1,46 @@
+/**
+ ********************************************************************************
+ * @file 		host_executive.h
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Forced include of the executive simulation, which replaces the cycle counter by a synthetic clock.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+#ifndef HOST_EXECUTIVE_H
+#define HOST_EXECUTIVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+/*******************************************************************************
+ * Exported Variables
+ ******************************************************************************/
+/** Synthetic clock advanced by the simulated work */
+extern uint32_t hostCycles;
+/*******************************************************************************
+ * Defines
+ ******************************************************************************/
+#define EXECUTIVE_GET_CYCLES()			(hostCycles)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+/* EOF */
@@ -0,0 +1,293 @@
+/**
+ ********************************************************************************
+ * @file    	adc_protection_test.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Host replay test of the fast ADC protection of the grid tie application.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * The unmodified pecontroller_adc.c is built with the configuration of the grid tie application. The raw
+ * samples of the inverter currents and the DC link voltage are generated at the control frequency and replayed
+ * through BSP_ADC_CheckProtection() in the same way as the conversion interrupt, which checks them before the
+ * float conversion. BSP_PWMOut_ForceDisable() is stubbed to record the sample at which the outputs are
+ * disabled, which is compared with the onset of a short circuit. Spikes shorter than the debounce count
+ * should not trip the protection.
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include "user_config.h"
+#include "general_header.h"
+#include "pecontroller_adc.h"
+#include "pecontroller_pwm.h"
+#include "pecontroller_trace.h"
+#include "max11046_drivers.h"
+#include "grid_tie_config.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define SAMPLE_COUNT				(4000)
+#define SPIKE_SAMPLE				(500)
+#define FAULT_SAMPLE				(2000)
+#define GRID_FREQUENCY_Hz			(50.f)
+#define CURRENT_PEAK				(20.f)
+#define CURRENT_FULL_SCALE			(100.f)
+#define VDC_FULL_SCALE				(1000.f)
+#define VDC_NOMINAL					(700.f)
+#define SHORT_CIRCUIT_A_PER_us		(0.7f)
+#define SHORT_CIRCUIT_CHANNEL		(1)
+/** PWM outputs of the grid tie application disabled on a trip */
+#define PROTECTED_PWM_MASK			(0xfff)
+#define BENCHMARK_COUNT				(10000000)
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static uint16_t samples[SAMPLE_COUNT][TOTAL_MEASUREMENT_COUNT];
+static int sampleIndex;
+static int disableSample;
+static int disableCount;
+static uint32_t disableMask;
+static int callbackCount;
+static uint16_t callbackTripMask;
+static bool isCallbackAfterDisable;
+static int traceCount;
+static int failureCount = 0;
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+_Thread_local uint32_t hostPrimask;
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+void Error_Handler(void)
+{
+	failureCount++;
+}
+
+void BSP_PWMOut_ForceDisable(uint32_t pwmMask)
+{
+	if (disableCount++ == 0)
+		disableSample = sampleIndex;
+	disableMask = pwmMask;
+}
+
+void Trace_Log(uint16_t id, uint16_t param, uint32_t value)
+{
+	if (id == TRACE_EVT_FAULT)
+		traceCount++;
+}
+
+void BSP_MAX11046_Init(adc_acq_mode_t type, adc_cont_config_t* contConfig, volatile adc_raw_data_t* rawAdcData, volatile adc_processed_data_t* processedAdcData)
+{
+}
+
+adc_measures_t* BSP_MAX11046_Run(void)
+{
+	return NULL;
+}
+
+void BSP_MAX11046_Stop(void)
+{
+}
+
+void BSP_MAX11046_DeInit(void)
+{
+}
+
+timer_trigger_src_t BSP_MAX11046_SetInputOutputTrigger(tim_in_trigger_config_t* _slaveConfig, tim_out_trigger_config_t* _masterConfig, float _fs)
+{
+	return TIM_TRG_SRC_NONE;
+}
+
+static void Check(bool isPassed, const char* msg)
+{
+	if (isPassed)
+		return;
+	printf("  FAILED: %s\n", msg);
+	failureCount++;
+}
+
+static void Protection_Callback(uint16_t tripMask)
+{
+	callbackCount++;
+	callbackTripMask = tripMask;
+	isCallbackAfterDisable = disableCount > 0;
+}
+
+static double GetTimeNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief Sets the calibration of a channel in the same way as the ADC driver.
+ * @param fullScale Value of the channel at the full scale input of 10V
+ */
+static void SetCalibration(int index, float fullScale)
+{
+	adcSensitivity[index] = fullScale / 32768.f;
+	adcOffsets[index] = 32768.f;
+}
+
+static uint16_t GetRaw(float value, int index)
+{
+	float raw = value / adcSensitivity[index] + adcOffsets[index] + .5f;
+	return raw < 0 ? 0 : (raw > 65535.f ? 65535 : (uint16_t)raw);
+}
+
+/**
+ * @brief Generates the samples of the inverter currents and the DC link voltage at the control frequency.
+ * @details A single sample spike exceeds the current limit at @ref SPIKE_SAMPLE, while a short circuit starts
+ * in one phase at @ref FAULT_SAMPLE.
+ * @return int Index of the first sample beyond the limits after the short circuit
+ */
+static int GenerateSamples(void)
+{
+	int onset = -1;
+	float dt = 1.f / CONTROL_FREQUENCY_Hz;
+	for (int n = 0; n < SAMPLE_COUNT; n++)
+	{
+		float theta = 2 * (float)M_PI * GRID_FREQUENCY_Hz * n * dt;
+		for (int ph = 0; ph < 3; ph++)
+		{
+			float current = CURRENT_PEAK * sinf(theta - ph * 2 * (float)M_PI / 3);
+			if (n == SPIKE_SAMPLE && ph == 0)
+				current = 1.5f * PROTECTION_MAX_CURRENT;
+			if (n >= FAULT_SAMPLE && ph == SHORT_CIRCUIT_CHANNEL)
+				current += SHORT_CIRCUIT_A_PER_us * 1e6f * (n - FAULT_SAMPLE + 1) * dt;
+			samples[n][ph] = GetRaw(current, ph);
+			if (onset < 0 && n >= FAULT_SAMPLE && fabsf(current) > PROTECTION_MAX_CURRENT)
+				onset = n;
+		}
+		for (int ch = 3; ch < TOTAL_MEASUREMENT_COUNT; ch++)
+			samples[n][ch] = GetRaw(0, ch);
+		samples[n][8] = GetRaw(VDC_NOMINAL, 8);
+	}
+	return onset;
+}
+
+/**
+ * @brief Configures the protection as done by the grid tie application.
+ */
+static void ConfigProtection(void)
+{
+	adc_protection_config_t config = {
+			.channelMask = 0x107,
+			.debounceCount = PROTECTION_DEBOUNCE_COUNT,
+			.pwmMask = PROTECTED_PWM_MASK,
+			.callback = Protection_Callback };
+	for (int i = 0; i < TOTAL_MEASUREMENT_COUNT; i++)
+	{
+		config.min[i] = -1e9f;
+		config.max[i] = 1e9f;
+	}
+	for (int i = 0; i < 3; i++)
+	{
+		config.min[i] = -PROTECTION_MAX_CURRENT;
+		config.max[i] = PROTECTION_MAX_CURRENT;
+	}
+	config.min[8] = -PROTECTION_MAX_VDC;
+	config.max[8] = PROTECTION_MAX_VDC;
+	BSP_ADC_ConfigProtection(&config);
+}
+
+/**
+ * @brief Replays all samples in the order of the conversions.
+ */
+static void Replay(void)
+{
+	disableCount = 0;
+	disableSample = -1;
+	for (sampleIndex = 0; sampleIndex < SAMPLE_COUNT; sampleIndex++)
+		BSP_ADC_CheckProtection(samples[sampleIndex]);
+}
+
+/**
+ * @brief Replays a short circuit and checks the samples from the fault onset to the disable of the outputs.
+ */
+static void Test_ShortCircuit(void)
+{
+	for (int i = 0; i < TOTAL_MEASUREMENT_COUNT; i++)
+		SetCalibration(i, i == 8 ? VDC_FULL_SCALE : CURRENT_FULL_SCALE);
+	int onset = GenerateSamples();
+	ConfigProtection();
+	Replay();
+
+	int latency = disableSample - onset;
+	printf("Short circuit at %.1f A/us, limit %.0f A, debounce %d samples at %d Hz\n",
+			SHORT_CIRCUIT_A_PER_us, PROTECTION_MAX_CURRENT, PROTECTION_DEBOUNCE_COUNT, CONTROL_FREQUENCY_Hz);
+	printf("  fault onset       : sample %d, outputs disabled at sample %d (%d samples, %.1f us)\n",
+			onset, disableSample, latency, latency * 1e6 / CONTROL_FREQUENCY_Hz);
+	printf("  trip              : mask 0x%X, disabled PWMs 0x%X, %d disable(s), %d callback(s), %d trace record(s)\n",
+			BSP_ADC_GetProtectionTrip(), disableMask, disableCount, callbackCount, traceCount);
+	Check(disableSample >= FAULT_SAMPLE, "single sample spike tripped the protection");
+	Check(latency == PROTECTION_DEBOUNCE_COUNT - 1, "outputs not disabled at the debounce count");
+	Check(disableCount == 1 && disableMask == PROTECTED_PWM_MASK, "wrong outputs disabled");
+	Check(BSP_ADC_GetProtectionTrip() == (1U << SHORT_CIRCUIT_CHANNEL), "wrong channel tripped");
+	Check(callbackCount == 1 && callbackTripMask == (1U << SHORT_CIRCUIT_CHANNEL) && isCallbackAfterDisable,
+			"callback not called after the outputs are disabled");
+	Check(traceCount == 1, "fault not traced");
+
+	// the protection stays tripped till it is rearmed
+	BSP_ADC_ResetProtection();
+	Replay();
+	Check(disableCount == 1 && disableSample == onset + PROTECTION_DEBOUNCE_COUNT - 1, "protection not rearmed");
+}
+
+/**
+ * @brief Checks that the protection does not trip at the limit and measures the time taken by the check.
+ */
+static void Test_Limits(void)
+{
+	uint16_t data[TOTAL_MEASUREMENT_COUNT];
+	for (int i = 0; i < TOTAL_MEASUREMENT_COUNT; i++)
+		data[i] = GetRaw(0, i);
+	BSP_ADC_ResetProtection();
+	disableCount = 0;
+	data[0] = GetRaw(PROTECTION_MAX_CURRENT, 0);
+	data[2] = GetRaw(-PROTECTION_MAX_CURRENT, 2);
+	data[8] = GetRaw(PROTECTION_MAX_VDC, 8);
+	for (int i = 0; i < 2 * PROTECTION_DEBOUNCE_COUNT; i++)
+		BSP_ADC_CheckProtection(data);
+	Check(disableCount == 0, "protection tripped at the limits");
+	data[8] = GetRaw(PROTECTION_MAX_VDC * 1.01f, 8);
+	for (int i = 0; i < PROTECTION_DEBOUNCE_COUNT; i++)
+		BSP_ADC_CheckProtection(data);
+	Check(disableCount == 1 && BSP_ADC_GetProtectionTrip() == 0x100, "DC link over voltage not detected");
+
+	data[8] = GetRaw(VDC_NOMINAL, 8);
+	BSP_ADC_ResetProtection();
+	double startTime = GetTimeNs();
+	for (int i = 0; i < BENCHMARK_COUNT; i++)
+		BSP_ADC_CheckProtection(data);
+	printf("  check             : %.1f ns per sample set (host)\n", (GetTimeNs() - startTime) / BENCHMARK_COUNT);
+}
+
+int main(void)
+{
+	Test_ShortCircuit();
+	Test_Limits();
+	printf(failureCount ? "%d check(s) FAILED\n" : "All checks passed\n", failureCount);
+	return failureCount ? 1 : 0;
+}
+
+/* EOF */
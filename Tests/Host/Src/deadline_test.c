@@ -0,0 +1,253 @@
+/**
+ ********************************************************************************
+ * @file    	deadline_test.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Host test of the deadline monitor with injected delays and lost interrupts.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * DEADLINE_GET_CYCLES() reads a synthetic clock set by the test. Each emulated interrupt enters the
+ * monitor at a given time and exits after a given execution time, so that the overruns and the skipped
+ * samples are known. BSP_PWMOut_ForceDisable() and Trace_Log() are stubbed to record the safe state action.
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdio.h>
+#include "pecontroller_deadline.h"
+#include "pecontroller_trace.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define CORE_CLOCK_Hz				(480000000)
+#define SAMPLING_FREQUENCY_Hz		(20000)
+#define PERIOD_CYCLES				(CORE_CLOCK_Hz / SAMPLING_FREQUENCY_Hz)
+#define RUN_COUNT					(1000)
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static uint32_t disableCount;
+static uint32_t disableMask;
+static uint32_t callbackCount;
+static uint32_t traceCount;
+static uint16_t traceMisses;
+static uint32_t randomState = 1;
+static int failureCount = 0;
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+uint32_t SystemCoreClock = CORE_CLOCK_Hz;
+uint32_t hostCycles;
+_Thread_local uint32_t hostPrimask;
+DWT_Type hostDWT;
+CoreDebug_Type hostCoreDebug;
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+static void Check(bool isPassed, const char* msg)
+{
+	if (isPassed)
+		return;
+	printf("  FAILED: %s\n", msg);
+	failureCount++;
+}
+
+void BSP_PWMOut_ForceDisable(uint32_t pwmMask)
+{
+	disableCount++;
+	disableMask = pwmMask;
+}
+
+void Trace_Log(uint16_t id, uint16_t param, uint32_t value)
+{
+	if (id != TRACE_EVT_DEADLINE_TRIP)
+		return;
+	traceCount++;
+	traceMisses = param;
+}
+
+static void SafeStateCallback(void)
+{
+	callbackCount++;
+}
+
+static uint32_t Random(void)
+{
+	// xorshift32
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+/**
+ * @brief Emulates the monitored interrupt entering at the given time and taking the given cycles.
+ */
+static void RunInterrupt(deadline_monitor_t* monitor, uint32_t entryCycles, uint32_t cycles)
+{
+	hostCycles = entryCycles;
+	BSP_Deadline_Enter(monitor);
+	hostCycles += cycles;
+	BSP_Deadline_Exit(monitor);
+}
+
+static void InitMonitor(deadline_monitor_t* monitor, float budgetRatio, uint16_t tripCount)
+{
+	*monitor = (deadline_monitor_t){ .budgetRatio = budgetRatio, .tripCount = tripCount, .safeStatePwmMask = 0x3f,
+		.safeStateCallback = SafeStateCallback };
+	BSP_Deadline_SetFrequency(monitor, SAMPLING_FREQUENCY_Hz);
+	disableCount = disableMask = callbackCount = traceCount = traceMisses = 0;
+}
+
+/**
+ * @brief Checks the period and budget derived from the sampling frequency.
+ */
+static void Test_Budget(void)
+{
+	deadline_monitor_t monitor;
+	printf("Budget at %d Hz\n", SAMPLING_FREQUENCY_Hz);
+	InitMonitor(&monitor, 0.8f, 0);
+	Check((hostCoreDebug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) && (hostDWT.CTRL & DWT_CTRL_CYCCNTENA_Msk), "cycle counter not started");
+	Check(monitor.periodCycles == PERIOD_CYCLES && monitor.budgetCycles == PERIOD_CYCLES * 8 / 10, "budget of 80% of the period");
+	InitMonitor(&monitor, 0, 0);
+	Check(monitor.budgetCycles == PERIOD_CYCLES, "budget of the complete period");
+	InitMonitor(&monitor, 1.5f, 0);
+	Check(monitor.budgetCycles == PERIOD_CYCLES, "budget ratio above 1 not limited");
+}
+
+/**
+ * @brief Injects delays in some executions and checks the overruns and consecutive misses.
+ */
+static void Test_Overruns(void)
+{
+	deadline_monitor_t monitor;
+	uint32_t budget, expectedOverruns = 0;
+	InitMonitor(&monitor, 0.5f, 0);
+	budget = monitor.budgetCycles;
+	printf("Injected delays, %d runs with a budget of %u cycles\n", RUN_COUNT, budget);
+	for (uint32_t n = 0; n < RUN_COUNT; n++)
+	{
+		// 5 consecutive and 1 single delayed execution, the others use up to the complete budget
+		bool isDelayed = (n >= 100 && n < 105) || n == 500;
+		uint32_t cycles = isDelayed ? budget + 1 + n : budget / 2 + (Random() % (budget / 2 + 1));
+		expectedOverruns += isDelayed;
+		RunInterrupt(&monitor, n * PERIOD_CYCLES, cycles);
+	}
+	printf("  misses            : %u overruns, %u skipped samples, max %u consecutive, max execution %u cycles\n",
+			monitor.overrunCount, monitor.skippedCount, monitor.maxConsecutiveMisses, monitor.maxCycles);
+	Check(monitor.runCount == RUN_COUNT && monitor.overrunCount == expectedOverruns && monitor.skippedCount == 0, "overruns not counted");
+	Check(monitor.maxConsecutiveMisses == 5 && monitor.consecutiveMisses == 0, "consecutive misses");
+	Check(monitor.maxCycles == budget + 501 && monitor.lastCycles <= budget, "execution times");
+	Check(!monitor.isTripped && disableCount == 0 && callbackCount == 0, "tripped without a trip count");
+}
+
+/**
+ * @brief Checks that the entry jitter is ignored while lost interrupts are counted as skipped samples.
+ */
+static void Test_SkippedSamples(void)
+{
+	deadline_monitor_t monitor;
+	uint32_t expectedSkips = 0, entry = 0;
+	InitMonitor(&monitor, 0, 0);
+	printf("Lost interrupts with an entry jitter of up to 40%% of the period\n");
+	for (uint32_t n = 0; n < RUN_COUNT; n++)
+	{
+		uint32_t jitter = Random() % (PERIOD_CYCLES * 2 / 5);
+		// one interrupt is lost at 200 and two at 700
+		if (n == 200 || n == 700)
+		{
+			uint32_t lost = n == 200 ? 1 : 2;
+			entry += lost * PERIOD_CYCLES;
+			expectedSkips += lost;
+		}
+		RunInterrupt(&monitor, entry + n * PERIOD_CYCLES + jitter, PERIOD_CYCLES / 4);
+	}
+	printf("  misses            : %u skipped samples, %u overruns\n", monitor.skippedCount, monitor.overrunCount);
+	Check(monitor.skippedCount == expectedSkips && monitor.overrunCount == 0 && monitor.maxConsecutiveMisses == 1, "skipped samples");
+}
+
+/**
+ * @brief Checks that the safe state action is taken once after the configured consecutive misses and rearmed by the reset.
+ */
+static void Test_Trip(void)
+{
+	deadline_monitor_t monitor;
+	uint32_t n = 0;
+	InitMonitor(&monitor, 0.5f, 3);
+	uint32_t late = monitor.budgetCycles + 100, inTime = monitor.budgetCycles / 2;
+	printf("Safe state after %u consecutive misses\n", monitor.tripCount);
+
+	// two misses followed by a run in time do not trip
+	RunInterrupt(&monitor, n++ * PERIOD_CYCLES, inTime);
+	RunInterrupt(&monitor, n++ * PERIOD_CYCLES, late);
+	RunInterrupt(&monitor, n++ * PERIOD_CYCLES, late);
+	RunInterrupt(&monitor, n++ * PERIOD_CYCLES, inTime);
+	Check(!monitor.isTripped && disableCount == 0 && monitor.maxConsecutiveMisses == 2, "tripped before the trip count");
+
+	// an overrun, a lost interrupt and an overrun trip the monitor
+	RunInterrupt(&monitor, n++ * PERIOD_CYCLES, late);
+	n++;
+	RunInterrupt(&monitor, n++ * PERIOD_CYCLES, inTime);
+	RunInterrupt(&monitor, n++ * PERIOD_CYCLES, late);
+	Check(monitor.isTripped && disableCount == 1 && disableMask == 0x3f && callbackCount == 1, "safe state action not taken");
+	Check(traceCount == 1 && traceMisses == 3, "trip not traced");
+
+	// further misses keep the safe state without repeating the action
+	for (int i = 0; i < 10; i++)
+		RunInterrupt(&monitor, n++ * PERIOD_CYCLES, late);
+	Check(disableCount == 1 && callbackCount == 1 && traceCount == 1 && monitor.maxConsecutiveMisses == 13, "safe state action repeated");
+
+	BSP_Deadline_Reset(&monitor);
+	Check(!monitor.isTripped && monitor.runCount == 0 && monitor.overrunCount == 0 && monitor.maxConsecutiveMisses == 0, "monitor not reset");
+	for (int i = 0; i < 3; i++)
+		RunInterrupt(&monitor, n++ * PERIOD_CYCLES, late);
+	Check(monitor.isTripped && disableCount == 2 && callbackCount == 2, "safe state action not rearmed by the reset");
+	printf("  safe state        : %u actions, PWM mask 0x%x\n", disableCount, disableMask);
+}
+
+/**
+ * @brief Checks that a change of the sampling frequency keeps the statistics without counting skipped samples.
+ */
+static void Test_FrequencyChange(void)
+{
+	deadline_monitor_t monitor;
+	uint32_t n;
+	InitMonitor(&monitor, 0, 0);
+	printf("Sampling frequency change\n");
+	for (n = 0; n < 10; n++)
+		RunInterrupt(&monitor, n * PERIOD_CYCLES, PERIOD_CYCLES / 2);
+	BSP_Deadline_SetFrequency(&monitor, SAMPLING_FREQUENCY_Hz / 2);
+	// the first entry at the new frequency is long after the last entry at the previous frequency
+	uint32_t entry = (n + 10) * PERIOD_CYCLES;
+	for (int i = 0; i < 10; i++, entry += 2 * PERIOD_CYCLES)
+		RunInterrupt(&monitor, entry, PERIOD_CYCLES);
+	Check(monitor.periodCycles == 2 * PERIOD_CYCLES && monitor.runCount == 20 && monitor.maxCycles == PERIOD_CYCLES, "statistics not kept");
+	Check(monitor.skippedCount == 0 && monitor.overrunCount == 0, "samples skipped at the frequency change");
+}
+
+int main(void)
+{
+	Test_Budget();
+	Test_Overruns();
+	Test_SkippedSamples();
+	Test_Trip();
+	Test_FrequencyChange();
+	printf(failureCount ? "%d check(s) FAILED\n" : "All checks passed\n", failureCount);
+	return failureCount ? 1 : 0;
+}
+
+/* EOF */
@@ -0,0 +1,249 @@
+/**
+ ********************************************************************************
+ * @file    	executive_test.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Host simulation of the cyclic executive with a synthetic tick source.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * EXECUTIVE_GET_CYCLES() is replaced by a synthetic clock, which starts each sampling period at a multiple
+ * of the period and is advanced by the work before the executive and by each task with fixed costs.
+ * The load of each period is reported for the automatic phases and for all tasks at phase 0, and the
+ * budget measured from the start of the period is compared with a budget of the complete period when
+ * the work before the executive stalls.
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdio.h>
+#include "cyclic_executive.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define TICK_COUNT					(100000)
+/** Control period of 20kHz at 480MHz */
+#define PERIOD_CYCLES				(24000)
+/** Conversion and callback before the executive */
+#define PRE_TICK_CYCLES				(3000)
+#define PRE_TICK_JITTER				(512)
+/** The work before the executive stalls once in this many ticks */
+#define STALL_INTERVAL				(997)
+#define STALL_CYCLES				(14000)
+#define LOAD_BINS					(12)
+/********************************************************************************
+ * Typedefs
+ *******************************************************************************/
+/**
+ * @brief Defines a simulated task.
+ */
+typedef struct
+{
+	const char* name;
+	uint16_t divider;
+	uint32_t cycles;
+} sim_task_t;
+/**
+ * @brief Results of a simulation.
+ */
+typedef struct
+{
+	uint32_t loadHistogram[LOAD_BINS];			/**< Bin n counts the periods with a load of n * 10% to (n + 1) * 10% */
+	double meanLoad;
+	double maxLoad;
+	uint32_t missedPeriods;						/**< No of periods in which the work ends after the next period starts */
+	uint64_t lateCycles;						/**< Total cycles of work after the end of the periods */
+	uint32_t deferCount;						/**< No of deferred task runs */
+	uint32_t budgetErrors;						/**< No of ticks with a budget different from the rest of the period */
+} sim_result_t;
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static const sim_task_t simTasks[] =
+{
+		{ "control", 1, 9000 },
+		{ "pll", 2, 3000 },
+		{ "voltage loop", 10, 6000 },
+		{ "display data", 20, 4000 },
+		{ "relays", 100, 5000 },
+};
+static uint32_t randomState = 1;
+static int failureCount = 0;
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+/** Synthetic clock read by EXECUTIVE_GET_CYCLES() */
+uint32_t hostCycles;
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+static void Check(bool isPassed, const char* msg)
+{
+	if (isPassed)
+		return;
+	printf("  FAILED: %s\n", msg);
+	failureCount++;
+}
+
+static uint32_t Random(void)
+{
+	// xorshift32
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+static void RunTask(void* arg)
+{
+	hostCycles += ((const sim_task_t*)arg)->cycles;
+}
+
+static void AddTasks(executive_t* exec, bool isAutoPhase)
+{
+	for (size_t i = 0; i < sizeof(simTasks) / sizeof(simTasks[0]); i++)
+	{
+		const sim_task_t* task = &simTasks[i];
+		uint16_t phase = (isAutoPhase && task->divider > 1) ? EXECUTIVE_AUTO_PHASE : 0;
+		Check(Executive_AddTask(exec, RunTask, (void*)task, task->divider, phase, (uint16_t)(task->cycles / 100)) != NULL, "task not added");
+	}
+}
+
+/**
+ * @brief Ticks the executive at each synthetic period and records the load of the periods.
+ * @param exec Pointer to the executive.
+ * @param isFromPeriodStart <c>true</c> to measure the budget from the start of the period.
+ * @param hasStalls <c>true</c> to stall the work before the executive once in @ref STALL_INTERVAL ticks.
+ */
+static void Simulate(executive_t* exec, bool isFromPeriodStart, bool hasStalls, sim_result_t* result)
+{
+	double totalLoad = 0;
+	uint32_t missedUntil = 0;
+	randomState = 1;
+	*result = (sim_result_t){ 0 };
+	for (uint32_t n = 0; n < TICK_COUNT; n++)
+	{
+		uint32_t periodStart = n * PERIOD_CYCLES;
+		// a late period starts after the work of the previous period
+		hostCycles = (missedUntil > periodStart ? missedUntil : periodStart) + PRE_TICK_CYCLES + (Random() % PRE_TICK_JITTER);
+		if (hasStalls && (n % STALL_INTERVAL) == STALL_INTERVAL - 1)
+			hostCycles += STALL_CYCLES;
+		uint32_t preTickCycles = hostCycles - periodStart;
+
+		if (isFromPeriodStart)
+			(void)Executive_TickFrom(exec, periodStart);
+		else
+			(void)Executive_Tick(exec);
+		if (isFromPeriodStart && exec->budgetCycles != PERIOD_CYCLES - preTickCycles)
+			result->budgetErrors++;
+
+		uint32_t workCycles = hostCycles - periodStart;
+		if (workCycles > PERIOD_CYCLES)
+		{
+			result->missedPeriods++;
+			result->lateCycles += workCycles - PERIOD_CYCLES;
+		}
+		missedUntil = hostCycles;
+		double load = (double)workCycles / PERIOD_CYCLES;
+		int bin = (int)(load * 10);
+		result->loadHistogram[bin < LOAD_BINS ? bin : LOAD_BINS - 1]++;
+		totalLoad += load;
+		if (load > result->maxLoad)
+			result->maxLoad = load;
+	}
+	result->meanLoad = totalLoad / TICK_COUNT;
+	for (int i = 0; i < exec->taskCount; i++)
+		result->deferCount += exec->tasks[i].deferCount;
+}
+
+static void PrintResult(const char* name, const executive_t* exec, const sim_result_t* result)
+{
+	printf("  %-18s: load mean %.1f%%, max %.1f%%, %u missed periods (%llu cycles late), %u overruns, %u deferred runs\n",
+			name, result->meanLoad * 100, result->maxLoad * 100, result->missedPeriods, (unsigned long long)result->lateCycles,
+			exec->overrunCount, result->deferCount);
+	printf("  %-18s  load distribution", "");
+	for (int i = 0; i < LOAD_BINS; i++)
+		printf(" %s%d%%:%u", i == LOAD_BINS - 1 ? ">=" : "", i * 10, result->loadHistogram[i]);
+	printf("\n");
+}
+
+/**
+ * @brief Compares the load of the periods with the automatic phases against all tasks at phase 0.
+ */
+static void Test_LoadDistribution(void)
+{
+	executive_t autoExec = { .periodCycles = PERIOD_CYCLES };
+	executive_t zeroExec = { .periodCycles = PERIOD_CYCLES };
+	sim_result_t autoResult, zeroResult;
+	printf("Load distribution, %u ticks of %u cycles, %u cycles before the executive\n", TICK_COUNT, PERIOD_CYCLES, PRE_TICK_CYCLES);
+	AddTasks(&autoExec, true);
+	AddTasks(&zeroExec, false);
+	Simulate(&autoExec, true, false, &autoResult);
+	Simulate(&zeroExec, true, false, &zeroResult);
+	PrintResult("automatic phases", &autoExec, &autoResult);
+	printf("  %-18s  phases", "");
+	for (int i = 0; i < autoExec.taskCount; i++)
+		printf(" %s:%u/%u", simTasks[i].name, autoExec.tasks[i].phase, autoExec.tasks[i].divider);
+	printf("\n");
+	PrintResult("phase 0", &zeroExec, &zeroResult);
+
+	Check(autoResult.budgetErrors == 0, "budget is not the rest of the period");
+	Check(autoResult.missedPeriods == 0 && autoExec.overrunCount == 0 && autoResult.deferCount == 0,
+			"tasks with automatic phases exceed the period");
+	Check(autoResult.maxLoad < zeroResult.maxLoad, "automatic phases do not reduce the peak load");
+	Check(zeroExec.overrunCount > 0 && zeroResult.deferCount > 0, "overruns at phase 0 not detected");
+	for (int i = 0; i < autoExec.taskCount; i++)
+		Check(autoExec.tasks[i].runCount == TICK_COUNT / simTasks[i].divider, "task runs not at its rate");
+	Check(autoExec.maxPreTickCycles < PRE_TICK_CYCLES + PRE_TICK_JITTER && autoExec.maxPreTickCycles >= PRE_TICK_CYCLES,
+			"time before the tick not measured");
+}
+
+/**
+ * @brief Stalls the work before the executive and compares the budget measured from the start of the period
+ * with a budget of the complete period.
+ */
+static void Test_Budget(void)
+{
+	executive_t periodExec = { .budgetCycles = PERIOD_CYCLES };
+	executive_t measuredExec = { .periodCycles = PERIOD_CYCLES };
+	sim_result_t periodResult, measuredResult;
+	printf("Budget with a stall of %u cycles before the executive every %u ticks\n", STALL_CYCLES, STALL_INTERVAL);
+	AddTasks(&periodExec, true);
+	AddTasks(&measuredExec, true);
+	Simulate(&periodExec, false, true, &periodResult);
+	Simulate(&measuredExec, true, true, &measuredResult);
+	PrintResult("complete period", &periodExec, &periodResult);
+	PrintResult("rest of period", &measuredExec, &measuredResult);
+
+	uint32_t stallCount = TICK_COUNT / STALL_INTERVAL;
+	Check(measuredResult.budgetErrors == 0, "budget is not the rest of the period");
+	Check(periodExec.overrunCount == 0, "stalls detected with the budget of the complete period");
+	Check(measuredExec.overrunCount >= stallCount, "stalls not reported as overruns");
+	// the base rate tasks still miss the stalled periods, but the deferred tasks no longer delay them further
+	Check(measuredResult.lateCycles < periodResult.lateCycles && measuredResult.maxLoad < periodResult.maxLoad,
+			"deferring the tasks does not reduce the late work");
+	Check(measuredExec.maxPreTickCycles >= PRE_TICK_CYCLES + STALL_CYCLES, "stall not measured before the tick");
+}
+
+int main(void)
+{
+	Test_LoadDistribution();
+	Test_Budget();
+	printf(failureCount ? "%d check(s) FAILED\n" : "All checks passed\n", failureCount);
+	return failureCount ? 1 : 0;
+}
+
+/* EOF */
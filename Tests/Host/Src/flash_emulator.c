@@ -0,0 +1,261 @@
+/**
+ ********************************************************************************
+ * @file    	flash_emulator.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Host model of the STM32H7 flash sectors used by the state storage.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "flash_emulator.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define FLASH_WORD_BYTES				(32)
+#define FLASH_WORD_WORDS				(FLASH_WORD_BYTES / 4)
+#define EMPTY_WORD						(0xFFFFFFFF)
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static uint32_t* sectorMem[STATE_STORAGE_MAX_SECTORS];
+static int emulatedSectorCount = 0;
+static uint32_t emulatedSectorBytes = 0;
+static uint64_t eraseEndCycles[STATE_STORAGE_MAX_SECTORS];
+static uint32_t randomState = 0x12345678;
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+host_dwt_t hostDWT;
+host_core_debug_t hostCoreDebug;
+host_flash_t hostFlash;
+flash_emulator_config_t flashEmulatorConfig =
+{
+		.programCycles = FLASH_EMULATOR_CLOCK_Hz / 100000,	// 10 us per flash word
+		.eraseCycles = FLASH_EMULATOR_CLOCK_Hz / 2,			// 500 ms per sector
+		.pollCycles = FLASH_EMULATOR_CLOCK_Hz / 1000,		// storage refreshed every ms
+		.faultySector = -1,
+};
+flash_emulator_stats_t flashEmulatorStats;
+/********************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static bool Emulator_Program(uint32_t* addr, const uint32_t* data);
+static bool Emulator_Erase(flash_sector_config_t* sector);
+static bool Emulator_IsBusy(flash_sector_config_t* sector);
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+static const state_storage_flash_ops_t emulatorOps =
+{
+		.Program = Emulator_Program,
+		.Erase = Emulator_Erase,
+		.IsBusy = Emulator_IsBusy,
+};
+
+uint32_t FlashEmulator_Random(void)
+{
+	// xorshift32
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+void FlashEmulator_Seed(uint32_t seed)
+{
+	randomState = seed ? seed : 0x12345678;
+}
+
+void FlashEmulator_Advance(uint32_t cycles)
+{
+	flashEmulatorStats.cycles += cycles;
+	hostDWT.CYCCNT = (uint32_t)flashEmulatorStats.cycles;
+}
+
+static int GetSectorNo(const uint32_t* addr)
+{
+	for (int i = 0; i < emulatedSectorCount; i++)
+	{
+		if (addr >= sectorMem[i] && addr < sectorMem[i] + (emulatedSectorBytes / 4))
+			return i;
+	}
+	return -1;
+}
+
+/**
+ * @brief Waits for the background erase of the sector to complete, as the flash bank is blocked meanwhile.
+ */
+static void WaitForErase(int sectorNo)
+{
+	if (eraseEndCycles[sectorNo] > flashEmulatorStats.cycles)
+	{
+		FlashEmulator_Advance((uint32_t)(eraseEndCycles[sectorNo] - flashEmulatorStats.cycles));
+	}
+}
+
+/**
+ * @brief Counts the operation and cuts the power during it if configured.
+ * @return <c>true</c> if the power is cut during this operation.
+ */
+static bool IsPowerCut(void)
+{
+	flashEmulatorStats.opCount++;
+	return flashEmulatorConfig.powerCutOp != 0 && flashEmulatorStats.opCount == flashEmulatorConfig.powerCutOp;
+}
+
+static void CutPower(void)
+{
+	flashEmulatorStats.powerCutCount++;
+	flashEmulatorConfig.powerCutOp = 0;
+	longjmp(*flashEmulatorConfig.powerCutJump, 1);
+}
+
+static bool Emulator_Program(uint32_t* addr, const uint32_t* data)
+{
+	int sectorNo = GetSectorNo(addr);
+	if (sectorNo == -1 || ((uintptr_t)((uint8_t*)addr - (uint8_t*)sectorMem[sectorNo]) % FLASH_WORD_BYTES))
+	{
+		flashEmulatorStats.rejectedCount++;
+		return false;
+	}
+	WaitForErase(sectorNo);
+	// the flash word can only be programmed once after the erase because of the ECC
+	for (int i = 0; i < FLASH_WORD_WORDS; i++)
+	{
+		if (addr[i] != EMPTY_WORD)
+		{
+			flashEmulatorStats.rejectedCount++;
+			return false;
+		}
+	}
+	bool isPowerCut = IsPowerCut();
+	flashEmulatorStats.programCount++;
+	flashEmulatorStats.programBytes += FLASH_WORD_BYTES;
+	flashEmulatorStats.busyCycles += flashEmulatorConfig.programCycles;
+	FlashEmulator_Advance(flashEmulatorConfig.programCycles);
+	if (sectorNo == flashEmulatorConfig.faultySector)
+		return false;
+	if (isPowerCut)
+	{
+		// some of the bits are left unprogrammed
+		for (int i = 0; i < FLASH_WORD_WORDS; i++)
+			addr[i] = data[i] | FlashEmulator_Random();
+		CutPower();
+	}
+	memcpy(addr, data, FLASH_WORD_BYTES);
+	return true;
+}
+
+static bool Emulator_Erase(flash_sector_config_t* sector)
+{
+	int sectorNo = GetSectorNo(sector->addr);
+	if (sectorNo == -1)
+		return false;
+	WaitForErase(sectorNo);
+	bool isPowerCut = IsPowerCut();
+	flashEmulatorStats.eraseCount++;
+	flashEmulatorStats.eraseCounts[sectorNo]++;
+	flashEmulatorStats.busyCycles += flashEmulatorConfig.eraseCycles;
+	if (sectorNo == flashEmulatorConfig.faultySector)
+		return false;
+	if (isPowerCut)
+	{
+		// some of the flash words are left partially erased
+		uint32_t* addr = sectorMem[sectorNo];
+		for (uint32_t i = 0; i < emulatedSectorBytes / 4; i += FLASH_WORD_WORDS)
+		{
+			uint32_t mask = (FlashEmulator_Random() & 1) ? EMPTY_WORD : FlashEmulator_Random();
+			for (int j = 0; j < FLASH_WORD_WORDS; j++)
+				addr[i + j] |= mask;
+		}
+		CutPower();
+	}
+	memset(sectorMem[sectorNo], 0xFF, emulatedSectorBytes);
+	eraseEndCycles[sectorNo] = flashEmulatorStats.cycles + flashEmulatorConfig.eraseCycles;
+	return true;
+}
+
+static bool Emulator_IsBusy(flash_sector_config_t* sector)
+{
+	int sectorNo = GetSectorNo(sector->addr);
+	FlashEmulator_Advance(flashEmulatorConfig.pollCycles);
+	return sectorNo != -1 && eraseEndCycles[sectorNo] > flashEmulatorStats.cycles;
+}
+
+void FlashEmulator_Init(state_storage_config_t* storage, int sectorCount, uint32_t sectorBytes, bool keepContents)
+{
+	if (sectorCount > STATE_STORAGE_MAX_SECTORS)
+		Error_Handler();
+	if (sectorCount != emulatedSectorCount || sectorBytes != emulatedSectorBytes)
+	{
+		for (int i = 0; i < STATE_STORAGE_MAX_SECTORS; i++)
+		{
+			free(sectorMem[i]);
+			sectorMem[i] = i < sectorCount ? aligned_alloc(FLASH_WORD_BYTES, sectorBytes) : NULL;
+		}
+		emulatedSectorCount = sectorCount;
+		emulatedSectorBytes = sectorBytes;
+		keepContents = false;
+	}
+	for (int i = 0; i < sectorCount; i++)
+	{
+		if (keepContents == false)
+			memset(sectorMem[i], 0xFF, sectorBytes);
+		eraseEndCycles[i] = 0;
+		storage->sectors[i].sectorNo = i;
+		storage->sectors[i].bank = FLASH_BANK_1;
+		storage->sectors[i].byteCount = sectorBytes;
+		storage->sectors[i].addr = sectorMem[i];
+	}
+	storage->sectorCount = sectorCount;
+	storage->flashOps = &emulatorOps;
+}
+
+void FlashEmulator_ResetStats(void)
+{
+	uint64_t cycles = flashEmulatorStats.cycles;
+	memset(&flashEmulatorStats, 0, sizeof(flashEmulatorStats));
+	flashEmulatorStats.cycles = cycles;
+	for (int i = 0; i < emulatedSectorCount; i++)
+		eraseEndCycles[i] = 0;
+}
+
+void FlashEmulator_PrintReport(const char* title, uint32_t updateCount)
+{
+	uint64_t minErases = UINT64_MAX, maxErases = 0;
+	printf("%s\n", title);
+	printf("  flash words programmed : %llu (%llu bytes, %llu rejected)\n", (unsigned long long)flashEmulatorStats.programCount,
+			(unsigned long long)flashEmulatorStats.programBytes, (unsigned long long)flashEmulatorStats.rejectedCount);
+	printf("  sector erases          : %llu [", (unsigned long long)flashEmulatorStats.eraseCount);
+	for (int i = 0; i < emulatedSectorCount; i++)
+	{
+		uint64_t count = flashEmulatorStats.eraseCounts[i];
+		printf(i ? " %llu" : "%llu", (unsigned long long)count);
+		if (count < minErases)
+			minErases = count;
+		if (count > maxErases)
+			maxErases = count;
+	}
+	printf("] spread %llu\n", (unsigned long long)(maxErases - minErases));
+	printf("  flash busy time        : %.3f s\n", flashEmulatorStats.busyCycles / (double)FLASH_EMULATOR_CLOCK_Hz);
+	if (updateCount)
+		printf("  per 1000 updates       : %.1f bytes, %.3f erases\n",
+				flashEmulatorStats.programBytes * 1000.0 / updateCount, flashEmulatorStats.eraseCount * 1000.0 / updateCount);
+}
+
+/* EOF */
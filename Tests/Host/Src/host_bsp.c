@@ -0,0 +1,155 @@
+/**
+ ********************************************************************************
+ * @file 		host_bsp.c
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Host memory of the peripherals and the HAL stubs for the BSP tests.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "pecontroller_timers.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define IRQ_COUNT						(160)
+/********************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/********************************************************************************
+ * Structures
+ *******************************************************************************/
+
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static bool enabledIrqs[IRQ_COUNT];
+static int errorCount;
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+_Thread_local uint32_t hostPrimask;
+HRTIM_TypeDef hostHRTIM1;
+TIM_TypeDef hostTIM1;
+TIM_TypeDef hostTIM2;
+TIM_TypeDef hostTIM3;
+RCC_TypeDef hostRCC;
+GPIO_TypeDef hostGPIOB;
+/********************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+extern void TIM1_UP_IRQHandler(void);
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+void Error_Handler(void)
+{
+	errorCount++;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	if (IRQn >= 0 && IRQn < IRQ_COUNT)
+		enabledIrqs[IRQn] = true;
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+	if (IRQn >= 0 && IRQn < IRQ_COUNT)
+		enabledIrqs[IRQn] = false;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+}
+
+HAL_StatusTypeDef HAL_RCCEx_PeriphCLKConfig(RCC_PeriphCLKInitTypeDef *PeriphClkInit)
+{
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength)
+{
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma)
+{
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Abort_IT(DMA_HandleTypeDef *hdma)
+{
+	return HAL_OK;
+}
+
+/**
+ * @brief Checks if the interrupt is enabled in the emulated NVIC.
+ * @param irq Interrupt number
+ * @return bool <c>true</c> if enabled by HAL_NVIC_EnableIRQ()
+ */
+bool HostBsp_IsIrqEnabled(IRQn_Type irq)
+{
+	return irq >= 0 && irq < IRQ_COUNT && enabledIrqs[irq];
+}
+
+/**
+ * @brief Calls the handler of the interrupt if it is enabled in the emulated NVIC and not masked by PRIMASK.
+ * @details The handlers are the same as in stm32h7xx_it.c of the CM7 applications.
+ * @param irq Interrupt number
+ * @return bool <c>true</c> if the handler is called
+ */
+bool HostBsp_RaiseIrq(IRQn_Type irq)
+{
+	if (!HostBsp_IsIrqEnabled(irq) || hostPrimask)
+		return false;
+	switch (irq)
+	{
+	case TIM1_UP_IRQn:
+		TIM1_UP_IRQHandler();
+		break;
+	case HRTIM1_Master_IRQn:
+		HAL_HRTIM_IRQHandler(&hhrtim, HRTIM_TIMERINDEX_MASTER);
+		break;
+	case HRTIM1_TIMA_IRQn:
+	case HRTIM1_TIMB_IRQn:
+	case HRTIM1_TIMC_IRQn:
+	case HRTIM1_TIMD_IRQn:
+	case HRTIM1_TIME_IRQn:
+		HAL_HRTIM_IRQHandler(&hhrtim, HRTIM_TIMERINDEX_TIMER_A + (irq - HRTIM1_TIMA_IRQn));
+		break;
+	default:
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Gets the number of calls to Error_Handler() since the start of the test.
+ * @return int Number of errors reported by the drivers
+ */
+int HostBsp_GetErrorCount(void)
+{
+	return errorCount;
+}
+
+/* EOF */
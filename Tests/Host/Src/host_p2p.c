@@ -0,0 +1,131 @@
+/**
+ ********************************************************************************
+ * @file 		host_p2p.c
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Host shared memory and hardware semaphores for the inter-core communication tests.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * Releasing a semaphore with an active notification runs HSEM2_IRQHandler() in the releasing thread, which
+ * stands in for the interrupt of the communication core. The handler waits while the interrupts are masked
+ * by another thread with __disable_irq().
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <pthread.h>
+#include <time.h>
+#include "shared_memory.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define HSEM_COUNT						(32)
+#define IRQ_COUNT						(160)
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static shared_data_t hostSharedData;
+static volatile uint32_t takenSemaphores;
+static bool enabledIrqs[IRQ_COUNT];
+static pthread_mutex_t irqMutex = PTHREAD_MUTEX_INITIALIZER;
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+volatile shared_data_t * const sharedData = &hostSharedData;
+uint32_t SystemCoreClock = 480000000;
+_Thread_local uint32_t hostPrimask;
+RCC_TypeDef hostRCC;
+HSEM_TypeDef hostHSEM;
+HSEM_Common_TypeDef hostHSEMCommon;
+SCB_Type hostSCB;
+DWT_Type hostDWT;
+CoreDebug_Type hostCoreDebug;
+/** Defined by the display on the target */
+const char* unitTxts[UNIT_COUNT] = { "V", "A", "W", "Hz" };
+/********************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+extern void HSEM2_IRQHandler(void);
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+DWT_Type* HostP2P_GetDWT(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	uint64_t ns = (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+	hostDWT.CYCCNT = (uint32_t)(ns * (SystemCoreClock / 1000000) / 1000);
+	return &hostDWT;
+}
+
+void HostP2P_DisableIrq(void)
+{
+	if (hostPrimask == 0)
+		pthread_mutex_lock(&irqMutex);
+	hostPrimask = 1;
+}
+
+void HostP2P_EnableIrq(void)
+{
+	if (hostPrimask)
+		pthread_mutex_unlock(&irqMutex);
+	hostPrimask = 0;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	if (IRQn >= 0 && IRQn < IRQ_COUNT)
+		enabledIrqs[IRQn] = true;
+}
+
+HAL_StatusTypeDef HAL_HSEM_FastTake(uint32_t SemID)
+{
+	uint32_t mask = __HAL_HSEM_SEMID_TO_MASK(SemID);
+	return (__atomic_fetch_or(&takenSemaphores, mask, __ATOMIC_ACQ_REL) & mask) ? HAL_ERROR : HAL_OK;
+}
+
+void HAL_HSEM_Release(uint32_t SemID, uint32_t ProcessID)
+{
+	uint32_t mask = __HAL_HSEM_SEMID_TO_MASK(SemID);
+	__atomic_fetch_and(&takenSemaphores, ~mask, __ATOMIC_ACQ_REL);
+	if ((hostHSEMCommon.IER & mask) == 0)
+		return;
+
+	// the interrupt of the communication core is held off while it masks the interrupts
+	pthread_mutex_lock(&irqMutex);
+	hostHSEMCommon.ISR |= mask;
+	hostHSEMCommon.MISR = hostHSEMCommon.ISR & hostHSEMCommon.IER;
+	if (SemID < HSEM_COUNT && enabledIrqs[HSEM2_IRQn])
+	{
+		hostHSEMCommon.ICR = 0;
+		HSEM2_IRQHandler();
+		hostHSEMCommon.ISR &= ~hostHSEMCommon.ICR;
+		hostHSEMCommon.MISR = hostHSEMCommon.ISR & hostHSEMCommon.IER;
+	}
+	pthread_mutex_unlock(&irqMutex);
+}
+
+void HAL_HSEM_ActivateNotification(uint32_t SemMask)
+{
+	hostHSEMCommon.IER |= SemMask;
+}
+
+/* EOF */
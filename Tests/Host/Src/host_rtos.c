@@ -0,0 +1,137 @@
+/**
+ ********************************************************************************
+ * @file 		host_rtos.c
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Host replacement of the CMSIS-RTOS2 thread flags and delays.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * Each host thread gets a control block when it first uses the functions. The thread flags are kept
+ * under a mutex and a waiting thread sleeps on a condition variable, which stands in for the kernel
+ * wake up of the task.
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <time.h>
+#include "cmsis_os.h"
+/********************************************************************************
+ * Structures
+ *******************************************************************************/
+/**
+ * @brief Control block of a host thread.
+ */
+typedef struct
+{
+	bool isInitialized;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	uint32_t flags;
+} host_thread_t;
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static _Thread_local host_thread_t currentThread;
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+volatile uint32_t hostRtosTimeoutCount;
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+osThreadId_t osThreadGetId(void)
+{
+	if (!currentThread.isInitialized)
+	{
+		pthread_condattr_t attr;
+		pthread_condattr_init(&attr);
+		pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+		pthread_cond_init(&currentThread.cond, &attr);
+		pthread_condattr_destroy(&attr);
+		pthread_mutex_init(&currentThread.mutex, NULL);
+		currentThread.isInitialized = true;
+	}
+	return &currentThread;
+}
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags)
+{
+	host_thread_t* thread = (host_thread_t*)thread_id;
+	if (thread == NULL || (flags & osFlagsError))
+		return osFlagsErrorResource;
+	pthread_mutex_lock(&thread->mutex);
+	thread->flags |= flags;
+	uint32_t result = thread->flags;
+	pthread_cond_broadcast(&thread->cond);
+	pthread_mutex_unlock(&thread->mutex);
+	return result;
+}
+
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout)
+{
+	host_thread_t* thread = (host_thread_t*)osThreadGetId();
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	if (timeout != osWaitForever)
+	{
+		uint64_t ns = deadline.tv_nsec + (uint64_t)timeout * HOST_RTOS_TICK_US * 1000;
+		deadline.tv_sec += ns / 1000000000;
+		deadline.tv_nsec = ns % 1000000000;
+	}
+
+	uint32_t result;
+	pthread_mutex_lock(&thread->mutex);
+	while (true)
+	{
+		uint32_t matched = thread->flags & flags;
+		if ((options & osFlagsWaitAll) ? matched == flags : matched != 0)
+		{
+			result = thread->flags;
+			if ((options & osFlagsNoClear) == 0)
+				thread->flags &= ~flags;
+			break;
+		}
+		if (timeout == 0)
+		{
+			result = osFlagsErrorResource;
+			break;
+		}
+		int err = timeout == osWaitForever ? pthread_cond_wait(&thread->cond, &thread->mutex) :
+				pthread_cond_timedwait(&thread->cond, &thread->mutex, &deadline);
+		if (err == ETIMEDOUT)
+		{
+			hostRtosTimeoutCount++;
+			result = osFlagsErrorTimeout;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&thread->mutex);
+	return result;
+}
+
+osStatus_t osDelay(uint32_t ticks)
+{
+	struct timespec delay = { .tv_sec = ticks / (1000000 / HOST_RTOS_TICK_US),
+			.tv_nsec = (ticks % (1000000 / HOST_RTOS_TICK_US)) * HOST_RTOS_TICK_US * 1000 };
+	while (nanosleep(&delay, &delay) != 0 && errno == EINTR);
+	return osOK;
+}
+
+/* EOF */
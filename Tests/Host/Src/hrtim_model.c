@@ -0,0 +1,777 @@
+/**
+ ********************************************************************************
+ * @file 		hrtim_model.c
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Host register model of the HRTIM and TIM1 driving the PWM outputs.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "hrtim_model.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define TIMER_COUNT						(5)
+#define UNIT_COUNT						(TIMER_COUNT + 1)
+#define MASTER							(HRTIM_TIMERINDEX_MASTER)
+#define HRTIM_OUTPUT_COUNT				(TIMER_COUNT * 2)
+#define TIM1_CHANNEL_COUNT				(3)
+/** TIM1 runs at half of the HRTIM clock */
+#define TIM1_CLOCK_DIV					(2)
+#define TIM1_IRQ_BIT					(1U << HRTIM_MODEL_UNIT_TIM1)
+#define TIM_OCMODE_PWM1_VALUE			(6)
+#define TIM_OCMODE_PWM2_VALUE			(7)
+/** Master events of the output crossbar */
+#define MASTER_EVENTS					(HRTIM_SET1R_MSTPER | HRTIM_SET1R_MSTCMP1 | HRTIM_SET1R_MSTCMP2 | \
+											HRTIM_SET1R_MSTCMP3 | HRTIM_SET1R_MSTCMP4)
+/** Maps the master events of the output crossbar to the reset sources of RSTxR */
+#define MASTER_EVENTS_TO_RESET(ev)		(((ev) & MASTER_EVENTS) >> (HRTIM_SET1R_MSTPER_Pos - HRTIM_RSTR_MSTPER_Pos))
+#define UNIT_UDIS(idx)					((idx) == MASTER ? HRTIM_CR1_MUDIS : (HRTIM_CR1_TAUDIS << (idx)))
+#define UNIT_ENABLE(idx)				((idx) == MASTER ? HRTIM_MCR_MCEN : (HRTIM_MCR_TACEN << (idx)))
+#define UNIT_SWU(idx)					((idx) == MASTER ? HRTIM_CR2_MSWU : (HRTIM_CR2_TASWU << (idx)))
+#define UNIT_SWRST(idx)					((idx) == MASTER ? HRTIM_CR2_MRST : (HRTIM_CR2_TARST << (idx)))
+/********************************************************************************
+ * Typedefs
+ *******************************************************************************/
+
+/********************************************************************************
+ * Structures
+ *******************************************************************************/
+/**
+ * @brief Defines the counter and the active registers of an HRTIM unit.
+ */
+typedef struct
+{
+	bool isRunning;
+	uint32_t prescaler;
+	uint32_t counter;
+	uint32_t repCounter;
+	uint32_t period;
+	uint32_t compares[4];
+	uint32_t repetition;
+} unit_state_t;
+/**
+ * @brief Defines an output after the dead time generator with its delayed edge.
+ */
+typedef struct
+{
+	uint8_t level;
+	bool isPending;
+	uint8_t pendingLevel;
+	uint64_t pendingTime;
+} delayed_output_t;
+/**
+ * @brief Defines the counter and the active registers of TIM1.
+ */
+typedef struct
+{
+	uint32_t prescaler;
+	uint32_t counter;
+	bool isDown;
+	uint32_t repCounter;
+	uint32_t arr;
+	uint32_t rcr;
+	uint32_t ccr[TIM1_CHANNEL_COUNT];
+	uint32_t sr;
+	uint8_t ref[TIM1_CHANNEL_COUNT];
+} tim1_state_t;
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static const uint32_t prescalerDivs[8] = { 1, 1, 1, 1, 1, 1, 2, 4 };
+static uint64_t simTime;
+static unit_state_t units[UNIT_COUNT];
+static uint8_t rawLevels[HRTIM_OUTPUT_COUNT];
+/** HRTIM outputs followed by the TIM1 outputs OC1, OC1N ... OC3N */
+static delayed_output_t outputs[HRTIM_MODEL_PWM_COUNT];
+static uint32_t enabledOutputs;
+static uint32_t softwareResets;
+static uint32_t pendingIrqs;
+static tim1_state_t tim1;
+static uint8_t pins[HRTIM_MODEL_PWM_COUNT];
+static bool isDirty;
+static hrtim_model_edge_t edges[HRTIM_MODEL_MAX_EDGES];
+static uint32_t edgeCount;
+static hrtim_model_update_t updates[HRTIM_MODEL_MAX_UPDATES];
+static uint32_t updateCount;
+static uint64_t timelineStart;
+static uint8_t timelineLevels[HRTIM_MODEL_PWM_COUNT];
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+
+/********************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+static void ProcessWrites(void);
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+static void LogUpdate(uint8_t unit, uint32_t period, const uint32_t* compares, int compareCount)
+{
+	if (updateCount >= HRTIM_MODEL_MAX_UPDATES)
+		return;
+	hrtim_model_update_t* update = &updates[updateCount++];
+	update->time = simTime;
+	update->unit = unit;
+	update->period = period;
+	memset(update->compares, 0, sizeof(update->compares));
+	memcpy(update->compares, compares, compareCount * sizeof(uint32_t));
+}
+
+static void LoadActive(int idx)
+{
+	unit_state_t* st = &units[idx];
+	if (idx == MASTER)
+	{
+		HRTIM_Master_TypeDef* regs = &HRTIM1->sMasterRegs;
+		st->period = regs->MPER;
+		st->compares[0] = regs->MCMP1R;
+		st->compares[1] = regs->MCMP2R;
+		st->compares[2] = regs->MCMP3R;
+		st->compares[3] = regs->MCMP4R;
+		st->repetition = regs->MREP;
+	}
+	else
+	{
+		HRTIM_Timerx_TypeDef* regs = &HRTIM1->sTimerxRegs[idx];
+		st->period = regs->PERxR;
+		st->compares[0] = regs->CMP1xR;
+		st->compares[1] = regs->CMP2xR;
+		st->compares[2] = regs->CMP3xR;
+		st->compares[3] = regs->CMP4xR;
+		st->repetition = regs->REPxR;
+	}
+}
+
+static void TransferPreload(int idx)
+{
+	LoadActive(idx);
+	LogUpdate(idx, units[idx].period, units[idx].compares, 4);
+}
+
+static void RaiseFlag(int idx, uint32_t flag)
+{
+	volatile uint32_t* isr = idx == MASTER ? &HRTIM1->sMasterRegs.MISR : &HRTIM1->sTimerxRegs[idx].TIMxISR;
+	volatile uint32_t* dier = idx == MASTER ? &HRTIM1->sMasterRegs.MDIER : &HRTIM1->sTimerxRegs[idx].TIMxDIER;
+	*isr |= flag;
+	// the interrupt enable bits follow the flag positions
+	if (*dier & flag)
+		pendingIrqs |= 1U << idx;
+}
+
+static void SetLevel(delayed_output_t* out, uint8_t level)
+{
+	out->level = level;
+	out->isPending = false;
+	isDirty = true;
+}
+
+static void ScheduleLevel(delayed_output_t* out, uint8_t level, uint64_t delay)
+{
+	if (delay == 0)
+		SetLevel(out, level);
+	else
+	{
+		out->isPending = true;
+		out->pendingLevel = level;
+		out->pendingTime = simTime + delay;
+	}
+}
+
+/**
+ * @brief Applies the dead time generator to the complementary outputs.
+ * @param out1 Output following the reference
+ * @param out2 Complementary output
+ * @param ref New level of the reference
+ * @param rise Delay of the rising edge in ticks
+ * @param fall Delay of the falling edge in ticks
+ * @param isRiseNegative <c>true</c> if the rising dead time delays the falling edge of the complementary output
+ * @param isFallNegative <c>true</c> if the falling dead time delays the falling edge of the reference output
+ */
+static void ApplyDeadTime(delayed_output_t* out1, delayed_output_t* out2, uint8_t ref, uint64_t rise, uint64_t fall,
+		bool isRiseNegative, bool isFallNegative)
+{
+	if (ref)
+	{
+		if (isRiseNegative)
+		{
+			SetLevel(out1, 1);
+			ScheduleLevel(out2, 0, rise);
+		}
+		else
+		{
+			SetLevel(out2, 0);
+			ScheduleLevel(out1, 1, rise);
+		}
+	}
+	else if (isFallNegative)
+	{
+		SetLevel(out2, 1);
+		ScheduleLevel(out1, 0, fall);
+	}
+	else
+	{
+		SetLevel(out1, 0);
+		ScheduleLevel(out2, 1, fall);
+	}
+}
+
+static void UpdateHrtimOutputs(int idx, uint32_t events)
+{
+	HRTIM_Timerx_TypeDef* regs = &HRTIM1->sTimerxRegs[idx];
+	bool isDeadTime = (regs->OUTxR & HRTIM_OUTR_DTEN) != 0;
+	for (int o = 0; o < 2; o++)
+	{
+		// the second output is generated by the dead time generator
+		if (o == 1 && isDeadTime)
+			break;
+		uint8_t* raw = &rawLevels[idx * 2 + o];
+		uint8_t level = *raw;
+		if (events & (o ? regs->RSTx2R : regs->RSTx1R))
+			level = 0;
+		else if (events & (o ? regs->SETx2R : regs->SETx1R))
+			level = 1;
+		if (level == *raw)
+			continue;
+		*raw = level;
+		if (isDeadTime)
+		{
+			uint32_t dtr = regs->DTxR;
+			uint32_t prescaler = (dtr & HRTIM_DTR_DTPRSC) >> HRTIM_DTR_DTPRSC_Pos;
+			// tDTG = tHRTIM * 2^(DTPRSC - 3)
+			uint64_t rise = (((uint64_t)(dtr & HRTIM_DTR_DTR) >> HRTIM_DTR_DTR_Pos) << prescaler) >> 3;
+			uint64_t fall = (((uint64_t)(dtr & HRTIM_DTR_DTF) >> HRTIM_DTR_DTF_Pos) << prescaler) >> 3;
+			ApplyDeadTime(&outputs[idx * 2], &outputs[idx * 2 + 1], level, rise, fall,
+					(dtr & HRTIM_DTR_SDTR) != 0, (dtr & HRTIM_DTR_SDTF) != 0);
+		}
+		else
+			SetLevel(&outputs[idx * 2 + o], level);
+	}
+}
+
+static uint32_t StepMaster(bool* isUpdate)
+{
+	HRTIM_Master_TypeDef* regs = &HRTIM1->sMasterRegs;
+	unit_state_t* st = &units[MASTER];
+	uint32_t control = regs->MCR;
+	uint32_t events = 0;
+	if (!(control & HRTIM_MCR_PREEN))
+		LoadActive(MASTER);
+
+	if (softwareResets & UNIT_SWRST(MASTER))
+	{
+		st->counter = 0;
+		st->prescaler = 0;
+	}
+	else if (++st->prescaler < prescalerDivs[control & HRTIM_MCR_CK_PSC])
+		return 0;
+	else
+	{
+		st->prescaler = 0;
+		if (++st->counter >= st->period)
+		{
+			st->counter = 0;
+			events |= HRTIM_SET1R_MSTPER;
+			if (st->repCounter == 0)
+			{
+				st->repCounter = st->repetition;
+				RaiseFlag(MASTER, HRTIM_MISR_MREP);
+				if ((control & HRTIM_MCR_MREPU) && !(HRTIM1->sCommonRegs.CR1 & UNIT_UDIS(MASTER)))
+				{
+					TransferPreload(MASTER);
+					*isUpdate = true;
+				}
+			}
+			else
+				st->repCounter--;
+		}
+	}
+
+	for (int i = 0; i < 4; i++)
+	{
+		if (st->counter == st->compares[i])
+			events |= HRTIM_SET1R_MSTCMP1 << i;
+	}
+	regs->MCNTR = st->counter;
+	return events;
+}
+
+static void StepTimer(int idx, uint32_t masterEvents, bool isMasterUpdate)
+{
+	HRTIM_Timerx_TypeDef* regs = &HRTIM1->sTimerxRegs[idx];
+	unit_state_t* st = &units[idx];
+	uint32_t control = regs->TIMxCR;
+	uint32_t events = masterEvents & MASTER_EVENTS;
+	bool isUpdate = isMasterUpdate && (control & HRTIM_TIMCR_MSTU);
+	bool isCounted = true;
+	if (!(control & HRTIM_TIMCR_PREEN))
+		LoadActive(idx);
+
+	if ((regs->RSTxR & MASTER_EVENTS_TO_RESET(masterEvents)) || (softwareResets & UNIT_SWRST(idx)))
+	{
+		st->counter = 0;
+		st->prescaler = 0;
+		RaiseFlag(idx, HRTIM_TIMISR_RST);
+		isUpdate |= (control & HRTIM_TIMCR_TRSTU) != 0;
+	}
+	else if (++st->prescaler < prescalerDivs[control & HRTIM_TIMCR_CK_PSC])
+		isCounted = false;
+	else
+	{
+		st->prescaler = 0;
+		if (++st->counter >= st->period)
+		{
+			// roll-over is reported with the reset flag
+			st->counter = 0;
+			events |= HRTIM_SET1R_PER;
+			RaiseFlag(idx, HRTIM_TIMISR_RST);
+			isUpdate |= (control & HRTIM_TIMCR_TRSTU) != 0;
+			if (st->repCounter == 0)
+			{
+				st->repCounter = st->repetition;
+				RaiseFlag(idx, HRTIM_TIMISR_REP);
+				isUpdate |= (control & HRTIM_TIMCR_TREPU) != 0;
+			}
+			else
+				st->repCounter--;
+		}
+	}
+
+	if (isUpdate && !(HRTIM1->sCommonRegs.CR1 & UNIT_UDIS(idx)))
+	{
+		TransferPreload(idx);
+		RaiseFlag(idx, HRTIM_TIMISR_UPD);
+		events |= HRTIM_SET1R_UPDATE;
+	}
+	if (isCounted)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			if (st->counter == st->compares[i])
+				events |= HRTIM_SET1R_CMP1 << i;
+		}
+		regs->CNTxR = st->counter;
+	}
+	if (events)
+		UpdateHrtimOutputs(idx, events);
+}
+
+static uint32_t GetTim1DeadTicks(void)
+{
+	uint32_t dtg = (TIM1->BDTR & TIM_BDTR_DTG) >> TIM_BDTR_DTG_Pos;
+	uint32_t ticks;
+	if ((dtg & 0x80) == 0)
+		ticks = dtg;
+	else if ((dtg & 0xC0) == 0x80)
+		ticks = (64 + (dtg & 0x3F)) * 2;
+	else if ((dtg & 0xE0) == 0xC0)
+		ticks = (32 + (dtg & 0x1F)) * 8;
+	else
+		ticks = (32 + (dtg & 0x1F)) * 16;
+	return ticks * TIM1_CLOCK_DIV;
+}
+
+static void Tim1Update(void)
+{
+	tim1.arr = TIM1->ARR;
+	tim1.rcr = TIM1->RCR;
+	tim1.ccr[0] = TIM1->CCR1;
+	tim1.ccr[1] = TIM1->CCR2;
+	tim1.ccr[2] = TIM1->CCR3;
+	tim1.sr |= TIM_SR_UIF;
+	TIM1->SR = tim1.sr;
+	if (TIM1->DIER & TIM_DIER_UIE)
+		pendingIrqs |= TIM1_IRQ_BIT;
+	LogUpdate(HRTIM_MODEL_UNIT_TIM1, tim1.arr, tim1.ccr, TIM1_CHANNEL_COUNT);
+}
+
+static void StepTim1(void)
+{
+	uint32_t cr1 = TIM1->CR1;
+	if (!(cr1 & TIM_CR1_CEN))
+		return;
+	if (++tim1.prescaler < (TIM1->PSC + 1) * TIM1_CLOCK_DIV)
+		return;
+	tim1.prescaler = 0;
+
+	uint32_t arr = (cr1 & TIM_CR1_ARPE) ? tim1.arr : TIM1->ARR;
+	bool isCenterAligned = (cr1 & TIM_CR1_CMS) != 0;
+	bool isEvent = false;
+	if (!isCenterAligned)
+	{
+		if (tim1.counter >= arr)
+		{
+			tim1.counter = 0;
+			isEvent = true;
+		}
+		else
+			tim1.counter++;
+	}
+	else if (!tim1.isDown)
+	{
+		// overflow after counting up to ARR
+		if (++tim1.counter >= arr)
+		{
+			tim1.counter = arr;
+			tim1.isDown = true;
+			isEvent = true;
+		}
+	}
+	else if (tim1.counter <= 1)
+	{
+		// underflow after counting down to 0
+		tim1.counter = 0;
+		tim1.isDown = false;
+		isEvent = true;
+	}
+	else
+		tim1.counter--;
+
+	if (isEvent)
+	{
+		if (tim1.repCounter == 0)
+		{
+			tim1.repCounter = tim1.rcr;
+			if (!(cr1 & TIM_CR1_UDIS))
+				Tim1Update();
+		}
+		else
+			tim1.repCounter--;
+	}
+	TIM1->CNT = tim1.counter;
+
+	bool isUp = !isCenterAligned || !tim1.isDown;
+	uint64_t deadTicks = GetTim1DeadTicks();
+	for (int ch = 0; ch < TIM1_CHANNEL_COUNT; ch++)
+	{
+		uint32_t ccmr = ch < 2 ? TIM1->CCMR1 : TIM1->CCMR2;
+		uint32_t shift = (ch == 1) ? 8 : 0;
+		uint32_t mode = (ccmr >> (TIM_CCMR1_OC1M_Pos + shift)) & 0x7;
+		uint32_t ccr = (ccmr & (TIM_CCMR1_OC1PE << shift)) ? tim1.ccr[ch] : (&TIM1->CCR1)[ch];
+		uint8_t ref;
+		if (mode == TIM_OCMODE_PWM1_VALUE)
+			ref = isUp ? tim1.counter < ccr : tim1.counter <= ccr;
+		else if (mode == TIM_OCMODE_PWM2_VALUE)
+			ref = isUp ? tim1.counter >= ccr : tim1.counter > ccr;
+		else
+			ref = tim1.ref[ch];
+		if (ref == tim1.ref[ch])
+			continue;
+		tim1.ref[ch] = ref;
+		ApplyDeadTime(&outputs[HRTIM_OUTPUT_COUNT + ch * 2], &outputs[HRTIM_OUTPUT_COUNT + ch * 2 + 1],
+				ref, deadTicks, deadTicks, false, false);
+	}
+}
+
+static void ProcessPending(void)
+{
+	for (int i = 0; i < HRTIM_MODEL_PWM_COUNT; i++)
+	{
+		if (outputs[i].isPending && simTime >= outputs[i].pendingTime)
+			SetLevel(&outputs[i], outputs[i].pendingLevel);
+	}
+}
+
+static uint8_t GetPinLevel(int i)
+{
+	if (i < HRTIM_OUTPUT_COUNT)
+	{
+		uint32_t outr = HRTIM1->sTimerxRegs[i / 2].OUTxR;
+		uint8_t polarity = (outr >> ((i % 2) ? HRTIM_OUTR_POL2_Pos : HRTIM_OUTR_POL1_Pos)) & 1;
+		if (enabledOutputs & (1U << i))
+			return outputs[i].level ^ polarity;
+		// idle level is the inactive level unless IDLES is set
+		uint8_t idles = (outr >> ((i % 2) ? HRTIM_OUTR_IDLES2_Pos : HRTIM_OUTR_IDLES1_Pos)) & 1;
+		return idles ? !polarity : polarity;
+	}
+	int ch = (i - HRTIM_OUTPUT_COUNT) / 2;
+	bool isComplementary = (i - HRTIM_OUTPUT_COUNT) % 2;
+	uint32_t ccer = TIM1->CCER >> (ch * 4);
+	uint32_t enable = isComplementary ? TIM_CCER_CC1NE : TIM_CCER_CC1E;
+	uint32_t polarity = isComplementary ? TIM_CCER_CC1NP : TIM_CCER_CC1P;
+	if (!(TIM1->BDTR & TIM_BDTR_MOE) || !(ccer & enable))
+		return HRTIM_MODEL_LEVEL_Z;
+	return outputs[i].level ^ ((ccer & polarity) != 0);
+}
+
+static void RefreshPins(void)
+{
+	if (!isDirty)
+		return;
+	isDirty = false;
+	for (int i = 0; i < HRTIM_MODEL_PWM_COUNT; i++)
+	{
+		uint8_t level = GetPinLevel(i);
+		if (level == pins[i])
+			continue;
+		pins[i] = level;
+		if (edgeCount < HRTIM_MODEL_MAX_EDGES)
+		{
+			edges[edgeCount].time = simTime;
+			edges[edgeCount].pwmNo = i + 1;
+			edges[edgeCount++].level = level;
+		}
+	}
+}
+
+static void DispatchIrqs(void)
+{
+	uint32_t irqs = pendingIrqs;
+	pendingIrqs = 0;
+	for (int idx = 0; idx <= HRTIM_MODEL_UNIT_TIM1; idx++)
+	{
+		if (!(irqs & (1U << idx)))
+			continue;
+		IRQn_Type irq = idx == HRTIM_MODEL_UNIT_TIM1 ? TIM1_UP_IRQn :
+				(idx == MASTER ? HRTIM1_Master_IRQn : (IRQn_Type)(HRTIM1_TIMA_IRQn + idx));
+		if (HostBsp_RaiseIrq(irq))
+			ProcessWrites();
+	}
+}
+
+/**
+ * @brief Processes the register writes with side effects made by the software since the last call.
+ */
+static void ProcessWrites(void)
+{
+	HRTIM_Common_TypeDef* common = &HRTIM1->sCommonRegs;
+	enabledOutputs |= common->OENR;
+	enabledOutputs &= ~common->ODISR;
+	common->ODISR = 0;
+	// reading OENR returns the enabled outputs
+	common->OENR = enabledOutputs;
+
+	HRTIM1->sMasterRegs.MISR &= ~HRTIM1->sMasterRegs.MICR;
+	HRTIM1->sMasterRegs.MICR = 0;
+	for (int idx = 0; idx < TIMER_COUNT; idx++)
+	{
+		HRTIM1->sTimerxRegs[idx].TIMxISR &= ~HRTIM1->sTimerxRegs[idx].TIMxICR;
+		HRTIM1->sTimerxRegs[idx].TIMxICR = 0;
+	}
+
+	uint32_t cr2 = common->CR2;
+	common->CR2 = 0;
+	uint32_t mcr = HRTIM1->sMasterRegs.MCR;
+	for (int idx = 0; idx < UNIT_COUNT; idx++)
+	{
+		unit_state_t* st = &units[idx];
+		if (!st->isRunning)
+		{
+			LoadActive(idx);
+			if (mcr & UNIT_ENABLE(idx))
+			{
+				st->isRunning = true;
+				st->counter = 0;
+				st->prescaler = 0;
+				st->repCounter = st->repetition;
+			}
+		}
+		else if (!(mcr & UNIT_ENABLE(idx)))
+			st->isRunning = false;
+		else if (cr2 & UNIT_SWU(idx))
+			TransferPreload(idx);
+		if (cr2 & UNIT_SWRST(idx))
+			softwareResets |= UNIT_SWRST(idx);
+	}
+
+	// status bits of TIM1 are cleared by writing 0
+	tim1.sr &= TIM1->SR;
+	TIM1->SR = tim1.sr;
+	if (TIM1->EGR & TIM_EGR_UG)
+	{
+		tim1.counter = 0;
+		tim1.prescaler = 0;
+		tim1.isDown = false;
+		Tim1Update();
+		tim1.repCounter = tim1.rcr;
+	}
+	TIM1->EGR = 0;
+	isDirty = true;
+}
+
+/**
+ * @brief Resets the registers, the simulation time and the timelines.
+ * @note Call before configuring the PWM drivers.
+ */
+void HrtimModel_Init(void)
+{
+	memset(&hostHRTIM1, 0, sizeof(hostHRTIM1));
+	memset(&hostTIM1, 0, sizeof(hostTIM1));
+	memset(units, 0, sizeof(units));
+	memset(rawLevels, 0, sizeof(rawLevels));
+	memset(outputs, 0, sizeof(outputs));
+	memset(&tim1, 0, sizeof(tim1));
+	simTime = 0;
+	enabledOutputs = 0;
+	softwareResets = 0;
+	pendingIrqs = 0;
+	isDirty = false;
+	for (int i = 0; i < HRTIM_MODEL_PWM_COUNT; i++)
+		pins[i] = GetPinLevel(i);
+	HrtimModel_ClearTimeline();
+}
+
+/**
+ * @brief Runs the simulation for the given time.
+ * @param ticks Number of simulation clock ticks (@ref HRTIM_MODEL_CLOCK_Hz)
+ */
+void HrtimModel_Run(uint64_t ticks)
+{
+	ProcessWrites();
+	RefreshPins();
+	while (ticks--)
+	{
+		simTime++;
+		uint32_t masterEvents = 0;
+		bool isMasterUpdate = false;
+		if (units[MASTER].isRunning)
+			masterEvents = StepMaster(&isMasterUpdate);
+		for (int idx = 0; idx < TIMER_COUNT; idx++)
+		{
+			if (units[idx].isRunning)
+				StepTimer(idx, masterEvents, isMasterUpdate);
+		}
+		softwareResets = 0;
+		StepTim1();
+		ProcessPending();
+		RefreshPins();
+		if (pendingIrqs)
+			DispatchIrqs();
+	}
+}
+
+/**
+ * @brief Gets the simulation time.
+ * @return uint64_t Ticks since @ref HrtimModel_Init()
+ */
+uint64_t HrtimModel_GetTime(void)
+{
+	return simTime;
+}
+
+/**
+ * @brief Gets the current level of a PWM pin.
+ * @param pwmNo PWM pin (Range 1-16)
+ * @return int 0, 1 or @ref HRTIM_MODEL_LEVEL_Z
+ */
+int HrtimModel_GetOutput(uint32_t pwmNo)
+{
+	return pins[pwmNo - 1];
+}
+
+/**
+ * @brief Finds the first edge of a pin to the given level at or after the given time.
+ * @param pwmNo PWM pin (Range 1-16)
+ * @param level Required level
+ * @param from Start of the search in simulation ticks
+ * @return uint64_t Time of the edge, or UINT64_MAX if no such edge is recorded
+ */
+uint64_t HrtimModel_FindEdge(uint32_t pwmNo, int level, uint64_t from)
+{
+	// edges are recorded in the order of time
+	uint32_t low = 0, high = edgeCount;
+	while (low < high)
+	{
+		uint32_t mid = (low + high) / 2;
+		if (edges[mid].time < from)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	for (uint32_t i = low; i < edgeCount; i++)
+	{
+		if (edges[i].pwmNo == pwmNo && edges[i].level == level)
+			return edges[i].time;
+	}
+	return UINT64_MAX;
+}
+
+/**
+ * @brief Gets the recorded edges in the order of time.
+ * @param count Filled with the number of edges
+ * @return const hrtim_model_edge_t* Recorded edges
+ */
+const hrtim_model_edge_t* HrtimModel_GetEdges(int* count)
+{
+	*count = (int)edgeCount;
+	return edges;
+}
+
+/**
+ * @brief Gets the recorded register transfers in the order of time.
+ * @param count Filled with the number of transfers
+ * @return const hrtim_model_update_t* Recorded transfers
+ */
+const hrtim_model_update_t* HrtimModel_GetUpdates(int* count)
+{
+	*count = (int)updateCount;
+	return updates;
+}
+
+/**
+ * @brief Clears the timelines. The current levels become the initial levels of the VCD export.
+ */
+void HrtimModel_ClearTimeline(void)
+{
+	edgeCount = 0;
+	updateCount = 0;
+	timelineStart = simTime;
+	memcpy(timelineLevels, pins, sizeof(pins));
+}
+
+static char GetVcdLevel(uint8_t level)
+{
+	return level == HRTIM_MODEL_LEVEL_Z ? 'z' : (char)('0' + level);
+}
+
+/**
+ * @brief Writes the recorded edges of all pins as a value change dump.
+ * @param path Path of the file
+ * @return bool <c>true</c> if successful
+ */
+bool HrtimModel_WriteVcd(const char* path)
+{
+	FILE* file = fopen(path, "w");
+	if (file == NULL)
+		return false;
+	// one tick of 480 MHz is 2083.33 ps
+	fprintf(file, "$timescale 1 ps $end\n$scope module pecontroller $end\n");
+	for (int i = 0; i < HRTIM_MODEL_PWM_COUNT; i++)
+		fprintf(file, "$var wire 1 %c PWM%d $end\n", '!' + i, i + 1);
+	fprintf(file, "$upscope $end\n$enddefinitions $end\n#%llu\n$dumpvars\n",
+			(unsigned long long)(timelineStart * 6250 / 3));
+	for (int i = 0; i < HRTIM_MODEL_PWM_COUNT; i++)
+		fprintf(file, "%c%c\n", GetVcdLevel(timelineLevels[i]), '!' + i);
+	fprintf(file, "$end\n");
+	uint64_t lastTime = timelineStart;
+	for (uint32_t i = 0; i < edgeCount; i++)
+	{
+		if (edges[i].time != lastTime)
+		{
+			lastTime = edges[i].time;
+			fprintf(file, "#%llu\n", (unsigned long long)(lastTime * 6250 / 3));
+		}
+		fprintf(file, "%c%c\n", GetVcdLevel(edges[i].level), '!' + edges[i].pwmNo - 1);
+	}
+	return fclose(file) == 0;
+}
+
+/* EOF */
@@ -0,0 +1,308 @@
+/**
+ ********************************************************************************
+ * @file    	p2p_test.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Host test of the parameter access of the inter-core communication.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * The test is built for the communication core with the parameters of an application and linked with the
+ * control core code of p2p_comms.c. P2PComms_WaitForResponse() is replaced so that the control core processes
+ * the pending requests in turns with the communication core.
+ *
+ * The binary access by id is checked against the text access for each parameter, and both are benchmarked.
+ * The sorted name index of the application is checked and its binary search is compared with a linear search.
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdio.h>
+#include <time.h>
+#include "shared_memory.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define BENCHMARK_COUNT				(200000)
+#define TEXT_SIZE					(32)
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static int failureCount = 0;
+/********************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+/* control core functions of p2p_comms.c */
+extern void P2PComms_InitData(void);
+extern void P2PComms_ProcessPendingRequests(void);
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+static void Check(bool isPassed, const char* msg)
+{
+	if (isPassed)
+		return;
+	printf("  FAILED: %s\n", msg);
+	failureCount++;
+}
+
+static double GetTimeNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+void P2PComms_WaitForResponse(volatile p2p_msg_t* msg)
+{
+	// the control core runs in turns with the communication core
+	while (msg->responseIndex == -1)
+		P2PComms_ProcessPendingRequests();
+}
+
+/**
+ * @brief Gets a test value for a parameter, within the range of its type and exact at the precision of its text.
+ */
+static data_union_t GetTestValue(data_param_info_t* param, uint32_t n)
+{
+	data_union_t value = { .u32 = 0 };
+	switch (param->type)
+	{
+	case DTYPE_BOOL: value.b = (n & 1) == 0; break;
+	case DTYPE_U8: value.u8 = 200 - n; break;
+	case DTYPE_U16: value.u16 = 60000 - n; break;
+	case DTYPE_U32: value.u32 = 4000000000U - n; break;
+	case DTYPE_S8: value.s8 = -100 + n; break;
+	case DTYPE_S16: value.s16 = -30000 + n; break;
+	case DTYPE_S32: value.s32 = -2000000000 + n; break;
+	case DTYPE_FLOAT: value.f = (param->arg ? 12.5f : 12.0f) + n; break;
+	case DTYPE_BIT_ACCESS: value.bits = (n & 1) ? BITS_CLR : BITS_SET; break;
+	default: break;
+	}
+	return value;
+}
+
+static bool IsValueEqual(data_param_info_t* param, data_union_t a, data_union_t b)
+{
+	switch (param->type)
+	{
+	case DTYPE_BOOL: return a.b == b.b;
+	case DTYPE_U8: case DTYPE_S8: return a.u8 == b.u8;
+	case DTYPE_U16: case DTYPE_S16: return a.u16 == b.u16;
+	case DTYPE_FLOAT: return a.f == b.f;
+	default: return a.u32 == b.u32;
+	}
+}
+
+/**
+ * @brief Checks that the binary access by id and the text access agree for each parameter.
+ */
+static void Test_ValueById(void)
+{
+	int checkedCount = 0;
+	printf("Binary access of %d parameters\n", P2P_PARAM_COUNT);
+	for (int id = 0; id < P2P_PARAM_COUNT; id++)
+	{
+		data_param_info_t* param = &p2pCommsParams[id];
+		data_union_t expected = GetTestValue(param, 0), value;
+		Check(P2PComms_UpdateValueById((p2p_params_type_t)id, expected) == ERR_OK, "binary update failed");
+		Check(P2PComms_GetValueById((p2p_params_type_t)id, &value) == ERR_OK, "binary read failed");
+		if (param->type == DTYPE_BIT_ACCESS)
+		{
+			// the set request sets the bits of the argument, which are read back
+			Check(value.bits == param->arg, "bits not set");
+			Check(P2PComms_UpdateValueById((p2p_params_type_t)id, GetTestValue(param, 1)) == ERR_OK &&
+					P2PComms_GetValueById((p2p_params_type_t)id, &value) == ERR_OK && value.bits == 0, "bits not cleared");
+			continue;
+		}
+		if (!IsValueEqual(param, expected, value))
+		{
+			printf("  %-24s: binary value not read back\n", param->name);
+			Check(false, "binary value not read back");
+		}
+		volatile void* reg = P2PComms_GetRegisterPtr(param->type, param->index);
+		Check(reg != NULL && memcmp((void*)reg, &value, param->type == DTYPE_BOOL || param->type == DTYPE_U8 || param->type == DTYPE_S8 ? 1 :
+				(param->type == DTYPE_U16 || param->type == DTYPE_S16 ? 2 : 4)) == 0, "register pointer");
+
+		// the text of the binary value gives the same value
+		char text[TEXT_SIZE];
+		Check(P2PComms_GetStringValue(param, text, false) == ERR_OK, "text read failed");
+		Check(P2PComms_UpdateValueById((p2p_params_type_t)id, GetTestValue(param, 1)) == ERR_OK, "binary update failed");
+		Check(P2PComms_UpdateFromString(param, text) == ERR_OK, "text update failed");
+		Check(P2PComms_GetValueById((p2p_params_type_t)id, &value) == ERR_OK, "binary read failed");
+		if (!IsValueEqual(param, expected, value))
+		{
+			printf("  %-24s: text \"%s\" gives a different value\n", param->name, text);
+			Check(false, "text and binary values differ");
+		}
+		checkedCount++;
+	}
+	data_union_t value;
+	Check(P2PComms_GetValueById(P2P_PARAM_COUNT, &value) == ERR_ILLEGAL &&
+			P2PComms_UpdateValueById(P2P_PARAM_COUNT, value) == ERR_ILLEGAL, "invalid id accepted");
+	Check(P2PComms_GetRegisterPtr(DTYPE_COUNT, 0) == NULL && P2PComms_GetRegisterPtr(DTYPE_U32, P2P_U32_COUNT) == NULL, "invalid register");
+	printf("  text round trips  : %d parameters\n", checkedCount);
+}
+
+/**
+ * @brief Measures the binary access against the text access of the parameters.
+ */
+static void Benchmark_StringVsBinary(void)
+{
+	char texts[P2P_PARAM_COUNT][TEXT_SIZE];
+	data_union_t values[P2P_PARAM_COUNT];
+	char text[TEXT_SIZE];
+	data_union_t value;
+	int textCount = 0;
+	volatile uint32_t sink = 0;
+
+	// only the parameters with a text format are updated in both benchmarks
+	for (int id = 0; id < P2P_PARAM_COUNT; id++)
+	{
+		(void)P2PComms_GetValueById((p2p_params_type_t)id, &values[id]);
+		if (P2PComms_GetStringValue(&p2pCommsParams[id], texts[id], false) == ERR_OK)
+			textCount++;
+	}
+	if (textCount == 0)
+		return;
+
+	double startTime = GetTimeNs();
+	for (uint32_t n = 0; n < BENCHMARK_COUNT; n++)
+	{
+		(void)P2PComms_GetValueById((p2p_params_type_t)(n % P2P_PARAM_COUNT), &value);
+		sink += value.u32;
+	}
+	double binaryReadNs = (GetTimeNs() - startTime) / BENCHMARK_COUNT;
+
+	startTime = GetTimeNs();
+	for (uint32_t n = 0, count = 0; count < BENCHMARK_COUNT; n++)
+		if (P2PComms_GetStringValue(&p2pCommsParams[n % P2P_PARAM_COUNT], text, true) == ERR_OK)
+		{
+			sink += text[0];
+			count++;
+		}
+	double textReadNs = (GetTimeNs() - startTime) / BENCHMARK_COUNT;
+
+	startTime = GetTimeNs();
+	for (uint32_t n = 0, count = 0; count < BENCHMARK_COUNT; n++)
+		if (texts[n % P2P_PARAM_COUNT][0])
+		{
+			(void)P2PComms_UpdateValueById((p2p_params_type_t)(n % P2P_PARAM_COUNT), values[n % P2P_PARAM_COUNT]);
+			count++;
+		}
+	double binaryWriteNs = (GetTimeNs() - startTime) / BENCHMARK_COUNT;
+
+	startTime = GetTimeNs();
+	for (uint32_t n = 0, count = 0; count < BENCHMARK_COUNT; n++)
+		if (texts[n % P2P_PARAM_COUNT][0])
+		{
+			(void)P2PComms_UpdateFromString(&p2pCommsParams[n % P2P_PARAM_COUNT], texts[n % P2P_PARAM_COUNT]);
+			count++;
+		}
+	double textWriteNs = (GetTimeNs() - startTime) / BENCHMARK_COUNT;
+
+	printf("  read              : %.1f ns binary, %.1f ns text with unit (%.1fx)\n", binaryReadNs, textReadNs, textReadNs / binaryReadNs);
+	printf("  update            : %.1f ns binary, %.1f ns from text (%.1fx), including the control core processing\n",
+			binaryWriteNs, textWriteNs, textWriteNs / binaryWriteNs);
+	(void)sink;
+}
+
+/**
+ * @brief Finds a parameter by comparing the name with each parameter in turn.
+ */
+static int FindParameterLinear(const char* name)
+{
+	for (int id = 0; id < P2P_PARAM_COUNT; id++)
+		if (strcmp(name, p2pCommsParams[id].name) == 0)
+			return id;
+	return -1;
+}
+
+/**
+ * @brief Checks that the name index is sorted and that each parameter is found by its name.
+ */
+static void Test_NameIndex(void)
+{
+	bool isListed[P2P_PARAM_COUNT] = { false };
+	p2p_params_type_t id;
+	printf("Name index of %d parameters\n", P2P_PARAM_COUNT);
+	for (int i = 0; i < P2P_PARAM_COUNT; i++)
+	{
+		uint8_t index = p2pCommsParamsNameIndex[i];
+		Check(index < P2P_PARAM_COUNT && !isListed[index], "name index is not a permutation of the parameters");
+		if (index < P2P_PARAM_COUNT)
+			isListed[index] = true;
+		if (i > 0 && strcmp(p2pCommsParams[p2pCommsParamsNameIndex[i - 1]].name, p2pCommsParams[index].name) > 0)
+		{
+			printf("  %-24s: listed after %s\n", p2pCommsParams[index].name, p2pCommsParams[p2pCommsParamsNameIndex[i - 1]].name);
+			Check(false, "name index not sorted");
+		}
+	}
+	for (int i = 0; i < P2P_PARAM_COUNT; i++)
+	{
+		const char* name = p2pCommsParams[i].name;
+		// parameters sharing a name may give any of them
+		if (P2PComms_FindParameterByName(name, &id) != ERR_OK || strcmp(p2pCommsParams[id].name, name) != 0)
+		{
+			printf("  %-24s: not found\n", name);
+			Check(false, "parameter not found by its name");
+		}
+	}
+
+	char name[TEXT_SIZE * 2];
+	snprintf(name, sizeof(name), "%s ", p2pCommsParams[0].name);
+	Check(P2PComms_FindParameterByName(name, &id) == ERR_NOT_AVAILABLE && P2PComms_FindParameterByName("", &id) == ERR_NOT_AVAILABLE &&
+			P2PComms_FindParameterByName("~", &id) == ERR_NOT_AVAILABLE, "unknown name found");
+	Check(P2PComms_FindParameterByName(NULL, &id) == ERR_ILLEGAL, "invalid name accepted");
+}
+
+/**
+ * @brief Measures the binary search of the name index against a linear search.
+ */
+static void Benchmark_FindByName(void)
+{
+	p2p_params_type_t id;
+	volatile uint32_t sink = 0;
+	double startTime = GetTimeNs();
+	for (uint32_t n = 0; n < BENCHMARK_COUNT; n++)
+	{
+		(void)P2PComms_FindParameterByName(p2pCommsParams[n % P2P_PARAM_COUNT].name, &id);
+		sink += id;
+	}
+	double binaryNs = (GetTimeNs() - startTime) / BENCHMARK_COUNT;
+
+	startTime = GetTimeNs();
+	for (uint32_t n = 0; n < BENCHMARK_COUNT; n++)
+		sink += FindParameterLinear(p2pCommsParams[n % P2P_PARAM_COUNT].name);
+	double linearNs = (GetTimeNs() - startTime) / BENCHMARK_COUNT;
+
+	printf("  lookup            : %.1f ns binary search, %.1f ns linear search\n", binaryNs, linearNs);
+	(void)sink;
+}
+
+int main(void)
+{
+	printf("Application %s\n", P2P_APP_NAME);
+	P2PComms_InitData();
+	Test_ValueById();
+	Benchmark_StringVsBinary();
+	Test_NameIndex();
+	Benchmark_FindByName();
+	printf(failureCount ? "%d check(s) FAILED\n" : "All checks passed\n", failureCount);
+	return failureCount ? 1 : 0;
+}
+
+/* EOF */
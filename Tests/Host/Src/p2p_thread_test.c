@@ -0,0 +1,259 @@
+/**
+ ********************************************************************************
+ * @file    	p2p_thread_test.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Host benchmark of the inter-core communication with a thread for each core.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * The test is built for the communication core with the configuration of the template application and
+ * P2P_COMMS_ENABLE_BENCHMARK set, and linked with the control core code of p2p_comms.c. A control thread
+ * processes the pending requests in a loop as the main loop of the control core, while the main thread
+ * places the requests with the unmodified waiting of the communication core. The statistics and the
+ * throughput table are collected by the benchmark functions of p2p_comms.c in the shared memory.
+ *
+ * The response time is first measured while the communication core polls at each tick of the host RTOS, and
+ * then with the notifications, where the emulated hardware semaphore interrupt wakes the waiting thread through
+ * its condition variable. The notifications cannot be disabled again, so the polling is measured first.
+ *
+ * The buffer sizes are compile time settings of p2p_comms_app.h and are compared by rebuilding the test.
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include "cmsis_os.h"
+#include "shared_memory.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define UPDATE_COUNT				(2000)
+#define LATENCY_MSG_COUNT			(5000)
+#define SWEEP_MSG_COUNT				(2000)
+#define POLLED_REQUEST_COUNT		(50)
+#define NOTIFIED_REQUEST_COUNT		(2000)
+#define TICK_CYCLES					(HOST_RTOS_TICK_US * (SystemCoreClock / 1000000))
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static const uint16_t sweepMsgSizes[P2P_COMMS_SWEEP_COUNT] = { 1, 4, 16, 64 };
+static const uint16_t sweepBatchSizes[P2P_COMMS_SWEEP_COUNT] = { 1, 4, 16, 32 };
+static volatile bool isControlRunning;
+static int failureCount = 0;
+/********************************************************************************
+ * Function Prototypes
+ *******************************************************************************/
+/* control core functions of p2p_comms.c */
+extern void P2PComms_InitData(void);
+extern void P2PComms_ProcessPendingRequests(void);
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+static void Check(bool isPassed, const char* msg)
+{
+	if (isPassed)
+		return;
+	printf("  FAILED: %s\n", msg);
+	failureCount++;
+}
+
+static double CyclesToUs(double cycles)
+{
+	return cycles / (SystemCoreClock / 1000000);
+}
+
+/**
+ * @brief Main loop of the control core.
+ */
+static void* RunControlCore(void* arg)
+{
+	while (isControlRunning)
+	{
+		P2PComms_ProcessPendingRequests();
+		sched_yield();
+	}
+	return NULL;
+}
+
+static bool IsQueueEmpty(void)
+{
+	return RingBuffer_IsEmpty((ring_buffer_t*)&CORE_MSGS.msgsRingBuff);
+}
+
+static void PrintStats(const volatile p2p_comms_stats_t* stats)
+{
+	printf("  round trip        : min %.2f us, mean %.2f us, max %.2f us, max %u pending messages\n", CyclesToUs(stats->minCycles),
+			CyclesToUs((double)stats->totalCycles / stats->requestCount), CyclesToUs(stats->maxCycles), stats->maxPendingMsgs);
+	printf("  histogram         :");
+	for (int i = 0; i < P2P_COMMS_LATENCY_BINS; i++)
+		if (stats->histogram[i])
+			printf(" %.2fus:%u", CyclesToUs(1U << i), stats->histogram[i]);
+	printf("\n");
+}
+
+static uint32_t GetHistogramSum(const volatile p2p_comms_stats_t* stats)
+{
+	uint32_t sum = 0;
+	for (int i = 0; i < P2P_COMMS_LATENCY_BINS; i++)
+		sum += stats->histogram[i];
+	return sum;
+}
+
+/**
+ * @brief Finds the first parameter of the given type.
+ */
+static int FindParameter(base_data_type_t type)
+{
+	for (int id = 0; id < P2P_PARAM_COUNT; id++)
+		if (p2pCommsParams[id].type == type)
+			return id;
+	return -1;
+}
+
+/**
+ * @brief Measures the response time of the given no of parameter updates.
+ * @param result Copy of the statistics of the updates.
+ * @return No of waits for the response timed out at the tick of the host RTOS.
+ */
+static uint32_t MeasureResponseTime(uint32_t count, p2p_comms_stats_t* result)
+{
+	int id = FindParameter(DTYPE_U32);
+	uint32_t timeoutCount = hostRtosTimeoutCount;
+	P2PComms_ResetStats();
+	for (uint32_t n = 0; n < count && id >= 0; n++)
+		Check(P2PComms_UpdateValueById((p2p_params_type_t)id, (data_union_t){ .u32 = n }) == ERR_OK, "update failed");
+	memcpy(result, (void*)&CORE_MSGS.stats, sizeof(p2p_comms_stats_t));
+	Check(id >= 0 && result->requestCount == count, "requests not recorded");
+	return hostRtosTimeoutCount - timeoutCount;
+}
+
+/**
+ * @brief Compares the response time of the polling with the response time of the notifications.
+ * @details The notifications are enabled by this test.
+ */
+static void Benchmark_ResponseWait(void)
+{
+	p2p_comms_stats_t polled, notified;
+	printf("Response time with polling at each %d us tick and with notifications\n", HOST_RTOS_TICK_US);
+	(void)MeasureResponseTime(POLLED_REQUEST_COUNT, &polled);
+	printf("  %-18s: mean %.2f us, max %.2f us for %u requests\n", "polling", CyclesToUs((double)polled.totalCycles / polled.requestCount),
+			CyclesToUs(polled.maxCycles), polled.requestCount);
+
+	P2PComms_InitNotifications();
+	uint32_t timeoutCount = MeasureResponseTime(NOTIFIED_REQUEST_COUNT, &notified);
+	printf("  %-18s: mean %.2f us, max %.2f us for %u requests, %u waits timed out\n", "notifications",
+			CyclesToUs((double)notified.totalCycles / notified.requestCount), CyclesToUs(notified.maxCycles), notified.requestCount, timeoutCount);
+
+	// each polled response is only seen after a tick
+	Check(polled.minCycles >= TICK_CYCLES, "polled response seen before the tick");
+	Check(notified.totalCycles < (uint64_t)notified.requestCount * TICK_CYCLES / 10, "notified response time not below the tick");
+	// a wait only times out if the host does not schedule the control thread within a tick
+	Check(timeoutCount <= NOTIFIED_REQUEST_COUNT / 100, "notifications lost");
+}
+
+/**
+ * @brief Updates a parameter from the communication core and reads it back after each update.
+ */
+static void Test_UpdateAcrossThreads(void)
+{
+	int id = FindParameter(DTYPE_FLOAT);
+	const volatile p2p_comms_stats_t* stats = &CORE_MSGS.stats;
+	printf("%d updates of %s processed by the control thread\n", UPDATE_COUNT, id < 0 ? "-" : p2pCommsParams[id].name);
+	Check(id >= 0, "no float parameter");
+	if (id < 0)
+		return;
+
+	P2PComms_ResetStats();
+	for (uint32_t n = 0; n < UPDATE_COUNT; n++)
+	{
+		data_union_t value = { .f = n * 0.5f }, readValue;
+		Check(P2PComms_UpdateValueById((p2p_params_type_t)id, value) == ERR_OK, "update failed");
+		if (P2PComms_GetValueById((p2p_params_type_t)id, &readValue) != ERR_OK || readValue.f != value.f)
+		{
+			Check(false, "update not read back");
+			break;
+		}
+	}
+	PrintStats(stats);
+	Check(stats->requestCount == UPDATE_COUNT && GetHistogramSum(stats) == UPDATE_COUNT, "requests not recorded");
+	Check(stats->maxPendingMsgs == 1 && IsQueueEmpty(), "messages left in the queue");
+}
+
+/**
+ * @brief Measures the round trip of single echo messages.
+ */
+static void Benchmark_Latency(void)
+{
+	const volatile p2p_comms_stats_t* stats = &CORE_MSGS.stats;
+	printf("Latency of %d echo messages\n", LATENCY_MSG_COUNT);
+	float msgsPerSec = P2PComms_RunBenchmark(LATENCY_MSG_COUNT, 1, 1);
+	PrintStats(stats);
+	printf("  throughput        : %.0f msgs/s\n", msgsPerSec);
+	Check(msgsPerSec > 0 && stats->benchmarkMsgs == LATENCY_MSG_COUNT && stats->requestCount == LATENCY_MSG_COUNT,
+			"benchmark not recorded");
+	Check(GetHistogramSum(stats) == LATENCY_MSG_COUNT && stats->minCycles <= stats->maxCycles, "latency histogram");
+}
+
+/**
+ * @brief Measures the throughput for each message size and batch size.
+ */
+static void Benchmark_Sweep(void)
+{
+	const volatile p2p_comms_stats_t* stats = &CORE_MSGS.stats;
+	printf("Throughput of %d messages in msgs/s, %d messages and %d command words in the buffers\n", SWEEP_MSG_COUNT,
+			P2P_COMMS_MSGS_SIZE, P2P_COMMS_CMD_BUFF_SIZE);
+	P2PComms_RunBenchmarkSweep(SWEEP_MSG_COUNT);
+	printf("  %-18s", "words \\ batch");
+	for (int j = 0; j < P2P_COMMS_SWEEP_COUNT; j++)
+		printf("%12u", sweepBatchSizes[j]);
+	printf("\n");
+	for (int i = 0; i < P2P_COMMS_SWEEP_COUNT; i++)
+	{
+		printf("  %-18u", sweepMsgSizes[i]);
+		for (int j = 0; j < P2P_COMMS_SWEEP_COUNT; j++)
+		{
+			printf("%12.0f", stats->sweepMsgsPerSec[i][j]);
+			Check(stats->sweepMsgsPerSec[i][j] > 0, "throughput not measured");
+		}
+		printf("\n");
+	}
+	// the last run places batches of 32 messages, so several are pending before the control core responds
+	Check(stats->maxPendingMsgs >= 2 && stats->maxPendingMsgs <= P2P_COMMS_MSGS_SIZE / 2, "batches not queued");
+	Check(IsQueueEmpty(), "messages left in the queue");
+}
+
+int main(void)
+{
+	pthread_t controlCore;
+	P2PComms_InitData();
+	isControlRunning = true;
+	pthread_create(&controlCore, NULL, RunControlCore, NULL);
+
+	Benchmark_ResponseWait();
+	Test_UpdateAcrossThreads();
+	Benchmark_Latency();
+	Benchmark_Sweep();
+
+	isControlRunning = false;
+	pthread_join(controlCore, NULL);
+	printf(failureCount ? "%d check(s) FAILED\n" : "All checks passed\n", failureCount);
+	return failureCount ? 1 : 0;
+}
+
+/* EOF */
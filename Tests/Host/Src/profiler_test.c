@@ -0,0 +1,258 @@
+/**
+ ********************************************************************************
+ * @file    	profiler_test.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Host test of the profiler statistics and of the consistent reads of the probes.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * PROFILER_GET_CYCLES() reads a synthetic clock set by the test, so that the execution times and the
+ * start jitter of each measurement are known. The statistics are checked against the expected histograms.
+ *
+ * The sequence lock is checked by a reader thread started while an update is left half done, which
+ * should only return after the update is completed, and by a writer thread recording measurements while
+ * the probe is copied with Profiler_ReadProbe() and with plain copies.
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include "shared_memory.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define PERIOD_CYCLES				(24000)
+#define START_JITTER				(300)
+/** Execution times of 2^0 to 2^(COST_BINS - 1) cycles are recorded in turns */
+#define COST_BINS					(12)
+#define RECORD_COUNT				(COST_BINS * 100)
+#define STRESS_DURATION_MS			(500)
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static shared_data_t hostSharedData;
+static volatile bool isWriterRunning;
+static volatile bool isReaderDone;
+static profiler_probe_t readerCopy;
+static int failureCount = 0;
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+volatile shared_data_t * const sharedData = &hostSharedData;
+uint32_t hostCycles;
+_Thread_local uint32_t hostPrimask;
+DWT_Type hostDWT;
+CoreDebug_Type hostCoreDebug;
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+static void Check(bool isPassed, const char* msg)
+{
+	if (isPassed)
+		return;
+	printf("  FAILED: %s\n", msg);
+	failureCount++;
+}
+
+/**
+ * @brief Measures a code section starting at the given time and taking the given cycles.
+ */
+static void Measure(profiler_probe_t* probe, uint32_t startCycles, uint32_t cycles)
+{
+	hostCycles = startCycles;
+	Profiler_Start(probe);
+	hostCycles += cycles;
+	Profiler_Stop(probe);
+}
+
+static uint32_t GetStartCycles(uint32_t n)
+{
+	// odd samples start late, so each period differs from the previous one by twice the jitter
+	return n * PERIOD_CYCLES + ((n & 1) ? START_JITTER : 0);
+}
+
+static uint32_t GetHistogramBin(uint32_t cycles)
+{
+	return 31 - __builtin_clz(cycles);
+}
+
+static uint32_t GetHistogramSum(const uint32_t* histogram)
+{
+	uint32_t sum = 0;
+	for (int i = 0; i < PROFILER_HISTOGRAM_BINS; i++)
+		sum += histogram[i];
+	return sum;
+}
+
+/**
+ * @brief Checks the registration of the probes.
+ */
+static void Test_Register(void)
+{
+	printf("Probe registration\n");
+	Profiler_Init();
+	Check((hostCoreDebug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) && (hostDWT.CTRL & DWT_CTRL_CYCCNTENA_Msk), "cycle counter not started");
+	for (int i = 0; i < PROFILER_MAX_PROBES; i++)
+		Check(Profiler_Register("probe") == &hostSharedData.profiler.probes[i], "probe not registered in order");
+	Check(Profiler_Register("extra") == NULL, "probe registered beyond the maximum");
+	profiler_probe_t copy;
+	Check(Profiler_ReadProbe(PROFILER_MAX_PROBES - 1, &copy) && copy.minCycles == UINT32_MAX && copy.count == 0, "new probe not cleared");
+	Check(!Profiler_ReadProbe(PROFILER_MAX_PROBES, &copy), "unregistered probe read");
+}
+
+/**
+ * @brief Checks the execution time and jitter statistics against the known measurements.
+ */
+static void Test_Statistics(void)
+{
+	printf("Statistics of %d measurements\n", RECORD_COUNT);
+	Profiler_Init();
+	profiler_probe_t* probe = Profiler_Register("control");
+	for (uint32_t n = 0; n < RECORD_COUNT; n++)
+		Measure(probe, GetStartCycles(n), 1U << (n % COST_BINS));
+
+	profiler_probe_t copy;
+	Check(Profiler_ReadProbe(0, &copy), "probe not read");
+	printf("  execution time    : min %u, max %u, mean %.1f cycles\n", copy.minCycles, copy.maxCycles, (double)copy.totalCycles / copy.count);
+	printf("  start jitter      : max %u cycles, last period %u cycles\n", copy.maxJitter, copy.lastPeriod);
+	Check((copy.sequence & 1) == 0, "probe left in update");
+	Check(copy.count == RECORD_COUNT && copy.minCycles == 1 && copy.maxCycles == (1U << (COST_BINS - 1)), "execution time limits");
+	Check(copy.totalCycles == (uint64_t)(RECORD_COUNT / COST_BINS) * ((1U << COST_BINS) - 1), "total execution time");
+	for (int i = 0; i < PROFILER_HISTOGRAM_BINS; i++)
+		Check(copy.histogram[i] == (i < COST_BINS ? RECORD_COUNT / COST_BINS : 0U), "execution time histogram");
+	// the jitter is only known from the third measurement
+	uint32_t jitterBin = GetHistogramBin(2 * START_JITTER);
+	Check(copy.maxJitter == 2 * START_JITTER && copy.lastPeriod == PERIOD_CYCLES + START_JITTER, "start jitter limits");
+	Check(copy.jitterHistogram[jitterBin] == RECORD_COUNT - 2 && GetHistogramSum(copy.jitterHistogram) == RECORD_COUNT - 2,
+			"start jitter histogram");
+
+	// longer executions and jitters are counted in the last bins
+	Measure(probe, GetStartCycles(RECORD_COUNT) + (1U << 20), 1U << 20);
+	Check(Profiler_ReadProbe(0, &copy), "probe not read");
+	Check(copy.histogram[PROFILER_HISTOGRAM_BINS - 1] == 1 && copy.jitterHistogram[PROFILER_HISTOGRAM_BINS - 1] == 1,
+			"outliers not counted in the last bins");
+
+	Profiler_ResetProbe(probe);
+	Check(Profiler_ReadProbe(0, &copy), "probe not read");
+	Check(copy.count == 0 && copy.maxCycles == 0 && copy.maxJitter == 0 && GetHistogramSum(copy.histogram) == 0 &&
+			GetHistogramSum(copy.jitterHistogram) == 0 && copy.name != NULL, "probe not reset");
+}
+
+/**
+ * @brief Checks that a copy of the probe belongs to a single state of the measurements.
+ */
+static bool IsConsistent(const profiler_probe_t* copy)
+{
+	uint32_t jitterCount = copy->count > 2 ? copy->count - 2 : 0;
+	return GetHistogramSum(copy->histogram) == copy->count && GetHistogramSum(copy->jitterHistogram) == jitterCount &&
+			copy->totalCycles == (uint64_t)copy->count * 100 && (copy->count == 0 || copy->minCycles <= copy->maxCycles);
+}
+
+static void* RunReader(void* arg)
+{
+	Check(Profiler_ReadProbe(0, &readerCopy), "probe not read");
+	isReaderDone = true;
+	return NULL;
+}
+
+/**
+ * @brief Starts a reader while the probe is being updated.
+ */
+static void Test_ReadDuringUpdate(void)
+{
+	pthread_t reader;
+	printf("Read during an update\n");
+	Profiler_Init();
+	profiler_probe_t* probe = Profiler_Register("update");
+	for (uint32_t n = 0; n < 10; n++)
+		Measure(probe, GetStartCycles(n), 100);
+
+	// the update of the writer is interrupted after the count
+	probe->sequence++;
+	probe->count++;
+	isReaderDone = false;
+	pthread_create(&reader, NULL, RunReader, NULL);
+	usleep(20000);
+	Check(!isReaderDone, "probe read during an update");
+
+	probe->histogram[GetHistogramBin(100)]++;
+	probe->jitterHistogram[0]++;
+	probe->totalCycles += 100;
+	probe->sequence++;
+	pthread_join(reader, NULL);
+	Check(isReaderDone && readerCopy.count == 11 && IsConsistent(&readerCopy), "probe not read after the update");
+}
+
+static void* RunWriter(void* arg)
+{
+	profiler_probe_t* probe = (profiler_probe_t*)arg;
+	for (uint32_t n = 0; isWriterRunning; n++)
+		Measure(probe, GetStartCycles(n), 100);
+	return NULL;
+}
+
+/**
+ * @brief Reads the probe while it is being updated by another thread.
+ */
+static void Test_SequenceLock(void)
+{
+	pthread_t writer;
+	struct timespec start, now;
+	uint32_t readCount = 0, lockedTornCount = 0, plainTornCount = 0;
+	profiler_probe_t copy;
+
+	printf("Sequence lock with a concurrent writer for %d ms\n", STRESS_DURATION_MS);
+	Profiler_Init();
+	profiler_probe_t* probe = Profiler_Register("stress");
+	isWriterRunning = true;
+	pthread_create(&writer, NULL, RunWriter, probe);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	do
+	{
+		Check(Profiler_ReadProbe(0, &copy), "probe not read");
+		if (!IsConsistent(&copy))
+			lockedTornCount++;
+		memcpy(&copy, (void*)&hostSharedData.profiler.probes[0], sizeof(profiler_probe_t));
+		if (!IsConsistent(&copy))
+			plainTornCount++;
+		readCount++;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+	} while ((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000 < STRESS_DURATION_MS);
+	isWriterRunning = false;
+	pthread_join(writer, NULL);
+
+	Check(Profiler_ReadProbe(0, &copy), "probe not read");
+	printf("  reads             : %u while %u measurements were recorded\n", readCount, copy.count);
+	printf("  inconsistent      : %u with Profiler_ReadProbe(), %u with plain copies\n", lockedTornCount, plainTornCount);
+	Check(lockedTornCount == 0, "inconsistent copy read by Profiler_ReadProbe()");
+	Check(IsConsistent(&copy) && copy.count > 0, "final statistics");
+}
+
+int main(void)
+{
+	Test_Register();
+	Test_Statistics();
+	Test_ReadDuringUpdate();
+	Test_SequenceLock();
+	printf(failureCount ? "%d check(s) FAILED\n" : "All checks passed\n", failureCount);
+	return failureCount ? 1 : 0;
+}
+
+/* EOF */
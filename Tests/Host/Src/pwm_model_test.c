@@ -0,0 +1,566 @@
+/**
+ ********************************************************************************
+ * @file    	pwm_model_test.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Host tests of the PWM drivers using the HRTIM and TIM1 register model.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * The unmodified pecontroller_pwm.c, which includes pecontroller_pwm1_10.c and pecontroller_pwm11_16.c,
+ * and pecontroller_timers.c are built with the STM32H7 HAL against the register model. The inverted pairs
+ * of the HRTIM with an odd and an even reference channel and of TIM1 are configured with dead time. The
+ * period, the duty cycle and the dead times are measured from the edges of the pins, the reset interrupts
+ * are counted, the compares of multiple pairs are checked to take effect at the same period boundary and
+ * the outputs are checked after a forced disable. The waveforms are exported to
+ * build/pwm_model.vcd. The phase shifts of three legs interleaved with the master HRTIM are measured before
+ * and after a frequency change. The spread spectrum mode is checked to follow the period sequence, to preserve
+ * the duty cycle and to lower the peak of the spectrum at the switching frequency. Finally the compares of the duty handles are compared with the regular update
+ * and the time taken by both is measured.
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include "pecontroller_pwm.h"
+#include "hrtim_model.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define PWM_FREQUENCY_Hz			(25000)
+#define DEAD_TIME_ns				(1000)
+#define PERIOD_TICKS				(HRTIM_MODEL_CLOCK_Hz / PWM_FREQUENCY_Hz)
+#define DEAD_TICKS					(DEAD_TIME_ns * (HRTIM_MODEL_CLOCK_Hz / 1000000) / 1000)
+#define MEASURED_PERIODS			(10)
+#define VCD_PATH					"build/pwm_model.vcd"
+#define INTERLEAVED_FREQUENCY_Hz	(20000)
+#define SPREAD_LENGTH				(64)
+#define SPREAD_DEVIATION			(0.1f)
+#define SPREAD_PERIODS				(4 * SPREAD_LENGTH)
+#define SPREAD_MIN_ATTENUATION_dB	(6)
+#define DUTY_SWEEP_STEPS			(2000)
+#define DUTY_BENCHMARK_COUNT		(2000000)
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static pwm_module_config_t moduleConfig;
+static pwm_config_t pwmConfig;
+static tim_in_trigger_config_t slaveOpts = { .src = TIM_TRG_SRC_NONE, .type = TIM_TRGI_TYPE_NONE };
+static int failureCount = 0;
+static int hrtimCallbackCount = 0;
+static int tim1CallbackCount = 0;
+static pwm1_10_duty_handle_t pairsHandle;
+static uint16_t spreadPeriods[SPREAD_LENGTH];
+static pwm1_10_duty_handle_t spreadHandle;
+static pwm1_10_duty_handle_t* spreadHandles[1] = { &spreadHandle };
+static pwm1_10_spread_spectrum_t spreadState = { .handles = spreadHandles, .handleCount = 1, .periods = spreadPeriods,
+		.length = SPREAD_LENGTH };
+static hrtim_opts_t masterOpts = { .syncSrc = TIM_TRG_SRC_NONE, .syncType = TIM_TRGI_TYPE_NONE, .f = PWM_FREQUENCY_Hz };
+static pwm1_10_interleave_config_t interleaveConfig = { .pwmNos = { 5, 7, 9 }, .legCount = 3, .isEvenlySpaced = true,
+		.masterOpts = &masterOpts };
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+static void Check(bool isPassed, const char* msg)
+{
+	if (isPassed)
+		return;
+	printf("  FAILED: %s\n", msg);
+	failureCount++;
+}
+
+static void HrtimCallback(void)
+{
+	hrtimCallbackCount++;
+}
+
+static void Tim1Callback(void)
+{
+	tim1CallbackCount++;
+}
+
+/**
+ * @brief Measures the overlap of two pins in the recorded timeline.
+ * @return uint64_t Number of ticks during which both pins are high
+ */
+static uint64_t GetOverlapTicks(uint32_t pwmNo1, uint32_t pwmNo2, uint64_t from, uint64_t to)
+{
+	int count;
+	const hrtim_model_edge_t* edges = HrtimModel_GetEdges(&count);
+	uint8_t levels[HRTIM_MODEL_PWM_COUNT + 1] = {0};
+	uint64_t overlap = 0, lastTime = from;
+	for (int i = 0; i < count && edges[i].time <= to; i++)
+	{
+		if (edges[i].time > from)
+		{
+			uint64_t start = lastTime > from ? lastTime : from;
+			if (levels[pwmNo1] == 1 && levels[pwmNo2] == 1)
+				overlap += edges[i].time - start;
+			lastTime = edges[i].time;
+		}
+		levels[edges[i].pwmNo] = edges[i].level;
+	}
+	if (levels[pwmNo1] == 1 && levels[pwmNo2] == 1)
+		overlap += to - (lastTime > from ? lastTime : from);
+	return overlap;
+}
+
+/**
+ * @brief Measures each period of a pair and compares it with the expected waveform.
+ * @param name Name of the pair in the report
+ * @param refPin Reference channel of the pair
+ * @param compPin Complementary channel of the pair
+ * @param duty Expected duty cycle of the reference channel
+ */
+static void CheckPair(const char* name, uint32_t refPin, uint32_t compPin, float duty)
+{
+	uint64_t start = HrtimModel_GetTime() - (uint64_t)MEASURED_PERIODS * PERIOD_TICKS;
+	uint64_t rise = HrtimModel_FindEdge(refPin, 1, start);
+	uint64_t minPeriod = UINT64_MAX, maxPeriod = 0, minHigh = UINT64_MAX, maxHigh = 0;
+	uint64_t minDead = UINT64_MAX, maxDead = 0;
+	int periods = 0;
+	while (true)
+	{
+		uint64_t fall = HrtimModel_FindEdge(refPin, 0, rise);
+		uint64_t nextRise = HrtimModel_FindEdge(refPin, 1, fall);
+		if (nextRise == UINT64_MAX)
+			break;
+		uint64_t compRise = HrtimModel_FindEdge(compPin, 1, fall);
+		uint64_t compFall = HrtimModel_FindEdge(compPin, 0, compRise);
+		uint64_t period = nextRise - rise, high = fall - rise;
+		uint64_t deadFall = compRise - fall, deadRise = nextRise - compFall;
+		minPeriod = period < minPeriod ? period : minPeriod;
+		maxPeriod = period > maxPeriod ? period : maxPeriod;
+		minHigh = high < minHigh ? high : minHigh;
+		maxHigh = high > maxHigh ? high : maxHigh;
+		minDead = deadFall < minDead ? deadFall : minDead;
+		minDead = deadRise < minDead ? deadRise : minDead;
+		maxDead = deadFall > maxDead ? deadFall : maxDead;
+		maxDead = deadRise > maxDead ? deadRise : maxDead;
+		rise = nextRise;
+		periods++;
+	}
+	uint64_t overlap = GetOverlapTicks(refPin, compPin, start, HrtimModel_GetTime());
+	printf("  %-18s: %d periods, period %llu-%llu ticks, duty %.4f-%.4f, dead time %llu-%llu ticks, overlap %llu ticks\n",
+			name, periods, (unsigned long long)minPeriod, (unsigned long long)maxPeriod,
+			(double)minHigh / PERIOD_TICKS, (double)maxHigh / PERIOD_TICKS,
+			(unsigned long long)minDead, (unsigned long long)maxDead, (unsigned long long)overlap);
+	Check(periods >= MEASURED_PERIODS - 2, "missing periods");
+	Check(minPeriod == PERIOD_TICKS && maxPeriod == PERIOD_TICKS, "wrong period");
+	Check(minHigh == maxHigh && (double)minHigh / PERIOD_TICKS > duty - 1e-3 && (double)minHigh / PERIOD_TICKS < duty + 1e-3,
+			"wrong duty cycle");
+	Check(minDead == DEAD_TICKS && maxDead == DEAD_TICKS, "wrong dead time");
+	Check(overlap == 0, "both channels of the pair are high");
+}
+
+/**
+ * @brief Configures the inverted pairs at PWM1-2 (odd reference), PWM4-3 (even reference) and PWM11-12.
+ */
+static void ConfigurePairs(void)
+{
+	HrtimModel_Init();
+	BSP_PWM_GetDafaultModuleConfig(&moduleConfig);
+	moduleConfig.f = PWM_FREQUENCY_Hz;
+	moduleConfig.deadtime.on = true;
+	moduleConfig.deadtime.nanoSec = DEAD_TIME_ns;
+	BSP_PWM_GetDefaultConfig(&pwmConfig, &moduleConfig);
+	pwmConfig.slaveOpts = &slaveOpts;
+	BSP_PWM_ConfigInvertedPair(1, &pwmConfig);
+	BSP_PWM_ConfigInvertedPair(4, &pwmConfig);
+	BSP_PWM_ConfigInvertedPair(11, &pwmConfig);
+	Check(HostBsp_GetErrorCount() == 0, "drivers reported errors during the configuration");
+}
+
+/**
+ * @brief Checks the waveforms of the pairs and exports them.
+ */
+static void Test_Waveforms(void)
+{
+	printf("Waveforms at %d Hz with %d ns dead time\n", PWM_FREQUENCY_Hz, DEAD_TIME_ns);
+	BSP_PWM_UpdatePairDuty(1, 0.25f, &pwmConfig);
+	BSP_PWM_UpdatePairDuty(4, 0.6f, &pwmConfig);
+	BSP_PWM_UpdatePairDuty(11, 0.25f, &pwmConfig);
+	BSP_PWMOut_Enable(0xC0F, true);
+	BSP_PWM_Start(0xC0F, false);
+	// the first period runs with the values active before the start
+	HrtimModel_Run(3 * PERIOD_TICKS);
+	HrtimModel_ClearTimeline();
+	HrtimModel_Run((uint64_t)MEASURED_PERIODS * PERIOD_TICKS);
+
+	CheckPair("HRTIM PWM1-2", 1, 2, 0.25f);
+	CheckPair("HRTIM PWM4-3", 4, 3, 0.6f);
+	CheckPair("TIM1 PWM11-12", 11, 12, 0.25f);
+	int edgeCount;
+	(void)HrtimModel_GetEdges(&edgeCount);
+	Check(HrtimModel_WriteVcd(VCD_PATH), "VCD export failed");
+	printf("  timeline          : %d edges written to %s\n", edgeCount, VCD_PATH);
+}
+
+/**
+ * @brief Counts the reset interrupts of the HRTIM and the update interrupts of TIM1.
+ */
+static void Test_Interrupts(void)
+{
+	printf("Reset interrupts\n");
+	BSP_PWM_Config_Interrupt(1, true, HrtimCallback, 0);
+	BSP_PWM_Config_Interrupt(11, true, Tim1Callback, 0);
+	HrtimModel_Run((uint64_t)MEASURED_PERIODS * PERIOD_TICKS);
+	printf("  callbacks         : HRTIM %d, TIM1 %d in %d periods\n", hrtimCallbackCount, tim1CallbackCount, MEASURED_PERIODS);
+	Check(hrtimCallbackCount == MEASURED_PERIODS, "wrong number of HRTIM reset interrupts");
+	Check(tim1CallbackCount == MEASURED_PERIODS, "wrong number of TIM1 update interrupts");
+	BSP_PWM_Config_Interrupt(1, false, NULL, 0);
+	BSP_PWM_Config_Interrupt(11, false, NULL, 0);
+}
+
+/**
+ * @brief Gets the first transfer of a unit in the recorded timeline.
+ * @return const hrtim_model_update_t* Transfer or NULL if the unit is not updated
+ */
+static const hrtim_model_update_t* GetFirstUpdate(uint8_t unit)
+{
+	int count;
+	const hrtim_model_update_t* updates = HrtimModel_GetUpdates(&count);
+	for (int i = 0; i < count; i++)
+		if (updates[i].unit == unit)
+			return &updates[i];
+	return NULL;
+}
+
+/**
+ * @brief Checks that the compares written by @ref BSP_PWM_UpdatePairDuties() are transferred at the same period
+ * boundary for the HRTIM timers and TIM1, even if a boundary passes while the first pair is written.
+ */
+static void Test_SamePeriodUpdate(void)
+{
+	static const float duties[3] = { 0.4f, 0.3f, 0.7f };
+	static const uint8_t units[3] = { HRTIM_TIMERINDEX_TIMER_A, HRTIM_TIMERINDEX_TIMER_B, HRTIM_MODEL_UNIT_TIM1 };
+	printf("Same period update\n");
+	BSP_PWM1_10_CreateDutyHandle(1, &pwmConfig, true, &pairsHandle);
+	HrtimModel_Run(PERIOD_TICKS / 2);
+	HrtimModel_ClearTimeline();
+	// a period boundary passes after the first pair is written
+	BSP_PWM_HoldUpdates(0x409, false);
+	BSP_PWM_UpdatePairDuty(1, duties[0], &pwmConfig);
+	HrtimModel_Run(PERIOD_TICKS);
+	int heldCount;
+	(void)HrtimModel_GetUpdates(&heldCount);
+	BSP_PWM_UpdatePairDuties(0x409, duties, &pairsHandle, &pwmConfig);
+	HrtimModel_Run(PERIOD_TICKS);
+
+	const hrtim_model_update_t* first[3];
+	for (int i = 0; i < 3; i++)
+		first[i] = GetFirstUpdate(units[i]);
+	Check(heldCount == 0, "registers transferred while the updates are held");
+	Check(first[0] && first[1] && first[2], "registers not transferred after the release");
+	if (!(first[0] && first[1] && first[2]))
+		return;
+	printf("  first transfer    : TIMA %llu, TIMB %llu, TIM1 %llu ticks, held transfers %d\n",
+			(unsigned long long)first[0]->time, (unsigned long long)first[1]->time, (unsigned long long)first[2]->time, heldCount);
+	Check(first[0]->time == first[1]->time && first[0]->time == first[2]->time, "compares not transferred at the same boundary");
+	Check(first[0]->compares[0] == HRTIM1->sTimerxRegs[0].CMP1xR && first[0]->compares[1] == HRTIM1->sTimerxRegs[0].CMP2xR &&
+			first[1]->compares[0] == HRTIM1->sTimerxRegs[1].CMP1xR && first[1]->compares[1] == HRTIM1->sTimerxRegs[1].CMP2xR &&
+			first[2]->compares[0] == TIM1->CCR1, "new compares not in the first transfer");
+
+	HrtimModel_Run((uint64_t)MEASURED_PERIODS * PERIOD_TICKS);
+	CheckPair("HRTIM PWM1-2", 1, 2, duties[0]);
+	CheckPair("HRTIM PWM4-3", 4, 3, duties[1]);
+	CheckPair("TIM1 PWM11-12", 11, 12, duties[2]);
+}
+
+/**
+ * @brief Disables the outputs as done by the protection and checks that no further edges are generated.
+ */
+static void Test_ForceDisable(void)
+{
+	printf("Forced disable\n");
+	BSP_PWMOut_ForceDisable(0xC0F);
+	// the disable is applied at the start of the run
+	HrtimModel_Run(1);
+	HrtimModel_ClearTimeline();
+	HrtimModel_Run(2 * PERIOD_TICKS);
+	int edgeCount;
+	(void)HrtimModel_GetEdges(&edgeCount);
+	printf("  levels            : PWM1 %d, PWM2 %d, PWM3 %d, PWM4 %d, PWM11 %d, PWM12 %d, edges %d\n",
+			HrtimModel_GetOutput(1), HrtimModel_GetOutput(2), HrtimModel_GetOutput(3), HrtimModel_GetOutput(4),
+			HrtimModel_GetOutput(11), HrtimModel_GetOutput(12), edgeCount);
+	Check(edgeCount == 0, "outputs still switching after the forced disable");
+	// idle outputs are at the inactive level, which is high for the negative polarity of the even reference
+	Check(HrtimModel_GetOutput(1) == 0 && HrtimModel_GetOutput(2) == 0, "PWM1-2 not inactive");
+	Check(HrtimModel_GetOutput(3) == 1 && HrtimModel_GetOutput(4) == 1, "PWM3-4 not inactive");
+	Check(HrtimModel_GetOutput(11) == HRTIM_MODEL_LEVEL_Z && HrtimModel_GetOutput(12) == HRTIM_MODEL_LEVEL_Z,
+			"PWM11-12 still driven");
+}
+
+/**
+ * @brief Measures the period and the phase shift of each interleaved leg from the rising edges of the
+ * reference channels in the recorded timeline.
+ * @param periodTicks Expected period in ticks
+ */
+static void CheckInterleaving(uint32_t periodTicks)
+{
+	const uint16_t* pwmNos = interleaveConfig.pwmNos;
+	uint64_t refRise = HrtimModel_FindEdge(pwmNos[0], 1, 0);
+	for (int i = 0; i < interleaveConfig.legCount; i++)
+	{
+		uint64_t rise = HrtimModel_FindEdge(pwmNos[i], 1, refRise);
+		uint64_t nextRise = HrtimModel_FindEdge(pwmNos[i], 1, rise + 1);
+		if (nextRise == UINT64_MAX)
+		{
+			Check(false, "interleaved leg not switching");
+			continue;
+		}
+		double expected = interleaveConfig.shifts[i] * periodTicks;
+		double error = (double)(rise - refRise) - expected;
+		printf("  PWM%-2d             : period %llu ticks, shift %llu ticks (%.4f), error %.0f ticks\n", pwmNos[i],
+				(unsigned long long)(nextRise - rise), (unsigned long long)(rise - refRise),
+				(double)(rise - refRise) / periodTicks, error);
+		Check(nextRise - rise == periodTicks, "wrong period of the interleaved leg");
+		// the compare value of the master is truncated from (period - 1) * shift
+		Check(error > -2 && error <= 0, "wrong phase shift of the interleaved leg");
+	}
+}
+
+/**
+ * @brief Interleaves the pairs at PWM5-6, PWM7-8 and PWM9-10 with the master HRTIM and checks the phase shifts,
+ * also after changing the frequency with @ref BSP_PWM1_10_SetInterleavedFrequency().
+ */
+static void Test_Interleaving(void)
+{
+	printf("Interleaving at %d Hz\n", PWM_FREQUENCY_Hz);
+	BSP_MasterHRTIM_Config(&masterOpts);
+	for (int i = 0; i < interleaveConfig.legCount; i++)
+		BSP_PWM_ConfigInvertedPair(interleaveConfig.pwmNos[i], &pwmConfig);
+	Check(BSP_PWM1_10_ConfigInterleaving(&interleaveConfig), "interleaving configuration rejected");
+	for (int i = 0; i < interleaveConfig.legCount; i++)
+		BSP_PWM_UpdatePairDuty(interleaveConfig.pwmNos[i], 0.5f, &pwmConfig);
+	BSP_PWMOut_Enable(0x3F0, true);
+	BSP_PWM_Start(0x3F0, true);
+	HrtimModel_Run(3 * PERIOD_TICKS);
+	HrtimModel_ClearTimeline();
+	HrtimModel_Run(3 * PERIOD_TICKS);
+	CheckInterleaving(PERIOD_TICKS);
+
+	uint32_t newPeriodTicks = HRTIM_MODEL_CLOCK_Hz / INTERLEAVED_FREQUENCY_Hz;
+	printf("Interleaving after the change to %d Hz\n", INTERLEAVED_FREQUENCY_Hz);
+	BSP_PWM1_10_SetInterleavedFrequency(&interleaveConfig, INTERLEAVED_FREQUENCY_Hz);
+	for (int i = 0; i < interleaveConfig.legCount; i++)
+		BSP_PWM_UpdatePairDuty(interleaveConfig.pwmNos[i], 0.5f, &pwmConfig);
+	// the legs settle within one master period
+	HrtimModel_Run(2 * newPeriodTicks);
+	HrtimModel_ClearTimeline();
+	HrtimModel_Run(3 * newPeriodTicks);
+	CheckInterleaving(newPeriodTicks);
+	Check(HostBsp_GetErrorCount() == 0, "drivers reported errors during the interleaving");
+}
+
+static void SpreadSpectrumCallback(void)
+{
+	BSP_PWM1_10_SpreadSpectrumStep(&spreadState);
+}
+
+/**
+ * @brief Gets the peak amplitude of the spectrum of a pin near the switching frequency.
+ * @details The Fourier integral of each high interval is evaluated analytically over the recorded timeline,
+ * with the resolution of the recorded duration.
+ * @return double Peak amplitude relative to a square wave of amplitude 1
+ */
+static double GetSpectrumPeak(uint32_t pwmNo, uint64_t from, uint64_t to)
+{
+	int count;
+	const hrtim_model_edge_t* edges = HrtimModel_GetEdges(&count);
+	double duration = (double)(to - from) / HRTIM_MODEL_CLOCK_Hz;
+	double peak = 0;
+	int binCount = (int)(PWM_FREQUENCY_Hz * 0.3 * duration * 2);
+	for (int bin = -binCount; bin <= binCount; bin++)
+	{
+		// half bins around the switching frequency
+		double w = 2 * M_PI * (PWM_FREQUENCY_Hz + bin * 0.5 / duration), re = 0, im = 0, riseTime = -1;
+		for (int i = 0; i < count; i++)
+		{
+			if (edges[i].pwmNo != pwmNo || edges[i].time < from || edges[i].time > to)
+				continue;
+			double t = (double)(edges[i].time - from) / HRTIM_MODEL_CLOCK_Hz;
+			if (edges[i].level == 1)
+				riseTime = t;
+			else if (riseTime >= 0)
+			{
+				// integral of exp(-jwt) over the high interval
+				re += (sin(w * t) - sin(w * riseTime)) / w;
+				im += (cos(w * t) - cos(w * riseTime)) / w;
+				riseTime = -1;
+			}
+		}
+		double amplitude = 2 * sqrt(re * re + im * im) / duration;
+		peak = amplitude > peak ? amplitude : peak;
+	}
+	return peak;
+}
+
+/**
+ * @brief Checks the periods and the duty cycle of PWM1-2 in the spread spectrum mode.
+ * @param duty Expected duty cycle
+ * @param from Start of the checked timeline
+ */
+static void CheckSpreadPeriods(float duty, uint64_t from)
+{
+	int updateCount, periods = 0, sequenceErrors = 0, dutyErrors = 0;
+	const hrtim_model_update_t* updates = HrtimModel_GetUpdates(&updateCount);
+	const hrtim_model_update_t* last = NULL;
+	int index = -1;
+	double maxDutyError = 0;
+	for (int i = 0; i < updateCount; i++)
+	{
+		if (updates[i].unit != HRTIM_TIMERINDEX_TIMER_A || updates[i].time < from)
+			continue;
+		if (last)
+		{
+			// each period follows the previous one in the sequence
+			if (index < 0)
+			{
+				index = 0;
+				while (index < SPREAD_LENGTH && (spreadPeriods[index] != last->period ||
+						spreadPeriods[(index + 1) % SPREAD_LENGTH] != updates[i].period))
+					index++;
+			}
+			index = (index + 1) % SPREAD_LENGTH;
+			uint64_t length = updates[i].time - last->time;
+			if (length != last->period || updates[i].period != spreadPeriods[index])
+				sequenceErrors++;
+			uint64_t rise = HrtimModel_FindEdge(1, 1, last->time);
+			uint64_t fall = HrtimModel_FindEdge(1, 0, rise);
+			double dutyError = fabs((double)(fall - rise) / length - duty);
+			maxDutyError = dutyError > maxDutyError ? dutyError : maxDutyError;
+			// the on time is truncated to ticks
+			if (fall > updates[i].time || dutyError > 1.0 / length)
+				dutyErrors++;
+			periods++;
+		}
+		last = &updates[i];
+	}
+	printf("  duty %.2f         : %d periods, %d sequence errors, maximum duty error %.5f\n",
+			duty, periods, sequenceErrors, maxDutyError);
+	Check(periods >= SPREAD_PERIODS - 2, "missing spread spectrum periods");
+	Check(sequenceErrors == 0, "periods do not follow the spread spectrum sequence");
+	Check(dutyErrors == 0, "duty cycle not preserved in the spread spectrum mode");
+}
+
+/**
+ * @brief Dithers the period of PWM1-2 using a triangular sequence and compares the spectrum with the fixed frequency.
+ */
+static void Test_SpreadSpectrum(void)
+{
+	printf("Spread spectrum with +/- %.0f%% triangular profile\n", SPREAD_DEVIATION * 100);
+	BSP_PWM1_10_CreateDutyHandle(1, &pwmConfig, true, &spreadHandle);
+	BSP_PWM1_10_UpdateDutyFast(&spreadHandle, 0.3f);
+	BSP_PWMOut_Enable(0x3, true);
+	HrtimModel_Run(2 * PERIOD_TICKS);
+	HrtimModel_ClearTimeline();
+	uint64_t start = HrtimModel_GetTime();
+	HrtimModel_Run((uint64_t)SPREAD_PERIODS * PERIOD_TICKS);
+	double fixedPeak = GetSpectrumPeak(1, start, HrtimModel_GetTime());
+
+	BSP_PWM1_10_GenerateSpreadSequence(PERIOD_TICKS, SPREAD_DEVIATION, SPREAD_TRIANGULAR, spreadPeriods, SPREAD_LENGTH);
+	BSP_PWM_Config_Interrupt(1, true, SpreadSpectrumCallback, 0);
+	HrtimModel_Run(2 * PERIOD_TICKS);
+	HrtimModel_ClearTimeline();
+	start = HrtimModel_GetTime();
+	HrtimModel_Run((uint64_t)SPREAD_PERIODS * PERIOD_TICKS);
+	CheckSpreadPeriods(0.3f, start);
+	double spreadPeak = GetSpectrumPeak(1, start, HrtimModel_GetTime());
+	double attenuation = 20 * log10(fixedPeak / spreadPeak);
+	printf("  spectrum peak     : fixed %.4f, spread %.4f, attenuation %.1f dB\n", fixedPeak, spreadPeak, attenuation);
+	Check(attenuation >= SPREAD_MIN_ATTENUATION_dB, "spectrum peak not lowered by the spread spectrum mode");
+
+	// duty cycle updated while the period changes
+	BSP_PWM1_10_UpdateDutyFast(&spreadHandle, 0.6f);
+	HrtimModel_Run(2 * PERIOD_TICKS);
+	HrtimModel_ClearTimeline();
+	start = HrtimModel_GetTime();
+	HrtimModel_Run((uint64_t)SPREAD_PERIODS * PERIOD_TICKS);
+	CheckSpreadPeriods(0.6f, start);
+	BSP_PWM_Config_Interrupt(1, false, NULL, 0);
+}
+
+static double GetTimeNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief Checks that the duty handle writes the same compares as @ref BSP_PWM_UpdatePairDuty() over a duty sweep,
+ * including the values outside the limits.
+ */
+static void Test_DutyHandle(void)
+{
+	pwm1_10_duty_handle_t handle;
+	int mismatches = 0;
+	printf("Duty handle\n");
+	BSP_PWM1_10_CreateDutyHandle(1, &pwmConfig, true, &handle);
+	for (int i = -DUTY_SWEEP_STEPS / 10; i <= DUTY_SWEEP_STEPS + DUTY_SWEEP_STEPS / 10; i++)
+	{
+		float duty = (float)i / DUTY_SWEEP_STEPS;
+		float applied = BSP_PWM_UpdatePairDuty(1, duty, &pwmConfig);
+		uint32_t cmp1 = HRTIM1->sTimerxRegs[0].CMP1xR, cmp2 = HRTIM1->sTimerxRegs[0].CMP2xR;
+		float appliedFast = BSP_PWM1_10_UpdateDutyFast(&handle, duty);
+		if (applied != appliedFast || cmp1 != HRTIM1->sTimerxRegs[0].CMP1xR || cmp2 != HRTIM1->sTimerxRegs[0].CMP2xR)
+			mismatches++;
+	}
+	printf("  compares          : %d duty cycles, %d mismatches\n", DUTY_SWEEP_STEPS + DUTY_SWEEP_STEPS / 5 + 1, mismatches);
+	Check(mismatches == 0, "duty handle writes different compares");
+}
+
+/**
+ * @brief Compares the time taken by the duty handle with the regular update of an inverted pair.
+ */
+static void Benchmark_DutyUpdate(void)
+{
+	pwm1_10_duty_handle_t handle;
+	volatile float sum = 0;
+	BSP_PWM1_10_CreateDutyHandle(1, &pwmConfig, true, &handle);
+
+	double startTime = GetTimeNs();
+	for (int i = 0; i < DUTY_BENCHMARK_COUNT; i++)
+		sum += BSP_PWM_UpdatePairDuty(1, (i & 1023) / 1024.f, &pwmConfig);
+	double regularNs = (GetTimeNs() - startTime) / DUTY_BENCHMARK_COUNT;
+
+	startTime = GetTimeNs();
+	for (int i = 0; i < DUTY_BENCHMARK_COUNT; i++)
+		sum += BSP_PWM1_10_UpdateDutyFast(&handle, (i & 1023) / 1024.f);
+	double fastNs = (GetTimeNs() - startTime) / DUTY_BENCHMARK_COUNT;
+	(void)sum;
+	printf("  benchmark         : %.1f ns per update, BSP_PWM_UpdatePairDuty %.1f ns (host)\n", fastNs, regularNs);
+}
+
+int main(void)
+{
+	ConfigurePairs();
+	Test_Waveforms();
+	Test_Interrupts();
+	Test_SamePeriodUpdate();
+	Test_ForceDisable();
+	Test_Interleaving();
+	Test_SpreadSpectrum();
+	Test_DutyHandle();
+	Benchmark_DutyUpdate();
+	printf(failureCount ? "%d check(s) FAILED\n" : "All checks passed\n", failureCount);
+	return failureCount ? 1 : 0;
+}
+
+/* EOF */
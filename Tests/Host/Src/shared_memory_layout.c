@@ -0,0 +1,83 @@
+/**
+ ********************************************************************************
+ * @file 		shared_memory_layout.c
+ * @author 		agent
+ * @date 		October 19, 2026
+ *
+ * @brief	Layout of the shared memory as compiled for a core.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * Compiled once for each core, with LAYOUT_NAME set to the name of the exported layout.
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include "shared_memory.h"
+#include "shared_memory_layout.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define FIELD(member, writer)		{ #member, offsetof(shared_data_t, member), sizeof(((shared_data_t*)0)->member), writer }
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+/**
+ * @brief Fields of the shared memory with the core writing them.
+ */
+static const layout_field_t fields[] =
+{
+		FIELD(isStateStorageInitialized, LAYOUT_WRITER_REGION),
+		FIELD(rawAdcData, LAYOUT_WRITER_REGION),
+		FIELD(processedAdcData, LAYOUT_WRITER_REGION),
+		FIELD(p2pMsgs, LAYOUT_WRITER_REGION),
+		FIELD(p2pMsgs.dataBuffs, LAYOUT_WRITER_BOTH),
+		FIELD(p2pMsgs.msgsRingBuff.wrIndex, LAYOUT_WRITER_COMMS),
+		FIELD(p2pMsgs.msgsRingBuff.rdIndex, LAYOUT_WRITER_CONTROL),
+		FIELD(p2pMsgs.msgsRingBuff.modulo, LAYOUT_WRITER_CONTROL),
+		FIELD(p2pMsgs.cmdsRingBuff.wrIndex, LAYOUT_WRITER_COMMS),
+		FIELD(p2pMsgs.cmdsRingBuff.rdIndex, LAYOUT_WRITER_CONTROL),
+		FIELD(p2pMsgs.cmdsRingBuff.modulo, LAYOUT_WRITER_CONTROL),
+		FIELD(p2pMsgs.responseRingBuff.wrIndex, LAYOUT_WRITER_CONTROL),
+		FIELD(p2pMsgs.responseRingBuff.rdIndex, LAYOUT_WRITER_CONTROL),
+		FIELD(p2pMsgs.responseRingBuff.modulo, LAYOUT_WRITER_CONTROL),
+		FIELD(p2pMsgs.msgs, LAYOUT_WRITER_BOTH),
+		FIELD(p2pMsgs.cmds, LAYOUT_WRITER_COMMS),
+		FIELD(p2pMsgs.response, LAYOUT_WRITER_CONTROL),
+#if P2P_COMMS_ENABLE_BENCHMARK
+		FIELD(p2pMsgs.stats, LAYOUT_WRITER_COMMS),
+#endif
+#if PROFILER_ENABLE
+		FIELD(profiler, LAYOUT_WRITER_REGION),
+		FIELD(profiler, LAYOUT_WRITER_CONTROL),
+#endif
+#if TRACE_ENABLE
+		FIELD(trace, LAYOUT_WRITER_REGION),
+		FIELD(trace.rings[TRACE_RING_CM7], LAYOUT_WRITER_CONTROL),
+		FIELD(trace.rings[TRACE_RING_CM4], LAYOUT_WRITER_COMMS),
+#endif
+};
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+const shared_memory_layout_t LAYOUT_NAME =
+{
+		.size = sizeof(shared_data_t),
+		.alignment = _Alignof(shared_data_t),
+		.fieldCount = sizeof(fields) / sizeof(fields[0]),
+		.fields = fields,
+};
+
+/* EOF */
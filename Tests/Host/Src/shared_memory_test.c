@@ -0,0 +1,189 @@
+/**
+ ********************************************************************************
+ * @file    	shared_memory_test.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Host test of the shared memory layout of both cores.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * shared_memory_layout.c is compiled for both cores with the configuration of the template application.
+ * The test checks that both cores agree on the layout, that each top level member starts at a new cache
+ * line, and that no cache line contains fields written by different cores.
+ *
+ * The cost of false sharing is measured by two threads updating the write and read indices of a ring
+ * buffer, once as laid out in the shared memory and once packed in the same cache line.
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include "shared_memory.h"
+#include "shared_memory_layout.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define BENCHMARK_COUNT				(20000000)
+/********************************************************************************
+ * Typedefs
+ *******************************************************************************/
+/**
+ * @brief Ring buffer indices without the alignment.
+ */
+typedef struct
+{
+	volatile int wrIndex;
+	volatile int rdIndex;
+} packed_indices_t;
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static shared_data_t hostSharedData;
+static packed_indices_t packedIndices SHARED_REGION_ALIGN;
+static int failureCount = 0;
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+_Thread_local uint32_t hostPrimask;
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+static void Check(bool isPassed, const char* msg)
+{
+	if (isPassed)
+		return;
+	printf("  FAILED: %s\n", msg);
+	failureCount++;
+}
+
+static double GetTimeNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static size_t GetFirstLine(const layout_field_t* field)
+{
+	return field->offset / SHARED_MEMORY_ALIGNMENT;
+}
+
+static size_t GetLastLine(const layout_field_t* field)
+{
+	return (field->offset + field->size - 1) / SHARED_MEMORY_ALIGNMENT;
+}
+
+/**
+ * @brief Checks that both cores compile the same layout.
+ */
+static void Test_SameLayout(void)
+{
+	printf("Shared memory layout, %d byte cache lines\n", SHARED_MEMORY_ALIGNMENT);
+	printf("  size              : %zu bytes of %d, alignment %zu\n", layoutCM7.size, SHARED_DATA_MAX_SIZE, layoutCM7.alignment);
+	Check(layoutCM7.size == layoutCM4.size && layoutCM7.fieldCount == layoutCM4.fieldCount, "cores compile different layouts");
+	Check(layoutCM7.alignment >= SHARED_MEMORY_ALIGNMENT, "shared data not aligned to the cache line");
+	for (size_t i = 0; i < layoutCM7.fieldCount && i < layoutCM4.fieldCount; i++)
+	{
+		const layout_field_t* cm7 = &layoutCM7.fields[i];
+		const layout_field_t* cm4 = &layoutCM4.fields[i];
+		if (cm7->offset != cm4->offset || cm7->size != cm4->size)
+		{
+			printf("  %-36s: offset %zu / %zu, size %zu / %zu in CM7 / CM4\n", cm7->name, cm7->offset, cm4->offset, cm7->size, cm4->size);
+			Check(false, "field placed differently by the cores");
+		}
+	}
+}
+
+/**
+ * @brief Checks that the regions start at new cache lines and that no cache line is written by both cores.
+ */
+static void Test_CacheLines(void)
+{
+	int pairCount = 0, sharedCount = 0;
+	const shared_memory_layout_t* layout = &layoutCM7;
+	for (size_t i = 0; i < layout->fieldCount; i++)
+	{
+		const layout_field_t* field = &layout->fields[i];
+		if (field->writer == LAYOUT_WRITER_REGION && (field->offset % SHARED_MEMORY_ALIGNMENT) != 0)
+		{
+			printf("  %-36s: starts at offset %zu\n", field->name, field->offset);
+			Check(false, "region not aligned to the cache line");
+		}
+		if (field->writer != LAYOUT_WRITER_CONTROL && field->writer != LAYOUT_WRITER_COMMS)
+			continue;
+		for (size_t j = i + 1; j < layout->fieldCount; j++)
+		{
+			const layout_field_t* other = &layout->fields[j];
+			if ((other->writer != LAYOUT_WRITER_CONTROL && other->writer != LAYOUT_WRITER_COMMS) || other->writer == field->writer)
+				continue;
+			pairCount++;
+			if (GetFirstLine(field) <= GetLastLine(other) && GetFirstLine(other) <= GetLastLine(field))
+			{
+				printf("  %-36s: shares a cache line with %s\n", field->name, other->name);
+				sharedCount++;
+			}
+		}
+	}
+	printf("  cache lines       : %d pairs of fields written by different cores, %d sharing a cache line\n", pairCount, sharedCount);
+	Check(sharedCount == 0, "fields written by different cores share a cache line");
+}
+
+static void* IncrementIndex(void* arg)
+{
+	volatile int* index = (volatile int*)arg;
+	for (int i = 0; i < BENCHMARK_COUNT; i++)
+		(*index)++;
+	return NULL;
+}
+
+/**
+ * @brief Gets the time taken per update while both indices are updated by different threads.
+ */
+static double MeasureIndices(volatile int* wrIndex, volatile int* rdIndex)
+{
+	pthread_t threads[2];
+	double startTime = GetTimeNs();
+	pthread_create(&threads[0], NULL, IncrementIndex, (void*)wrIndex);
+	pthread_create(&threads[1], NULL, IncrementIndex, (void*)rdIndex);
+	pthread_join(threads[0], NULL);
+	pthread_join(threads[1], NULL);
+	return (GetTimeNs() - startTime) / BENCHMARK_COUNT;
+}
+
+/**
+ * @brief Measures the cost of the ring buffer indices sharing a cache line.
+ */
+static void Benchmark_FalseSharing(void)
+{
+	double alignedNs = MeasureIndices(&hostSharedData.p2pMsgs.msgsRingBuff.wrIndex, &hostSharedData.p2pMsgs.msgsRingBuff.rdIndex);
+	double packedNs = MeasureIndices(&packedIndices.wrIndex, &packedIndices.rdIndex);
+	printf("  false sharing     : %.2f ns per update with aligned indices, %.2f ns in the same cache line (host, %ld CPUs)\n",
+			alignedNs, packedNs, sysconf(_SC_NPROCESSORS_ONLN));
+}
+
+int main(void)
+{
+	Test_SameLayout();
+	Test_CacheLines();
+	Benchmark_FalseSharing();
+	printf(failureCount ? "%d check(s) FAILED\n" : "All checks passed\n", failureCount);
+	return failureCount ? 1 : 0;
+}
+
+/* EOF */
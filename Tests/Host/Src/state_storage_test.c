@@ -0,0 +1,641 @@
+/**
+ ********************************************************************************
+ * @file    	state_storage_test.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Host tests of the state storage using the flash emulator.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * The unmodified state_storage_lib.c is connected to the flash emulator through
+ * @ref state_storage_config_t.flashOps and driven by two storage clients. The tests report
+ * the flash cost of the journal, the erase distribution over the sectors, the recovery after
+ * a power cut during every single flash operation, the operation with a faulty sector, the
+ * import of the states written by the previous two sector format, the handling of the
+ * compressed images after the default states change and the longest stall of a single refresh
+ * while the sectors are erased and the images are written in the background. The library source is included, so that
+ * the encoding and decoding of the compressed images can also be benchmarked directly, and the
+ * initialization from the last checkpoint can be compared with replaying the complete journal.
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <time.h>
+#include "flash_emulator.h"
+#include "state_storage_lib.c"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define CLIENT_COUNT					(2)
+#define MAX_CLIENT_WORDS				(50)
+#define SECTOR_BYTES					(128 * 1024)
+#define SMALL_SECTOR_BYTES				(16 * 1024)
+#define INIT_REPEAT_COUNT				(200)
+/** Period of the storage task while a background operation is in progress */
+#define REFRESH_PERIOD_CYCLES			(FLASH_EMULATOR_CLOCK_Hz / 1000)
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static const uint32_t clientWordLens[CLIENT_COUNT] = { 30, MAX_CLIENT_WORDS };
+static uint32_t states[CLIENT_COUNT][MAX_CLIENT_WORDS];
+static uint32_t prevStates[CLIENT_COUNT][MAX_CLIENT_WORDS];
+static uint32_t refreshMask = 0;
+static bool isDataRestored = false;
+static state_storage_config_t storage;
+static state_storage_client_t clients[CLIENT_COUNT];
+static bool isCompressionEnabled = false;
+static uint32_t defaults[CLIENT_COUNT][MAX_CLIENT_WORDS];
+static bool isDefaultsEnabled = false;
+static uint32_t progressCount = 0;
+static uint32_t completionCount = 0;
+static uint8_t lastProgress = 0;
+static bool isProgressOrdered = true;
+static int failureCount = 0;
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+void Error_Handler(void)
+{
+	printf("Error_Handler called by the state storage\n");
+	exit(1);
+}
+
+static void InitStates(int client, uint32_t* data, bool isDataValid)
+{
+	for (uint32_t i = 0; i < clientWordLens[client]; i++)
+		states[client][i] = isDataValid ? data[i] : 0;
+	if (client == 0)
+		isDataRestored = isDataValid;
+}
+
+static uint32_t RefreshStates(int client, uint32_t* data, uint32_t* indexPtr)
+{
+	refreshMask |= 1U << client;
+	*indexPtr = 0;
+	if (memcmp(data, states[client], clientWordLens[client] * 4) == 0)
+		return 0;
+	memcpy(data, states[client], clientWordLens[client] * 4);
+	return clientWordLens[client];
+}
+
+static void StorageProgress(uint8_t percent)
+{
+	// the progress restarts after the completion of each image
+	if (percent <= lastProgress)
+		isProgressOrdered = false;
+	lastProgress = percent;
+	progressCount++;
+}
+
+static void StorageCompleted(void)
+{
+	lastProgress = 0;
+	completionCount++;
+}
+
+static void InitStates0(uint32_t* data, bool isDataValid) { InitStates(0, data, isDataValid); }
+static void InitStates1(uint32_t* data, bool isDataValid) { InitStates(1, data, isDataValid); }
+static uint32_t RefreshStates0(uint32_t* data, uint32_t* indexPtr) { return RefreshStates(0, data, indexPtr); }
+static uint32_t RefreshStates1(uint32_t* data, uint32_t* indexPtr) { return RefreshStates(1, data, indexPtr); }
+
+static double GetTimeUs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/**
+ * @brief Initializes the storage as done at the startup of the controller.
+ * @param sectorCount No of sectors.
+ * @param sectorBytes Size of each sector.
+ * @param keepContents If <c>true</c> the flash contents are kept, else the flash is erased.
+ * @return Time taken by @ref StateStorage_Init() in micro seconds.
+ */
+static double Boot(int sectorCount, uint32_t sectorBytes, bool keepContents)
+{
+	memset(&storage, 0, sizeof(storage));
+	memset(clients, 0, sizeof(clients));
+	FlashEmulator_Init(&storage, sectorCount, sectorBytes, keepContents);
+	clients[0].dataWordLen = clientWordLens[0];
+	clients[0].InitStatesFromStorage = InitStates0;
+	clients[0].RefreshStates = RefreshStates0;
+	clients[1].dataWordLen = clientWordLens[1];
+	clients[1].InitStatesFromStorage = InitStates1;
+	clients[1].RefreshStates = RefreshStates1;
+	clients[0].defaults = isDefaultsEnabled ? defaults[0] : NULL;
+	clients[1].defaults = isDefaultsEnabled ? defaults[1] : NULL;
+	storage.clientCount = CLIENT_COUNT;
+	storage.clients = clients;
+	storage.isCompressionEnabled = isCompressionEnabled;
+	double startTime = GetTimeUs();
+	StateStorage_Init(&storage);
+	return GetTimeUs() - startTime;
+}
+
+/**
+ * @brief Polls the storage till the current states are taken and all background operations are completed.
+ */
+static void Flush(void)
+{
+	refreshMask = 0;
+	while (refreshMask != ((1U << CLIENT_COUNT) - 1) || StateStorage_IsBusy())
+		StateStorage_Refresh();
+}
+
+/**
+ * @brief Changes a single random state and waits till it is stored.
+ */
+static void RunUpdate(void)
+{
+	memcpy(prevStates, states, sizeof(states));
+	int client = FlashEmulator_Random() % CLIENT_COUNT;
+	states[client][FlashEmulator_Random() % clientWordLens[client]] = FlashEmulator_Random();
+	Flush();
+}
+
+static void Check(bool isPassed, const char* msg)
+{
+	if (isPassed)
+		return;
+	printf("  FAILED: %s\n", msg);
+	failureCount++;
+}
+
+/**
+ * @brief Measures the flash cost of the journal for single word updates.
+ */
+static void Test_JournalCost(void)
+{
+	const uint32_t updateCount = 1000;
+	(void)Boot(2, SECTOR_BYTES, false);
+	Flush();
+	FlashEmulator_ResetStats();
+	for (uint32_t i = 0; i < updateCount; i++)
+		RunUpdate();
+	FlashEmulator_PrintReport(isCompressionEnabled ? "Journal cost, single word updates, compressed images" :
+			"Journal cost, single word updates", updateCount);
+	// the previous format rewrote the complete block of the updated client for every change
+	double legacyBytes = 0;
+	for (int i = 0; i < CLIENT_COUNT; i++)
+		legacyBytes += GET_LEGACY_ALIGNED_SIZE(clientWordLens[i] + 2) * 4.0 / CLIENT_COUNT;
+	printf("  previous format        : %.1f bytes per 1000 updates\n", legacyBytes * 1000);
+	printf("  worst refresh          : %.1f us\n", storage.stats.maxRefreshCycles * 1e6 / FLASH_EMULATOR_CLOCK_Hz);
+	Check(flashEmulatorStats.rejectedCount == 0, "flash words programmed without erase");
+}
+
+/**
+ * @brief Checks the erase distribution over four sectors for a large number of updates.
+ */
+static void Test_WearLevelling(void)
+{
+	const uint32_t updateCount = 2000000;
+	(void)Boot(4, SECTOR_BYTES, false);
+	Flush();
+	FlashEmulator_ResetStats();
+	for (uint32_t i = 0; i < updateCount; i++)
+		RunUpdate();
+	FlashEmulator_PrintReport("Wear levelling over 4 sectors", updateCount);
+
+	uint64_t minErases = UINT64_MAX, maxErases = 0;
+	for (int i = 0; i < 4; i++)
+	{
+		if (flashEmulatorStats.eraseCounts[i] < minErases)
+			minErases = flashEmulatorStats.eraseCounts[i];
+		if (flashEmulatorStats.eraseCounts[i] > maxErases)
+			maxErases = flashEmulatorStats.eraseCounts[i];
+	}
+	Check(maxErases - minErases <= 1, "uneven erase distribution");
+	memcpy(prevStates, states, sizeof(states));
+	(void)Boot(4, SECTOR_BYTES, true);
+	Check(isDataRestored && memcmp(prevStates, states, sizeof(states)) == 0, "states not restored after the updates");
+}
+
+/**
+ * @brief Cuts the power during each flash operation of a sequence of updates and checks the recovery.
+ * @details After the power cut either the states before or after the interrupted update are restored.
+ * The storage should then keep working without any further loss.
+ */
+static void Test_PowerCuts(void)
+{
+	const uint32_t updateCount = 400;
+	jmp_buf powerCutJump;
+
+	// count the operations of the complete sequence
+	FlashEmulator_Seed(1);
+	(void)Boot(2, SMALL_SECTOR_BYTES, false);
+	FlashEmulator_ResetStats();
+	for (uint32_t i = 0; i < updateCount; i++)
+		RunUpdate();
+	uint32_t opCount = (uint32_t)flashEmulatorStats.opCount;
+
+	double maxInitUs = 0, totalInitUs = 0;
+	uint64_t maxRecoveryCycles = 0;
+	uint32_t lossCount = 0;
+	uint64_t rejectedCount = 0;
+	for (uint32_t op = 1; op <= opCount; op++)
+	{
+		FlashEmulator_Seed(1);
+		(void)Boot(2, SMALL_SECTOR_BYTES, false);
+		FlashEmulator_ResetStats();
+		flashEmulatorConfig.powerCutOp = op;
+		flashEmulatorConfig.powerCutJump = &powerCutJump;
+		if (setjmp(powerCutJump) == 0)
+		{
+			for (uint32_t i = 0; i < updateCount; i++)
+				RunUpdate();
+		}
+		flashEmulatorConfig.powerCutOp = 0;
+		uint32_t expected[CLIENT_COUNT][MAX_CLIENT_WORDS], previous[CLIENT_COUNT][MAX_CLIENT_WORDS];
+		memcpy(expected, states, sizeof(states));
+		memcpy(previous, prevStates, sizeof(states));
+
+		// restart and check that the states of the interrupted update or the update before it are restored
+		double initUs = Boot(2, SMALL_SECTOR_BYTES, true);
+		totalInitUs += initUs;
+		if (initUs > maxInitUs)
+			maxInitUs = initUs;
+		if (memcmp(states, expected, sizeof(states)) != 0 && memcmp(states, previous, sizeof(states)) != 0)
+			lossCount++;
+		uint64_t startCycles = flashEmulatorStats.cycles;
+		Flush();
+		if (flashEmulatorStats.cycles - startCycles > maxRecoveryCycles)
+			maxRecoveryCycles = flashEmulatorStats.cycles - startCycles;
+
+		// the storage should keep working after the recovery
+		for (uint32_t i = 0; i < 20; i++)
+			RunUpdate();
+		memcpy(expected, states, sizeof(states));
+		(void)Boot(2, SMALL_SECTOR_BYTES, true);
+		if (memcmp(states, expected, sizeof(states)) != 0)
+			lossCount++;
+		rejectedCount += flashEmulatorStats.rejectedCount;
+	}
+	printf("Power cut during each of the %u flash operations%s\n", opCount, isCompressionEnabled ? ", compressed images" : "");
+	printf("  lost updates           : %u\n", lossCount);
+	printf("  rejected programs      : %llu\n", (unsigned long long)rejectedCount);
+	printf("  StateStorage_Init      : %.1f us max, %.1f us mean (host)\n", maxInitUs, totalInitUs / opCount);
+	printf("  back to idle           : %.1f ms max (simulated)\n", maxRecoveryCycles * 1e3 / FLASH_EMULATOR_CLOCK_Hz);
+	Check(lossCount == 0, "states lost after a power cut");
+	Check(rejectedCount == 0, "partially programmed flash words programmed again");
+}
+
+/**
+ * @brief Checks that the storage keeps working if one of the sectors fails all operations.
+ */
+static void Test_FaultySector(void)
+{
+	const uint32_t updateCount = 20000;
+	(void)Boot(3, SMALL_SECTOR_BYTES, false);
+	FlashEmulator_ResetStats();
+	flashEmulatorConfig.faultySector = 1;
+	for (uint32_t i = 0; i < updateCount; i++)
+		RunUpdate();
+	flashEmulatorConfig.faultySector = -1;
+	FlashEmulator_PrintReport("Faulty sector 1 of 3", updateCount);
+	printf("  failed operations      : %u\n", storage.stats.failureCount);
+	memcpy(prevStates, states, sizeof(states));
+	(void)Boot(3, SMALL_SECTOR_BYTES, true);
+	Check(isDataRestored && memcmp(prevStates, states, sizeof(states)) == 0, "states not restored with a faulty sector");
+}
+
+/**
+ * @brief Writes a record of the previous two sector format.
+ * @return Pointer to the next record.
+ */
+static uint32_t* WriteLegacyRecord(uint32_t* addr, const uint32_t* data, uint32_t index, uint32_t len)
+{
+	uint32_t size = GET_LEGACY_ALIGNED_SIZE(len);
+	addr[0] = len;
+	addr[1] = index;
+	memcpy(addr + 2, data, len * 4);
+	memset(addr + 2 + len, 0, (size - len - 3) * 4);
+	addr[size - 1] = len;
+	return addr + size;
+}
+
+/**
+ * @brief Fills the store with the states in the layout used by the storage.
+ */
+static void FillStore(uint32_t* store)
+{
+	memset(store, 0, STORE_BYTE_SIZE);
+	for (int i = 0; i < CLIENT_COUNT; i++)
+	{
+		*store++ = STORAGE_HEADER_VALUE;
+		memcpy(store, states[i], clientWordLens[i] * 4);
+		store += clientWordLens[i];
+		*store++ = STORAGE_FOOTER_VALUE;
+	}
+}
+
+/**
+ * @brief Checks the import of the states written by the previous two sector format.
+ */
+static void Test_LegacyImport(void)
+{
+	static uint32_t store[STORE_WORD_SIZE];
+	uint32_t expected[CLIENT_COUNT][MAX_CLIENT_WORDS];
+	(void)Boot(2, SECTOR_BYTES, false);
+
+	// older image with updates in sector 0
+	for (int i = 0; i < CLIENT_COUNT; i++)
+		for (uint32_t j = 0; j < clientWordLens[i]; j++)
+			states[i][j] = FlashEmulator_Random();
+	FillStore(store);
+	uint32_t* addr = WriteLegacyRecord(storage.sectors[0].addr, store, 0, STORE_WORD_SIZE);
+	for (int i = 0; i < 10; i++)
+		addr = WriteLegacyRecord(addr, store + 5, 5, 4);
+
+	// newer image in sector 1 with a single update of the second client
+	for (uint32_t j = 0; j < clientWordLens[0]; j++)
+		states[0][j] ^= 0x55AA;
+	FillStore(store);
+	addr = WriteLegacyRecord(storage.sectors[1].addr, store, 0, STORE_WORD_SIZE);
+	states[1][7] = 0x12345678;
+	FillStore(store);
+	(void)WriteLegacyRecord(addr, store + clientWordLens[0] + 2, clientWordLens[0] + 2, clientWordLens[1] + 2);
+	memcpy(expected, states, sizeof(states));
+
+	memset(states, 0, sizeof(states));
+	(void)Boot(2, SECTOR_BYTES, true);
+	Check(isDataRestored && memcmp(expected, states, sizeof(states)) == 0, "states of the previous format not imported");
+	Flush();
+	memset(states, 0, sizeof(states));
+	(void)Boot(2, SECTOR_BYTES, true);
+	Check(isDataRestored && memcmp(expected, states, sizeof(states)) == 0, "imported states not rewritten in the current format");
+	printf("Import of the previous format\n");
+	printf("  restored               : %s\n", isDataRestored ? "yes" : "no");
+}
+
+/**
+ * @brief Fills the default states with random values.
+ */
+static void RandomizeDefaults(void)
+{
+	for (int i = 0; i < CLIENT_COUNT; i++)
+		for (uint32_t j = 0; j < clientWordLens[i]; j++)
+			defaults[i][j] = FlashEmulator_Random();
+}
+
+/**
+ * @brief Checks that the compressed images are not restored after the default states change,
+ * e.g. by a firmware update.
+ */
+static void Test_DefaultsChange(void)
+{
+	uint32_t expected[CLIENT_COUNT][MAX_CLIENT_WORDS];
+	isCompressionEnabled = true;
+	isDefaultsEnabled = true;
+	RandomizeDefaults();
+	(void)Boot(2, SECTOR_BYTES, false);
+	memcpy(states, defaults, sizeof(states));
+	states[0][1] ^= 0x1234;
+	states[1][2] ^= 0x5678;
+	Flush();
+	Check(storage.stats.savedWordCount != 0, "image not compressed");
+	memcpy(expected, states, sizeof(states));
+
+	memset(states, 0, sizeof(states));
+	(void)Boot(2, SECTOR_BYTES, true);
+	Check(isDataRestored && memcmp(expected, states, sizeof(states)) == 0, "compressed image not restored with the same defaults");
+
+	// the default of a state which is not changed by the application is updated
+	defaults[1][5] ^= 1;
+	memset(states, 0, sizeof(states));
+	(void)Boot(2, SECTOR_BYTES, true);
+	bool isRestoredAfterChange = isDataRestored;
+	Check(isRestoredAfterChange == false, "compressed image restored against changed defaults");
+
+	// the storage should keep working with the new defaults
+	memcpy(states, expected, sizeof(states));
+	Flush();
+	memset(states, 0, sizeof(states));
+	(void)Boot(2, SECTOR_BYTES, true);
+	Check(isDataRestored && memcmp(expected, states, sizeof(states)) == 0, "states not restored after the defaults change");
+	printf("Compressed image after the defaults change\n");
+	printf("  restored               : %s\n", isRestoredAfterChange ? "yes" : "no");
+	isCompressionEnabled = false;
+	isDefaultsEnabled = false;
+}
+
+/**
+ * @brief Measures the compression ratio and the time taken to encode and decode the complete images
+ * for different fractions of the states differing from the defaults.
+ */
+static void Benchmark_Compression(void)
+{
+	const int iterations = 200000;
+	const int changedPercents[] = { 0, 5, 25, 50, 100 };
+	static uint32_t store[STORE_WORD_SIZE];
+	static uint32_t compressed[STORE_WORD_SIZE];
+	isDefaultsEnabled = true;
+	RandomizeDefaults();
+	printf("Compression of the complete images, %u words\n", STORE_WORD_SIZE);
+	for (size_t p = 0; p < sizeof(changedPercents) / sizeof(changedPercents[0]); p++)
+	{
+		(void)Boot(2, SECTOR_BYTES, false);
+		memcpy(states, defaults, sizeof(states));
+		for (int i = 0; i < CLIENT_COUNT; i++)
+			for (uint32_t j = 0; j < clientWordLens[i]; j++)
+				if ((int)(FlashEmulator_Random() % 100) < changedPercents[p])
+					states[i][j] ^= FlashEmulator_Random() | 1;
+		Flush();
+		memcpy(store, storage.store, sizeof(store));
+
+		double startTime = GetTimeUs();
+		uint32_t len = 0;
+		for (int i = 0; i < iterations; i++)
+			len = CompressStore();
+		double encodeNs = (GetTimeUs() - startTime) * 1e3 / iterations;
+		memcpy(compressed, compressedStore, len * 4);
+
+		bool isDecoded = true;
+		startTime = GetTimeUs();
+		for (int i = 0; i < iterations; i++)
+			isDecoded &= len < STORE_WORD_SIZE ? DecompressStore(compressed, len) : true;
+		double decodeNs = (GetTimeUs() - startTime) * 1e3 / iterations;
+		Check(isDecoded && memcmp(store, storage.store, sizeof(store)) == 0, "compressed image not decoded correctly");
+		if (len < STORE_WORD_SIZE)
+			printf("  %3d%% changed           : %3u words, ratio %.2f, encode %.0f ns, decode %.0f ns (host)\n",
+					changedPercents[p], len, (double)STORE_WORD_SIZE / len, encodeNs, decodeNs);
+		else
+			printf("  %3d%% changed           : stored uncompressed, encode %.0f ns (host)\n", changedPercents[p], encodeNs);
+	}
+	isDefaultsEnabled = false;
+}
+
+/**
+ * @brief Replays the complete journal of the sector from its first image, as done before the checkpoints.
+ * @return No of replayed words.
+ */
+static uint32_t ReplayFromStart(flash_sector_config_t* sector)
+{
+	uint32_t* addr = sector->addr + GetCheckpointIndex(0);
+	uint32_t* endAddr = sector->addr + GetSectorWordSize(sector);
+	while (addr < endAddr && *addr != EMPTY_WORD && IsRecordValid(addr, endAddr))
+	{
+		if (addr[1] == RECORD_FLAG_COMPRESSED)
+			(void)DecompressStore(addr + HEADER_WORD_SIZE, addr[0]);
+		else
+			memcpy((void*)(config->store + addr[1]), (void*)(addr + HEADER_WORD_SIZE), addr[0] * 4);
+		addr += GET_FLASH_ALIGNED_SIZE(addr[0]);
+	}
+	return addr - (sector->addr + GetCheckpointIndex(0));
+}
+
+/**
+ * @brief Measures the time taken by @ref StateStorage_Init() for different fill levels of the active sector,
+ * against replaying the complete journal of the sector.
+ */
+static void Benchmark_InitTime(void)
+{
+	const int fillPercents[] = { 0, 25, 50, 75, 95 };
+	uint32_t sectorWords = SECTOR_BYTES / 4;
+	double firstInitUs = 0, lastInitUs = 0;
+	printf("StateStorage_Init against the fill level of a %u KB sector, checkpoints every %u words\n",
+			SECTOR_BYTES / 1024, CHECKPOINT_WORD_INTERVAL);
+	FlashEmulator_Seed(1);
+	(void)Boot(2, SECTOR_BYTES, false);
+	Flush();
+	int activeSector = sectorIndex;
+	for (size_t p = 0; p < sizeof(fillPercents) / sizeof(fillPercents[0]); p++)
+	{
+		while (storage.sectors[activeSector].index < sectorWords * fillPercents[p] / 100)
+			RunUpdate();
+		Check(sectorIndex == activeSector, "states compacted while filling the sector");
+		memcpy(prevStates, states, sizeof(states));
+
+		// the shortest time of the repeated runs excludes the interruptions of the host
+		double initUs = 1e9, replayUs = 1e9;
+		uint32_t replayWords = 0;
+		for (int i = 0; i < INIT_REPEAT_COUNT; i++)
+		{
+			double us = Boot(2, SECTOR_BYTES, true);
+			if (us < initUs)
+				initUs = us;
+			double startTime = GetTimeUs();
+			replayWords = ReplayFromStart(&storage.sectors[activeSector]);
+			us = GetTimeUs() - startTime;
+			if (us < replayUs)
+				replayUs = us;
+		}
+		flash_sector_config_t* sector = &storage.sectors[activeSector];
+		uint32_t checkpointWords = sector->index - GetCheckpointIndex(GetLastCheckpoint(sector));
+		printf("  %3d%% used              : init %5.1f us replaying %4u words, complete journal %5.1f us for %5u words (host)\n",
+				fillPercents[p], initUs, checkpointWords, replayUs, replayWords);
+		Check(isDataRestored && memcmp(prevStates, states, sizeof(states)) == 0, "states not restored");
+		Check(checkpointWords <= CHECKPOINT_WORD_INTERVAL && replayWords == sector->index - GetCheckpointIndex(0),
+				"journal replayed beyond the last checkpoint");
+		if (p == 0)
+			firstInitUs = initUs;
+		lastInitUs = initUs;
+	}
+	// the erase check of the next sector takes the same time at all fill levels
+	printf("  fullest against empty  : %.2fx init time\n", lastInitUs / firstInitUs);
+}
+
+/**
+ * @brief Measures the longest stall of a single refresh while the sectors are erased and the complete images
+ * are written in the background, against the flash busy time of each complete operation.
+ * @details The storage task is modelled to call @ref StateStorage_Refresh() every @ref REFRESH_PERIOD_CYCLES,
+ * while the task is stalled by the program latency of the flash words it writes.
+ */
+static void Test_BackgroundStalls(void)
+{
+	const uint32_t updateCount = 5000;
+	uint32_t pollCycles = flashEmulatorConfig.pollCycles;
+	uint64_t operationBusyCycles = 0, maxOperationBusyCycles = 0, refreshCount = 0;
+	uint32_t operationCount = 0;
+	bool wasBusy = false;
+	// the time between the refreshes is advanced by the modelled task instead of the busy checks
+	flashEmulatorConfig.pollCycles = 0;
+	FlashEmulator_Seed(1);
+	(void)Boot(2, SMALL_SECTOR_BYTES, false);
+	clients[0].StorageProgress = StorageProgress;
+	clients[0].StorageCompleted = StorageCompleted;
+	progressCount = completionCount = lastProgress = 0;
+	isProgressOrdered = true;
+	StateStorage_ResetStats();
+	FlashEmulator_ResetStats();
+
+	for (uint32_t n = 0; n < updateCount; n++)
+	{
+		int client = FlashEmulator_Random() % CLIENT_COUNT;
+		states[client][FlashEmulator_Random() % clientWordLens[client]] = FlashEmulator_Random();
+		refreshMask = 0;
+		while (refreshMask != ((1U << CLIENT_COUNT) - 1) || StateStorage_IsBusy())
+		{
+			uint64_t busyCycles = flashEmulatorStats.busyCycles;
+			StateStorage_Refresh();
+			refreshCount++;
+			bool isBusy = StateStorage_IsBusy();
+			if (isBusy && !wasBusy)
+			{
+				operationCount++;
+				operationBusyCycles = 0;
+			}
+			// a blocking refresh would have stalled for all the flash operations of the background operation
+			if (isBusy || wasBusy)
+				operationBusyCycles += flashEmulatorStats.busyCycles - busyCycles;
+			if (!isBusy && wasBusy && operationBusyCycles > maxOperationBusyCycles)
+				maxOperationBusyCycles = operationBusyCycles;
+			wasBusy = isBusy;
+			FlashEmulator_Advance(REFRESH_PERIOD_CYCLES);
+		}
+	}
+	flashEmulatorConfig.pollCycles = pollCycles;
+
+	double maxRefreshUs = storage.stats.maxRefreshCycles * 1e6 / FLASH_EMULATOR_CLOCK_Hz;
+	printf("Background operations, %u updates with a refresh every %u us\n", updateCount, REFRESH_PERIOD_CYCLES / (FLASH_EMULATOR_CLOCK_Hz / 1000000));
+	printf("  operations             : %u erases and images in %llu refreshes, %u progress and %u completion callbacks\n",
+			operationCount, (unsigned long long)refreshCount, progressCount, completionCount);
+	printf("  longest refresh        : %.1f us, %u flash words of %.1f us per chunk\n", maxRefreshUs, STATE_STORAGE_CHUNK_FLASH_WORDS,
+			flashEmulatorConfig.programCycles * 1e6 / FLASH_EMULATOR_CLOCK_Hz);
+	printf("  blocking operation     : %.1f ms flash busy time\n", maxOperationBusyCycles * 1e3 / FLASH_EMULATOR_CLOCK_Hz);
+
+	// besides a chunk, a refresh can complete an erase with the sector header or append a record for each client
+	Check(storage.stats.maxRefreshCycles <= (STATE_STORAGE_CHUNK_FLASH_WORDS + CLIENT_COUNT) * flashEmulatorConfig.programCycles,
+			"refresh blocked for more than a chunk");
+	Check(maxOperationBusyCycles >= flashEmulatorConfig.eraseCycles && operationCount > 0, "background operations not measured");
+	Check(completionCount > 0 && progressCount > 0 && isProgressOrdered, "progress not reported");
+	memcpy(prevStates, states, sizeof(states));
+	(void)Boot(2, SMALL_SECTOR_BYTES, true);
+	Check(isDataRestored && memcmp(prevStates, states, sizeof(states)) == 0, "states not restored after the background operations");
+}
+
+int main(void)
+{
+	for (int i = 0; i < 2; i++)
+	{
+		isCompressionEnabled = i == 1;
+		FlashEmulator_Seed(1);
+		Test_JournalCost();
+		Test_PowerCuts();
+	}
+	isCompressionEnabled = false;
+	Test_WearLevelling();
+	Test_FaultySector();
+	Test_LegacyImport();
+	Test_DefaultsChange();
+	Benchmark_Compression();
+	Benchmark_InitTime();
+	Test_BackgroundStalls();
+	printf(failureCount ? "%d check(s) FAILED\n" : "All checks passed\n", failureCount);
+	return failureCount ? 1 : 0;
+}
+
+/* EOF */
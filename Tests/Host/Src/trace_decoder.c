@@ -0,0 +1,112 @@
+/**
+ ********************************************************************************
+ * @file    	trace_decoder.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Host decoder of the binary trace rings.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * Decodes a dump of @ref trace_data_t, e.g. read from the shared memory by the debugger with
+ * <b>dump binary memory trace.bin &sharedData->trace (&sharedData->trace + 1)</b>, and prints the records of
+ * both rings in the CSV format of Trace_Format(). The records are decoded by the same code as the target.
+ *
+ * Usage: trace_decoder <dump file>
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <stdio.h>
+#include "shared_memory.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define READ_CHUNK					(16)
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static shared_data_t hostSharedData;
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+volatile shared_data_t * const sharedData = &hostSharedData;
+uint32_t SystemCoreClock;
+_Thread_local uint32_t hostPrimask;
+_Thread_local uint8_t hostTraceRing;
+DWT_Type hostDWT;
+CoreDebug_Type hostCoreDebug;
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+uint32_t HostTrace_GetTimestamp(void)
+{
+	return 0;
+}
+
+/**
+ * @brief Prints the records still available in a ring.
+ * @return uint32_t No of records printed
+ */
+static uint32_t DecodeRing(uint8_t ringNo)
+{
+	trace_record_t records[READ_CHUNK];
+	char text[64];
+	uint32_t writeIndex = hostSharedData.trace.rings[ringNo].writeIndex;
+	// only the last records of the ring are available
+	trace_reader_t reader = { .readIndex = writeIndex > TRACE_RING_SIZE ? writeIndex - TRACE_RING_SIZE : 0 };
+	uint32_t total = 0, count;
+	while ((count = Trace_Read(ringNo, &reader, records, READ_CHUNK)) != 0)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			Trace_Format(ringNo, &records[i], text, sizeof(text));
+			printf("%s\n", text);
+		}
+		total += count;
+	}
+	fprintf(stderr, "ring %d: %u of %u records decoded, %u incomplete at %u Hz\n", ringNo, total, writeIndex,
+			writeIndex - reader.readIndex, hostSharedData.trace.rings[ringNo].clockHz);
+	return total;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc != 2)
+	{
+		fprintf(stderr, "Usage: %s <dump file>\n", argv[0]);
+		return 2;
+	}
+	FILE* file = fopen(argv[1], "rb");
+	if (file == NULL)
+	{
+		perror(argv[1]);
+		return 1;
+	}
+	bool isRead = fread(&hostSharedData.trace, sizeof(trace_data_t), 1, file) == 1;
+	fclose(file);
+	if (!isRead)
+	{
+		fprintf(stderr, "%s: expected %zu bytes of trace data\n", argv[1], sizeof(trace_data_t));
+		return 1;
+	}
+
+	printf("time_us,ring,event,param,value\n");
+	for (uint8_t ringNo = 0; ringNo < TRACE_RING_COUNT; ringNo++)
+		DecodeRing(ringNo);
+	return 0;
+}
+
+/* EOF */
@@ -0,0 +1,305 @@
+/**
+ ********************************************************************************
+ * @file    	trace_test.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Host stress test of the trace rings with both cores and their interrupts as producers.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * The unmodified pecontroller_trace.c is run by two producer threads, one for each core, while a third thread
+ * reads both rings concurrently in the same way as the communication core. Each producer is preempted by an
+ * emulated interrupt logging its own event between the reservation and the completion of every few records,
+ * so every ring has two producers. Each record carries a value from the counter of its producer, from which
+ * the other fields are derived, so that torn or reordered records are detected. At the end the read and lost
+ * records of each ring should add up to the logged records.
+ *
+ * The cost of logging is measured with one and two producers, and the rings are dumped to
+ * build/trace_dump.bin for the decoder (trace_decoder.c).
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <time.h>
+#include "shared_memory.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define PRODUCER_EVENTS				(2000000)
+#define INTERRUPT_PERIOD			(7)
+#define YIELD_PERIOD				(97)
+#define READ_CHUNK					(16)
+#define BENCHMARK_EVENTS			(10000000)
+#define DUMP_PATH					"build/trace_dump.bin"
+#define EVT_THREAD					(TRACE_EVT_USER)
+#define EVT_INTERRUPT				(TRACE_EVT_USER + 1)
+/********************************************************************************
+ * Typedefs
+ *******************************************************************************/
+/**
+ * @brief Statistics of the records read from a ring.
+ */
+typedef struct
+{
+	uint32_t readCount;							/**< No of records read */
+	uint32_t corruptCount;						/**< No of records with inconsistent fields */
+	uint32_t orderErrors;						/**< No of records older than the last record of the same producer */
+	int64_t lastValues[2];						/**< Last value read from the thread and interrupt producer */
+	trace_reader_t reader;						/**< State of the reader */
+} ring_stats_t;
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static shared_data_t hostSharedData;
+static ring_stats_t stats[TRACE_RING_COUNT];
+static uint32_t interruptEvents[TRACE_RING_COUNT];
+static double benchmarkNs[TRACE_RING_COUNT];
+static atomic_int activeProducers;
+static uint32_t interruptPeriod;
+static bool isTimestampEncoded;
+static _Thread_local uint32_t eventValue;
+static _Thread_local bool isInterruptActive;
+static int failureCount = 0;
+/********************************************************************************
+ * Global Variables
+ *******************************************************************************/
+volatile shared_data_t * const sharedData = &hostSharedData;
+uint32_t SystemCoreClock = 480000000U;
+_Thread_local uint32_t hostPrimask;
+_Thread_local uint8_t hostTraceRing;
+DWT_Type hostDWT;
+CoreDebug_Type hostCoreDebug;
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+static void Check(bool isPassed, const char* msg)
+{
+	if (isPassed)
+		return;
+	printf("  FAILED: %s\n", msg);
+	failureCount++;
+}
+
+static double GetTimeNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint16_t GetParam(uint32_t value, uint8_t ringNo)
+{
+	return (uint16_t)((value * 40503U) >> 8) ^ ringNo;
+}
+
+static uint32_t GetTimestamp(uint32_t value, uint16_t id)
+{
+	return (value * 2654435761U) ^ id;
+}
+
+/**
+ * @brief Gets the time stamp of the event being logged and emulates an interrupt logging its own event
+ * every @ref INTERRUPT_PERIOD events of the thread.
+ * @details The thread also yields in the middle of a record every @ref YIELD_PERIOD events, so that the
+ * reader finds incomplete records even when the host has a single CPU.
+ */
+uint32_t HostTrace_GetTimestamp(void)
+{
+	if (!isTimestampEncoded)
+		return eventValue;
+	uint32_t timestamp = GetTimestamp(eventValue, isInterruptActive ? EVT_INTERRUPT : EVT_THREAD);
+	if (!isInterruptActive && (eventValue % YIELD_PERIOD) == 0)
+		sched_yield();
+	if (interruptPeriod && !isInterruptActive && hostPrimask == 0 && (eventValue % interruptPeriod) == 0)
+	{
+		uint32_t threadValue = eventValue;
+		isInterruptActive = true;
+		eventValue = interruptEvents[hostTraceRing]++;
+		Trace_Log(EVT_INTERRUPT, GetParam(eventValue, hostTraceRing), eventValue);
+		eventValue = threadValue;
+		isInterruptActive = false;
+	}
+	return timestamp;
+}
+
+static void* Producer(void* arg)
+{
+	hostTraceRing = (uint8_t)(uintptr_t)arg;
+	for (uint32_t i = 0; i < PRODUCER_EVENTS; i++)
+	{
+		eventValue = i;
+		Trace_Log(EVT_THREAD, GetParam(i, hostTraceRing), i);
+	}
+	atomic_fetch_sub(&activeProducers, 1);
+	return NULL;
+}
+
+/**
+ * @brief Reads the available records of a ring and checks them.
+ * @return uint32_t No of records read
+ */
+static uint32_t ReadRing(uint8_t ringNo)
+{
+	trace_record_t records[READ_CHUNK];
+	ring_stats_t* ring = &stats[ringNo];
+	uint32_t count = Trace_Read(ringNo, &ring->reader, records, READ_CHUNK);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		trace_record_t* record = &records[i];
+		int producer = record->id - EVT_THREAD;
+		if ((producer != 0 && producer != 1) || record->param != GetParam(record->value, ringNo) ||
+				record->timestamp != GetTimestamp(record->value, record->id))
+		{
+			ring->corruptCount++;
+			continue;
+		}
+		if ((int64_t)record->value <= ring->lastValues[producer])
+			ring->orderErrors++;
+		ring->lastValues[producer] = record->value;
+	}
+	ring->readCount += count;
+	return count;
+}
+
+static void* Consumer(void* arg)
+{
+	while (atomic_load(&activeProducers) > 0)
+	{
+		uint32_t count = 0;
+		for (uint8_t ringNo = 0; ringNo < TRACE_RING_COUNT; ringNo++)
+			count += ReadRing(ringNo);
+		if (count == 0)
+			sched_yield();
+	}
+	// remaining records
+	for (uint8_t ringNo = 0; ringNo < TRACE_RING_COUNT; ringNo++)
+		while (ReadRing(ringNo));
+	return NULL;
+}
+
+static void InitRings(void)
+{
+	for (uint8_t ringNo = 0; ringNo < TRACE_RING_COUNT; ringNo++)
+	{
+		hostTraceRing = ringNo;
+		Trace_Init();
+		stats[ringNo] = (ring_stats_t){ .lastValues = { -1, -1 } };
+		interruptEvents[ringNo] = 0;
+	}
+	hostTraceRing = TRACE_RING_CM7;
+}
+
+/**
+ * @brief Runs both producers and the reader concurrently and checks the records of each ring.
+ */
+static void Test_TwoProducers(void)
+{
+	pthread_t producers[TRACE_RING_COUNT], consumer;
+	printf("Two cores with interrupts, %d thread events per core\n", PRODUCER_EVENTS);
+	InitRings();
+	interruptPeriod = INTERRUPT_PERIOD;
+	isTimestampEncoded = true;
+	atomic_store(&activeProducers, TRACE_RING_COUNT);
+	pthread_create(&consumer, NULL, Consumer, NULL);
+	for (int i = 0; i < TRACE_RING_COUNT; i++)
+		pthread_create(&producers[i], NULL, Producer, (void*)(uintptr_t)i);
+	for (int i = 0; i < TRACE_RING_COUNT; i++)
+		pthread_join(producers[i], NULL);
+	pthread_join(consumer, NULL);
+	isTimestampEncoded = false;
+
+	for (int i = 0; i < TRACE_RING_COUNT; i++)
+	{
+		ring_stats_t* ring = &stats[i];
+		uint32_t logged = PRODUCER_EVENTS + interruptEvents[i];
+		printf("  ring %d            : %u logged (%u by the interrupt), %u read, %u lost, %u corrupt, %u out of order\n",
+				i, logged, interruptEvents[i], ring->readCount, ring->reader.lostCount, ring->corruptCount, ring->orderErrors);
+		Check(hostSharedData.trace.rings[i].writeIndex == logged, "wrong write index");
+		Check(ring->readCount + ring->reader.lostCount == logged, "records neither read nor counted as lost");
+		Check(ring->corruptCount == 0, "torn records read");
+		Check(ring->orderErrors == 0, "records of a producer read out of order");
+		Check(ring->lastValues[0] == PRODUCER_EVENTS - 1, "last thread event not read");
+		Check(ring->lastValues[1] == (int64_t)interruptEvents[i] - 1, "last interrupt event not read");
+	}
+}
+
+static void* BenchmarkProducer(void* arg)
+{
+	hostTraceRing = (uint8_t)(uintptr_t)arg;
+	double startTime = GetTimeNs();
+	for (uint32_t i = 0; i < BENCHMARK_EVENTS; i++)
+		Trace_Log(EVT_THREAD, 0, i);
+	benchmarkNs[hostTraceRing] = (GetTimeNs() - startTime) / BENCHMARK_EVENTS;
+	return NULL;
+}
+
+/**
+ * @brief Measures the cost of logging an event with one producer and with both producers logging at the same time.
+ */
+static void Benchmark_Log(void)
+{
+	pthread_t producers[TRACE_RING_COUNT];
+	InitRings();
+	BenchmarkProducer((void*)TRACE_RING_CM7);
+	double singleNs = benchmarkNs[TRACE_RING_CM7];
+	for (int i = 0; i < TRACE_RING_COUNT; i++)
+		pthread_create(&producers[i], NULL, BenchmarkProducer, (void*)(uintptr_t)i);
+	for (int i = 0; i < TRACE_RING_COUNT; i++)
+		pthread_join(producers[i], NULL);
+	printf("  benchmark         : %.1f ns per event, %.1f / %.1f ns with both producers (host)\n", singleNs,
+			benchmarkNs[0], benchmarkNs[1]);
+}
+
+/**
+ * @brief Logs a few system events in both rings and dumps the rings for the decoder.
+ */
+static void DumpRings(void)
+{
+	InitRings();
+	for (uint8_t ringNo = 0; ringNo < TRACE_RING_COUNT; ringNo++)
+	{
+		hostTraceRing = ringNo;
+		eventValue = 1000000 * (ringNo + 1);
+		Trace_Log(TRACE_EVT_MODE, 1, 0);
+		eventValue += 48000;
+		Trace_Log(TRACE_EVT_RELAY, 0, true);
+		eventValue += 480000;
+		Trace_Log(TRACE_EVT_PLL_STATUS, 2, 1);
+		eventValue += 4800;
+		Trace_Log(TRACE_EVT_FAULT, 0x2, 0xfff);
+	}
+	FILE* file = fopen(DUMP_PATH, "wb");
+	bool isWritten = file && fwrite((void*)&hostSharedData.trace, sizeof(trace_data_t), 1, file) == 1;
+	if (file)
+		fclose(file);
+	Check(isWritten, "trace dump not written");
+	printf("  dump              : %zu bytes written to %s\n", sizeof(trace_data_t), DUMP_PATH);
+}
+
+int main(void)
+{
+	Test_TwoProducers();
+	Benchmark_Log();
+	DumpRings();
+	printf(failureCount ? "%d check(s) FAILED\n" : "All checks passed\n", failureCount);
+	return failureCount ? 1 : 0;
+}
+
+/* EOF */
@@ -0,0 +1,621 @@
+/**
+ ********************************************************************************
+ * @file    	utility_lib_test.c
+ * @author 		agent
+ * @date    	October 19, 2026
+ *
+ * @brief   Host tests of the text conversions of the utility library.
+ ********************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Copyright (c) 2021 Taraz Technologies Pvt. Ltd.</center></h2>
+ * <h3><center>All rights reserved.</center></h3>
+ *
+ * <center>This software component is licensed by Taraz Technologies under BSD 3-Clause license,
+ * the "License"; You may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *                        www.opensource.org/licenses/BSD-3-Clause</center>
+ *
+ ********************************************************************************
+ * @details
+ * The conversions are compared against the C library of the host, which is correctly rounded.
+ * The integer conversions are checked for all 32-bit values, while the float conversions
+ * are checked for millions of random values.
+ ********************************************************************************
+ */
+
+/********************************************************************************
+ * Includes
+ *******************************************************************************/
+#include <time.h>
+#include "utility_lib.h"
+/********************************************************************************
+ * Defines
+ *******************************************************************************/
+#define ATOF_RANDOM_COUNT			(2000000)
+#define ATOF_MIDPOINT_COUNT			(300000)
+#define MAX_REPORTED_FAILURES		(10)
+#define ITOA_PADDED_COUNT			(10000000)
+#define ITOA_BENCHMARK_COUNT		(10000000)
+#define FTOA_RANDOM_COUNT			(4000000)
+#define FTOA_SHORTEST_COUNT			(2000000)
+#define FTOA_BENCHMARK_COUNT		(5000000)
+#define BATCH_RANDOM_COUNT			(200000)
+#define BATCH_REFRESH_COUNT			(200000)
+#define BATCH_MEASUREMENTS			(16)
+#define BATCH_PARAMS				(8)
+#define BATCH_ITEM_SIZE				(20)
+/********************************************************************************
+ * Static Variables
+ *******************************************************************************/
+static uint32_t randomState = 1;
+static int failureCount = 0;
+/********************************************************************************
+ * Code
+ *******************************************************************************/
+void Error_Handler(void)
+{
+	printf("Error_Handler called by the utility library\n");
+	exit(1);
+}
+
+static uint32_t Random(void)
+{
+	// xorshift32
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+static uint32_t GetBits(float f)
+{
+	uint32_t bits;
+	memcpy(&bits, &f, sizeof(bits));
+	return bits;
+}
+
+/**
+ * @brief Compares the conversion of the text with strtof().
+ * @return <c>true</c> if both results are identical.
+ */
+static bool CheckAtof(const char* txt)
+{
+	float result = 0;
+	float expected = strtof(txt, NULL);
+	bool isOk = atof_custom(txt, &result);
+	// overflows are rejected instead of returning infinity
+	if (GetBits(expected) == GetBits(result) || (!isOk && (GetBits(expected) & 0x7FFFFFFF) == 0x7F800000))
+		return true;
+	if (failureCount++ < MAX_REPORTED_FAILURES)
+		printf("  FAILED: atof_custom(\"%s\") = %a, strtof = %a\n", txt, result, expected);
+	return false;
+}
+
+/**
+ * @brief Writes the exact decimal value of the midpoint above the single precision number.
+ * @details The midpoint is exactly representable in double precision and printed with all digits.
+ * @param bits IEEE-754 representation of the lower number.
+ * @param txt Buffer for the text, with space for at least 160 characters.
+ * @return Pointer to the exponent part of the text.
+ */
+static char* WriteMidpoint(uint32_t bits, char* txt)
+{
+	float lo, hi;
+	uint32_t hiBits = bits + 1;
+	memcpy(&lo, &bits, sizeof(lo));
+	memcpy(&hi, &hiBits, sizeof(hi));
+	double mid = ((double)lo + (double)hi) / 2;
+	sprintf(txt, "%.130e", mid);
+	// strip the trailing zeros of the mantissa
+	char* exp = strchr(txt, 'e');
+	char* end = exp;
+	while (end[-1] == '0')
+		end--;
+	memmove(end, exp, strlen(exp) + 1);
+	return end;
+}
+
+/**
+ * @brief Checks the exact midpoints, and the numbers just above and below them with more than 19 digits.
+ */
+static void Test_AtofMidpoints(void)
+{
+	char txt[200], tmp[200];
+	int count = 0;
+	for (int i = 0; i < ATOF_MIDPOINT_COUNT; i++)
+	{
+		uint32_t bits = Random() % 0x7F7FFFFF;
+		char* exp = WriteMidpoint(bits, txt);
+		strcpy(tmp, exp);
+
+		// exact tie
+		CheckAtof(txt);
+		// just above, the last digit is after the first 19 significant digits
+		sprintf(exp, "%.*s1%s", 20, "00000000000000000000", tmp);
+		CheckAtof(txt);
+		// just below
+		exp = WriteMidpoint(bits, txt);
+		if (exp[-1] != '.')
+		{
+			exp[-1]--;
+			sprintf(exp, "%.*s%s", 20, "99999999999999999999", tmp);
+			CheckAtof(txt);
+			count++;
+		}
+		count += 2;
+	}
+	printf("atof_custom at the midpoints     : %d texts\n", count);
+}
+
+/**
+ * @brief Checks random texts of random lengths and exponents.
+ */
+static void Test_AtofRandom(void)
+{
+	char txt[200];
+	for (int i = 0; i < ATOF_RANDOM_COUNT; i++)
+	{
+		char* ptr = txt;
+		if (Random() & 1)
+			*ptr++ = '-';
+		int digits = 1 + (Random() % ((Random() & 3) ? 25 : 140));
+		int point = Random() % (digits + 1);
+		for (int j = 0; j < digits; j++)
+		{
+			if (j == point && j != 0)
+				*ptr++ = '.';
+			*ptr++ = '0' + (Random() % 10);
+		}
+		sprintf(ptr, "e%d", (int)(Random() % 110) - 70 - (point > 0 ? 0 : digits / 2));
+		CheckAtof(txt);
+	}
+	// float values in the shortest and long formats
+	for (int i = 0; i < ATOF_RANDOM_COUNT; i++)
+	{
+		uint32_t bits = Random() & 0x7FFFFFFF;
+		float f;
+		memcpy(&f, &bits, sizeof(f));
+		if (bits >= 0x7F800000)
+			continue;
+		sprintf(txt, "%.9g", f);
+		CheckAtof(txt);
+		sprintf(txt, "%.25e", f);
+		CheckAtof(txt);
+	}
+	printf("atof_custom for random texts     : %d texts\n", ATOF_RANDOM_COUNT * 3);
+}
+
+/**
+ * @brief Checks the cases found by the review of the parser.
+ */
+static void Test_AtofKnownCases(void)
+{
+	static const char* const cases[] =
+	{
+		"14267060263387702364678285372162048",	// midpoint with more than 19 digits, even result 0x1.5fb5dp+113
+		"14267060263387702364678285372162048.000000000000000000001",
+		"14267060263387702364678285372162047.999999999999999999999",
+		"1.00000005960464477539062500000000000000000000001",
+		"1.000000059604644775390625",
+		"7.00649232162408535461864791644958065640130970938257885878534141944895541342930300743319094181060791015625e-46",
+		"1.4012984643248170709237295832899161312802619418765157717570682838897910826858606014866381883621215820312e-45",
+		"3.4028235677973366e38",
+		"0.000000000000000000000000000000000000011754942807573642917278829910357665133228589927589904276829631184250030649651730385585324256680905818939208984375",
+	};
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+		CheckAtof(cases[i]);
+}
+
+static void ReportItoa(const char* fnc, int64_t val, const char* result, const char* expected)
+{
+	if (failureCount++ < MAX_REPORTED_FAILURES)
+		printf("  FAILED: %s(%lld) = \"%s\", expected \"%s\"\n", fnc, (long long)val, result, expected);
+}
+
+/**
+ * @brief Checks the conversion of all 32-bit values.
+ * @details The expected text is kept in a decimal counter incremented with each value.
+ * Negative values are checked as the minus sign followed by the text of the magnitude.
+ */
+static void Test_ItoaExhaustive(void)
+{
+	char expected[16] = "0", txt[16];
+	int len = 1;
+	uint32_t val = 0;
+	do
+	{
+		if (utoa_custom(val, txt) != len || memcmp(txt, expected, len + 1) != 0)
+			ReportItoa("utoa_custom", val, txt, expected);
+		if (val <= 0x7FFFFFFFU && (itoa_custom((int32_t)val, txt) != len || memcmp(txt, expected, len + 1) != 0))
+			ReportItoa("itoa_custom", val, txt, expected);
+		if (val != 0 && val <= 0x80000000U &&
+				(itoa_custom((int32_t)(0U - val), txt) != len + 1 || txt[0] != '-' || memcmp(txt + 1, expected, len + 1) != 0))
+			ReportItoa("itoa_custom", -(int64_t)val, txt, expected);
+
+		// increment the decimal counter
+		int i = len - 1;
+		while (i >= 0 && expected[i] == '9')
+			expected[i--] = '0';
+		if (i >= 0)
+			expected[i]++;
+		else
+		{
+			memmove(expected + 1, expected, len + 1);
+			expected[0] = '1';
+			len++;
+		}
+	} while (++val != 0);
+	printf("itoa_custom and utoa_custom      : all 32-bit values\n");
+}
+
+/**
+ * @brief Checks the padded conversions against sprintf() for random values and widths.
+ */
+static void Test_ItoaPadded(void)
+{
+	static const int32_t edges[] = { 0, 1, -1, 9, -9, 10, -10, 999999999, 1000000000, -1000000000, INT32_MAX, INT32_MIN };
+	char txt[32], expected[32];
+	for (int i = 0; i < ITOA_PADDED_COUNT; i++)
+	{
+		int32_t val = i < (int)(sizeof(edges) / sizeof(edges[0])) * 16 ? edges[i / 16] : (int32_t)(Random() >> (Random() % 32));
+		if (i >= (int)(sizeof(edges) / sizeof(edges[0])) * 16 && (Random() & 1))
+			val = -val;
+		int width = i % 16;
+		char padChar = (i & 1) ? '0' : ' ';
+		int expectedLen = sprintf(expected, padChar == '0' ? "%0*d" : "%*d", width, val);
+		if (itoa_padded(val, txt, width, padChar) != expectedLen || strcmp(txt, expected) != 0)
+			ReportItoa("itoa_padded", val, txt, expected);
+		expectedLen = sprintf(expected, padChar == '0' ? "%0*u" : "%*u", width, (uint32_t)val);
+		if (utoa_padded((uint32_t)val, txt, width, padChar) != expectedLen || strcmp(txt, expected) != 0)
+			ReportItoa("utoa_padded", (uint32_t)val, txt, expected);
+	}
+	printf("itoa_padded and utoa_padded      : %d values\n", ITOA_PADDED_COUNT);
+}
+
+static double GetTimeNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief Compares the time taken by the padded conversion with sprintf().
+ */
+static void Benchmark_Itoa(void)
+{
+	static int32_t vals[1024];
+	char txt[32];
+	volatile int sum = 0;
+	for (int i = 0; i < 1024; i++)
+		vals[i] = (int32_t)(Random() >> (Random() % 32)) * ((i & 1) ? -1 : 1);
+
+	double startTime = GetTimeNs();
+	for (int i = 0; i < ITOA_BENCHMARK_COUNT; i++)
+		sum += itoa_padded(vals[i & 1023], txt, 8, '0');
+	double customNs = (GetTimeNs() - startTime) / ITOA_BENCHMARK_COUNT;
+
+	startTime = GetTimeNs();
+	for (int i = 0; i < ITOA_BENCHMARK_COUNT; i++)
+		sum += sprintf(txt, "%08d", vals[i & 1023]);
+	double sprintfNs = (GetTimeNs() - startTime) / ITOA_BENCHMARK_COUNT;
+	(void)sum;
+	printf("itoa_padded benchmark            : %.1f ns per value, sprintf %.1f ns (host)\n", customNs, sprintfNs);
+}
+
+static void ReportFtoa(const char* fnc, float f, const char* result, const char* expected)
+{
+	if (failureCount++ < MAX_REPORTED_FAILURES)
+		printf("  FAILED: %s(%.9g [0x%08X]) = \"%s\", expected \"%s\"\n", fnc, f, GetBits(f), result, expected);
+}
+
+/**
+ * @brief Generates a random float with the magnitude below the given limit.
+ * @param maxBiasedExp Maximum biased exponent of the generated value
+ * @return Random value with random sign
+ */
+static float RandomFloat(uint32_t maxBiasedExp)
+{
+	uint32_t bits = ((Random() % (maxBiasedExp + 1)) << 23) | (Random() & 0x807FFFFF);
+	float f;
+	memcpy(&f, &bits, sizeof(f));
+	return f;
+}
+
+/**
+ * @brief Checks the fixed point conversion against sprintf() for random values below the digit limit.
+ * @details The values are displayed with the decimals left by the integer digits, limited by the precision.
+ * The values gaining an integer digit beyond the limit by rounding use the short scientific format and are skipped.
+ */
+static void Test_FtoaCustom(void)
+{
+	static const int formats[][2] = { { 4, 2 }, { 6, 3 }, { 8, 6 }, { 10, 9 }, { 19, 9 } };
+	const int formatCount = sizeof(formats) / sizeof(formats[0]);
+	char txt[64], expected[64];
+	int checkedCount = 0;
+	for (int i = 0; i < FTOA_RANDOM_COUNT; i++)
+	{
+		int maxDigits = formats[i % formatCount][0];
+		int precision = formats[i % formatCount][1];
+		double limit = 1;
+		for (int j = 0; j < maxDigits; j++)
+			limit *= 10;
+		// biased exponent of the limit
+		uint32_t maxBiasedExp = 127 + (uint32_t)(maxDigits * 3.3219281);
+		float f = RandomFloat(maxBiasedExp);
+		double absVal = f < 0 ? -(double)f : f;
+		if (absVal >= limit)
+			continue;
+
+		uint64_t intVal = (uint64_t)absVal;
+		int digits = 1;
+		while (intVal >= 10)
+		{
+			intVal /= 10;
+			digits++;
+		}
+		int decimals = maxDigits - digits < precision ? maxDigits - digits : precision;
+		if (decimals > 9)
+			decimals = 9;
+		const char* expectedPtr = expected;
+		sprintf(expected, "%.*f", decimals, f);
+		// negligible negative numbers are displayed without the sign
+		if (expected[0] == '-' && strspn(expected + 1, "0.") == strlen(expected + 1))
+			expectedPtr++;
+		if ((int)strcspn(expectedPtr, ".") - (expectedPtr[0] == '-') > maxDigits)
+			continue;
+		int len = ftoa_custom(f, txt, maxDigits, precision);
+		if (len != (int)strlen(expectedPtr) || strcmp(txt, expectedPtr) != 0)
+			ReportFtoa("ftoa_custom", f, txt, expectedPtr);
+		checkedCount++;
+	}
+	printf("ftoa_custom against sprintf      : %d values\n", checkedCount);
+}
+
+/**
+ * @brief Gets the significant digits of a number text without the leading and trailing zeros.
+ * @param txt Number text in the fixed or scientific notation
+ * @param digits Buffer to be filled with the significant digits
+ * @return Decimal exponent of the leading significant digit
+ */
+static int GetSignificantDigits(const char* txt, char* digits)
+{
+	int count = 0, pointPos = -1, exp = 0;
+	if (*txt == '-')
+		txt++;
+	for (; *txt && *txt != 'e'; txt++)
+	{
+		if (*txt == '.')
+			pointPos = count;
+		else
+			digits[count++] = *txt;
+	}
+	if (*txt == 'e')
+		exp = atoi(txt + 1);
+	if (pointPos < 0)
+		pointPos = count;
+	int start = 0;
+	while (start < count - 1 && digits[start] == '0')
+	{
+		start++;
+		pointPos--;
+	}
+	while (count > start + 1 && digits[count - 1] == '0')
+		count--;
+	memmove(digits, digits + start, count - start);
+	digits[count - start] = 0;
+	return pointPos - 1 + exp;
+}
+
+/**
+ * @brief Checks the shortest conversion of random values of the complete range.
+ * @details The text should convert back to the same value, and its digits should match the shortest
+ * correctly rounded scientific text of sprintf() which converts back to the same value.
+ */
+static void Test_FtoaShortest(void)
+{
+	char txt[64], expected[64], digits[64], expectedDigits[64];
+	for (int i = 0; i < FTOA_SHORTEST_COUNT; i++)
+	{
+		float f = RandomFloat(254);
+		int len = ftoa_shortest(f, txt);
+		if (len != (int)strlen(txt) || GetBits(strtof(txt, NULL)) != GetBits(f))
+		{
+			ReportFtoa("ftoa_shortest", f, txt, "same value after strtof()");
+			continue;
+		}
+		for (int k = 1; k <= 9; k++)
+		{
+			sprintf(expected, "%.*e", k - 1, f);
+			if (GetBits(strtof(expected, NULL)) == GetBits(f))
+				break;
+		}
+		if (GetSignificantDigits(txt, digits) != GetSignificantDigits(expected, expectedDigits) ||
+				strcmp(digits, expectedDigits) != 0)
+			ReportFtoa("ftoa_shortest", f, txt, expected);
+	}
+	printf("ftoa_shortest against sprintf    : %d values\n", FTOA_SHORTEST_COUNT);
+}
+
+/**
+ * @brief Compares the time taken by the float conversions with sprintf().
+ */
+static void Benchmark_Ftoa(void)
+{
+	static float vals[1024];
+	char txt[64];
+	volatile int sum = 0;
+	// typical measurements and references of the display
+	for (int i = 0; i < 1024; i++)
+		vals[i] = ((int32_t)(Random() % 2000000) - 1000000) / (float)(1U << (Random() % 16));
+
+	double startTime = GetTimeNs();
+	for (int i = 0; i < FTOA_BENCHMARK_COUNT; i++)
+		sum += ftoa_custom(vals[i & 1023], txt, 8, 3);
+	double customNs = (GetTimeNs() - startTime) / FTOA_BENCHMARK_COUNT;
+
+	startTime = GetTimeNs();
+	for (int i = 0; i < FTOA_BENCHMARK_COUNT; i++)
+		sum += sprintf(txt, "%.3f", vals[i & 1023]);
+	double sprintfNs = (GetTimeNs() - startTime) / FTOA_BENCHMARK_COUNT;
+	printf("ftoa_custom benchmark            : %.1f ns per value, sprintf %.1f ns (host)\n", customNs, sprintfNs);
+
+	startTime = GetTimeNs();
+	for (int i = 0; i < FTOA_BENCHMARK_COUNT; i++)
+		sum += ftoa_shortest(vals[i & 1023], txt);
+	customNs = (GetTimeNs() - startTime) / FTOA_BENCHMARK_COUNT;
+
+	startTime = GetTimeNs();
+	for (int i = 0; i < FTOA_BENCHMARK_COUNT; i++)
+		sum += sprintf(txt, "%.9g", vals[i & 1023]);
+	sprintfNs = (GetTimeNs() - startTime) / FTOA_BENCHMARK_COUNT;
+	(void)sum;
+	printf("ftoa_shortest benchmark          : %.1f ns per value, sprintf %%.9g %.1f ns (host)\n", customNs, sprintfNs);
+}
+
+/**
+ * @brief Formats a value in the same way as the default text representation of the parameters.
+ * @details Follows P2PComms_GetStringValue(), which is replaced by @ref String_FormatBatch() on the main screen.
+ */
+static int FormatParameter(data_union_t value, base_data_type_t type, int precision, const char* unit, char* txt)
+{
+	int len = 0;
+	switch (type)
+	{
+	case DTYPE_U8: len = utoa_custom(value.u8, txt); break;
+	case DTYPE_U16: len = utoa_custom(value.u16, txt); break;
+	case DTYPE_U32: len = utoa_custom(value.u32, txt); break;
+	case DTYPE_S8: len = itoa_custom(value.s8, txt); break;
+	case DTYPE_S16: len = itoa_custom(value.s16, txt); break;
+	case DTYPE_S32: len = itoa_custom(value.s32, txt); break;
+	case DTYPE_FLOAT: len = ftoa_custom(value.f, txt, 7, precision); break;
+	default: return -1;
+	}
+	return unit == NULL ? len : strcat_custom(txt, unit, len, false) - 1;
+}
+
+/**
+ * @brief Checks that the batch produces the same text as the parameter formatting and marks only the changed items.
+ */
+static void Test_FormatBatch(void)
+{
+	static const base_data_type_t types[] = { DTYPE_U8, DTYPE_U16, DTYPE_U32, DTYPE_S8, DTYPE_S16, DTYPE_S32, DTYPE_FLOAT, DTYPE_FLOAT };
+	static const char* units[] = { NULL, " V", " A", " Hz" };
+	const int count = sizeof(types) / sizeof(types[0]);
+	data_union_t values[sizeof(types) / sizeof(types[0])];
+	value_format_t formats[sizeof(types) / sizeof(types[0])];
+	char arena[sizeof(types) / sizeof(types[0]) * BATCH_ITEM_SIZE];
+	uint32_t changedMask[STRING_BATCH_MASK_WORDS(sizeof(types) / sizeof(types[0]))];
+	char expected[64];
+	int mismatches = 0, maskErrors = 0;
+
+	memset(arena, 0, sizeof(arena));
+	for (int n = 0; n < BATCH_RANDOM_COUNT; n++)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			formats[i] = (value_format_t){ .type = types[i], .maxDigits = 7, .precision = Random() % 4, .suffix = units[Random() % 4] };
+			values[i].u32 = Random();
+			if (types[i] == DTYPE_FLOAT)
+				values[i].f = RandomFloat(140);
+		}
+		String_FormatBatch(values, formats, count, arena, BATCH_ITEM_SIZE, changedMask);
+		for (int i = 0; i < count; i++)
+		{
+			FormatParameter(values[i], types[i], formats[i].precision, formats[i].suffix, expected);
+			if (strcmp(expected, &arena[i * BATCH_ITEM_SIZE]) != 0 && mismatches++ < MAX_REPORTED_FAILURES)
+				printf("  FAILED: String_FormatBatch(0x%08X, type %d) = \"%s\", expected \"%s\"\n", values[i].u32, types[i],
+						&arena[i * BATCH_ITEM_SIZE], expected);
+		}
+		// only the modified item is marked in the next batch
+		int index = Random() % count;
+		values[index].u32 ^= 1U << 20;
+		if (String_FormatBatch(values, formats, count, arena, BATCH_ITEM_SIZE, changedMask) > 1 ||
+				(changedMask[0] & ~(1UL << index)) != 0)
+			maskErrors++;
+	}
+	printf("String_FormatBatch text          : %d batches, %d mismatches, %d wrong changed masks\n", BATCH_RANDOM_COUNT, mismatches, maskErrors);
+	if (mismatches || maskErrors)
+		failureCount++;
+}
+
+/**
+ * @brief Compares the batch formatting of the main screen with formatting and setting each label.
+ * @details The measurements are updated at each refresh with noise below the displayed resolution,
+ * while a single parameter changes every 10 refreshes. Each label updated with new text is an invalidation.
+ */
+static void Benchmark_FormatBatch(void)
+{
+	data_union_t values[BATCH_MEASUREMENTS + BATCH_PARAMS];
+	data_union_t prevValues[BATCH_MEASUREMENTS + BATCH_PARAMS];
+	value_format_t formats[BATCH_MEASUREMENTS + BATCH_PARAMS];
+	static char arena[(BATCH_MEASUREMENTS + BATCH_PARAMS) * BATCH_ITEM_SIZE];
+	static char labels[BATCH_MEASUREMENTS + BATCH_PARAMS][BATCH_ITEM_SIZE];
+	uint32_t changedMask[STRING_BATCH_MASK_WORDS(BATCH_MEASUREMENTS + BATCH_PARAMS)];
+	static float noise[1024];
+	const int count = BATCH_MEASUREMENTS + BATCH_PARAMS;
+	uint64_t itemInvalidations = 0, batchInvalidations = 0;
+
+	for (int i = 0; i < 1024; i++)
+		noise[i] = ((int32_t)(Random() % 1001) - 500) * 1e-5f;
+	for (int i = 0; i < count; i++)
+	{
+		bool isMeasurement = i < BATCH_MEASUREMENTS;
+		formats[i] = (value_format_t){ .type = DTYPE_FLOAT, .maxDigits = isMeasurement ? 4 : 7, .precision = isMeasurement ? 1 : 2,
+			.suffix = isMeasurement ? NULL : " Hz" };
+		prevValues[i].u32 = 0;
+	}
+
+	// format and set each label as done per refresh before the batch
+	double startTime = GetTimeNs();
+	for (int n = 0; n < BATCH_REFRESH_COUNT; n++)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			values[i].f = i < BATCH_MEASUREMENTS ? (230.f + i + noise[(n + i * 37) & 1023]) : (50.f + (i == BATCH_MEASUREMENTS ? n / 10 : 0));
+			// the measurements are always set, the parameters only when the value changes
+			if (i >= BATCH_MEASUREMENTS && values[i].u32 == prevValues[i].u32)
+				continue;
+			prevValues[i] = values[i];
+			char txt[32];
+			int len = ftoa_custom(values[i].f, txt, formats[i].maxDigits, formats[i].precision);
+			if (formats[i].suffix != NULL)
+				strcat_custom(txt, formats[i].suffix, len, false);
+			strcpy(labels[i], txt);
+			itemInvalidations++;
+		}
+	}
+	double itemNs = (GetTimeNs() - startTime) / BATCH_REFRESH_COUNT;
+
+	startTime = GetTimeNs();
+	for (int n = 0; n < BATCH_REFRESH_COUNT; n++)
+	{
+		for (int i = 0; i < count; i++)
+			values[i].f = i < BATCH_MEASUREMENTS ? (230.f + i + noise[(n + i * 37) & 1023]) : (50.f + (i == BATCH_MEASUREMENTS ? n / 10 : 0));
+		batchInvalidations += String_FormatBatch(values, formats, count, arena, BATCH_ITEM_SIZE, changedMask);
+	}
+	double batchNs = (GetTimeNs() - startTime) / BATCH_REFRESH_COUNT;
+	printf("String_FormatBatch benchmark     : %.0f ns per refresh of %d values, %.0f ns setting each label (host)\n", batchNs, count, itemNs);
+	printf("String_FormatBatch invalidations : %.2f per refresh, %.2f setting each label\n",
+			(double)batchInvalidations / BATCH_REFRESH_COUNT, (double)itemInvalidations / BATCH_REFRESH_COUNT);
+}
+
+int main(void)
+{
+	Test_AtofKnownCases();
+	Test_AtofMidpoints();
+	Test_AtofRandom();
+	Test_ItoaExhaustive();
+	Test_ItoaPadded();
+	Benchmark_Itoa();
+	Test_FtoaCustom();
+	Test_FtoaShortest();
+	Benchmark_Ftoa();
+	Test_FormatBatch();
+	Benchmark_FormatBatch();
+	printf(failureCount ? "%d check(s) FAILED\n" : "All checks passed\n", failureCount);
+	return failureCount ? 1 : 0;
+}
+
+/* EOF */